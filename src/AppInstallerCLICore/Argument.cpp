@@ -311,6 +311,8 @@ namespace AppInstaller::CLI
             return { type, "output"_liv, 'o' };
         case Execution::Args::Type::Correlation:
             return { type, "correlation"_liv };
+        case Execution::Args::Type::TraceFile:
+            return { type, "trace-file"_liv };
 
         case Execution::Args::Type::DependencySource:
             return { type, "dependency-source"_liv, ArgTypeCategory::ExtendedSource };
@@ -407,7 +409,7 @@ namespace AppInstaller::CLI
         case Args::Type::NoUpgrade:
             return Argument{ type, Resource::String::NoUpgradeArgumentDescription, ArgumentType::Flag };
         case Args::Type::HashFile:
-            return Argument{ type, Resource::String::FileArgumentDescription, ArgumentType::Positional, true };
+            return Argument{ type, Resource::String::FileArgumentDescription, ArgumentType::Positional, true }.SetCountLimit(128);
         case Args::Type::Msix:
             return Argument{ type, Resource::String::MsixArgumentDescription, ArgumentType::Flag };
         case Args::Type::ListVersions:
@@ -508,6 +510,8 @@ namespace AppInstaller::CLI
             return Argument{ type, Resource::String::FontDetailsArgumentDescription, ArgumentType::Flag, false };
         case Args::Type::Correlation:
             return Argument{ type, Resource::String::CorrelationArgumentDescription, ArgumentType::Standard, Argument::Visibility::Hidden };
+        case Args::Type::TraceFile:
+            return Argument{ type, Resource::String::TraceFileArgumentDescription, ArgumentType::Standard, Argument::Visibility::Hidden };
         case Args::Type::ListDetails:
             return Argument{ type, Resource::String::ListDetailsArgumentDescription, ArgumentType::Flag, Argument::Visibility::Help };
         default:
@@ -530,6 +534,7 @@ namespace AppInstaller::CLI
         args.push_back(ForType(Args::Type::Proxy));
         args.push_back(ForType(Args::Type::NoProxy));
         args.push_back(ForType(Args::Type::Correlation));
+        args.push_back(ForType(Args::Type::TraceFile));
     }
 
     std::string Argument::GetUsageString() const
@@ -1060,8 +1060,8 @@ namespace AppInstaller::CLI
     {
         try
         {
-            if (!Settings::User().GetWarnings().empty() &&
-                !WI_IsFlagSet(command->GetOutputFlags(), CommandOutputFlags::IgnoreSettingsWarnings))
+            if (!WI_IsFlagSet(command->GetOutputFlags(), CommandOutputFlags::IgnoreSettingsWarnings) &&
+                !Settings::User().GetWarnings().empty())
             {
                 context.Reporter.Warn() << Resource::String::SettingsWarnings << std::endl;
             }
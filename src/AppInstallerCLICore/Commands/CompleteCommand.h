@@ -9,7 +9,9 @@ namespace AppInstaller::CLI
     // be context sensitive in their data output.
     struct CompleteCommand final : public Command
     {
-        CompleteCommand(std::string_view parent) : Command("complete", {}, parent, Visibility::Hidden) {}
+        // The output is consumed by the shell, so it must not contain the settings warnings.
+        CompleteCommand(std::string_view parent) :
+            Command("complete", {}, parent, Visibility::Hidden, Settings::ExperimentalFeature::Feature::None, Settings::TogglePolicy::Policy::None, CommandOutputFlags::IgnoreSettingsWarnings) {}
 
         std::vector<Argument> GetArguments() const override;
 
@@ -6,12 +6,249 @@
 #include "Resources.h"
 
 #include <AppInstallerMsixInfo.h>
+#include <winget/Concurrency.h>
 
 namespace AppInstaller::CLI
 {
     using namespace std::string_view_literals;
     using namespace Utility::literals;
 
+    namespace
+    {
+        // Files are read unbuffered in large chunks, so that hashing many files keeps the storage busy
+        // rather than copying everything through the file cache.
+        constexpr DWORD s_HashReadSize = 4 * 1024 * 1024;
+
+        struct HashResult
+        {
+            std::filesystem::path Path;
+            Utility::SHA256::HashBuffer Hash;
+            HRESULT HashError = S_OK;
+            Utility::SHA256::HashBuffer SignatureHash;
+            HRESULT SignatureHashError = S_OK;
+        };
+
+        wil::unique_hfile OpenFileForHashing(const std::filesystem::path& path)
+        {
+            wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_NO_BUFFERING, nullptr) };
+            if (!file)
+            {
+                // Not every file system supports unbuffered reads.
+                file.reset(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr));
+            }
+
+            THROW_LAST_ERROR_IF(!file);
+            return file;
+        }
+
+        Utility::SHA256::HashBuffer ComputeFileHash(const std::filesystem::path& path)
+        {
+            wil::unique_hfile file = OpenFileForHashing(path);
+
+            // Unbuffered reads need a buffer aligned to the sector size; a page aligned allocation always is.
+            uint8_t* buffer = static_cast<uint8_t*>(VirtualAlloc(nullptr, s_HashReadSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+            THROW_LAST_ERROR_IF_NULL(buffer);
+            auto freeBuffer = wil::scope_exit([&]() { VirtualFree(buffer, 0, MEM_RELEASE); });
+
+            Utility::SHA256 hasher{ Utility::SHA256::GetBulkBackend() };
+            for (;;)
+            {
+                DWORD bytesRead = 0;
+                THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), buffer, s_HashReadSize, &bytesRead, nullptr));
+                if (bytesRead == 0)
+                {
+                    break;
+                }
+
+                hasher.Add(buffer, bytesRead);
+            }
+
+            return hasher.Get();
+        }
+
+        HashResult HashFile(const std::filesystem::path& path, bool computeSignatureHash)
+        {
+            HashResult result;
+            result.Path = path;
+
+            try
+            {
+                result.Hash = ComputeFileHash(path);
+            }
+            catch (...)
+            {
+                result.HashError = wil::ResultFromCaughtException();
+                return result;
+            }
+
+            if (computeSignatureHash)
+            {
+                try
+                {
+                    auto coInitialize = wil::CoInitializeEx(COINIT_MULTITHREADED);
+                    Msix::MsixInfo msixInfo{ path };
+                    result.SignatureHash = msixInfo.GetSignatureHash();
+                }
+                catch (...)
+                {
+                    result.SignatureHashError = wil::ResultFromCaughtException();
+                }
+            }
+
+            return result;
+        }
+
+        // Gets the files to hash from the inputs, which have already been verified to exist, expanding directories
+        // to all of the files beneath them.
+        std::vector<std::filesystem::path> GetFilesToHash(Execution::Context& context, bool& expandedDirectory)
+        {
+            std::vector<std::filesystem::path> files;
+
+            for (const auto& input : *context.Args.GetArgs(Execution::Args::Type::HashFile))
+            {
+                std::filesystem::path path = Utility::ConvertToUTF16(input);
+
+                if (std::filesystem::is_directory(path))
+                {
+                    expandedDirectory = true;
+                    std::vector<std::filesystem::path> directoryFiles;
+                    for (const auto& entry : std::filesystem::recursive_directory_iterator(path))
+                    {
+                        if (entry.is_regular_file())
+                        {
+                            directoryFiles.emplace_back(entry.path());
+                        }
+                    }
+
+                    std::sort(directoryFiles.begin(), directoryFiles.end());
+                    std::move(directoryFiles.begin(), directoryFiles.end(), std::back_inserter(files));
+                }
+                else
+                {
+                    files.emplace_back(std::move(path));
+                }
+            }
+
+            return files;
+        }
+
+        // Reports the result; the path is only included when more than one file, or a directory, is hashed.
+        HRESULT ReportHashResult(Execution::Context& context, const HashResult& result, bool includePath)
+        {
+            if (includePath)
+            {
+                context.Reporter.Info() << Utility::LocIndString{ result.Path.u8string() } << std::endl;
+            }
+
+            std::string_view indent = includePath ? "  "sv : ""sv;
+
+            if (FAILED(result.HashError))
+            {
+                context.Reporter.Error() << indent << Resource::String::HashFileFailed(Utility::LocIndView{ GetUserPresentableMessage(result.HashError) }) << std::endl;
+                return result.HashError;
+            }
+
+            context.Reporter.Info() << indent << "InstallerSha256: "_liv << Utility::LocIndString{ Utility::SHA256::ConvertToString(result.Hash) } << std::endl;
+
+            if (FAILED(result.SignatureHashError))
+            {
+                context.Reporter.Warn() <<
+                    indent << Resource::String::MsixSignatureHashFailed << std::endl <<
+                    indent << Resource::String::VerifyFileSignedMsix << std::endl;
+                return result.SignatureHashError;
+            }
+            else if (!result.SignatureHash.empty())
+            {
+                context.Reporter.Info() << indent << "SignatureSha256: "_liv << Utility::LocIndString{ Utility::SHA256::ConvertToString(result.SignatureHash) } << std::endl;
+            }
+
+            return S_OK;
+        }
+
+        void HashFiles(Execution::Context& context)
+        {
+            bool expandedDirectory = false;
+            std::vector<std::filesystem::path> files = GetFilesToHash(context, expandedDirectory);
+
+            if (files.empty())
+            {
+                context.Reporter.Error() << Resource::String::HashNoFilesFound << std::endl;
+                AICLI_TERMINATE_CONTEXT(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+            }
+
+            bool computeSignatureHash = context.Args.Contains(Execution::Args::Type::Msix);
+            bool includePath = expandedDirectory || files.size() > 1;
+
+            // Results are reported by this thread as the workers complete them, in whatever order that is.
+            std::mutex resultsMutex;
+            std::condition_variable resultsCondition;
+            std::queue<HashResult> completed;
+            std::atomic<size_t> next = 0;
+
+            size_t threadCount = Utility::GetConcurrentThreadCount(files.size());
+            size_t running = threadCount;
+
+            auto worker = [&]()
+            {
+                auto previousThreadGlobals = context.SetForCurrentThread();
+
+                // Always count the worker as done, so that reporting below cannot wait forever.
+                auto markDone = wil::scope_exit([&]()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock{ resultsMutex };
+                        --running;
+                    }
+                    resultsCondition.notify_one();
+                });
+
+                for (size_t i = next++; i < files.size() && !context.IsTerminated(); i = next++)
+                {
+                    HashResult result = HashFile(files[i], computeSignatureHash);
+
+                    {
+                        std::lock_guard<std::mutex> lock{ resultsMutex };
+                        completed.emplace(std::move(result));
+                    }
+                    resultsCondition.notify_one();
+                }
+            };
+
+            HRESULT firstError = S_OK;
+            auto monitor = [&]()
+            {
+                for (;;)
+                {
+                    HashResult result;
+                    {
+                        std::unique_lock<std::mutex> lock{ resultsMutex };
+                        resultsCondition.wait(lock, [&]() { return !completed.empty() || running == 0; });
+                        if (completed.empty())
+                        {
+                            break;
+                        }
+
+                        result = std::move(completed.front());
+                        completed.pop();
+                    }
+
+                    HRESULT hr = ReportHashResult(context, result, includePath);
+                    if (FAILED(hr) && SUCCEEDED(firstError))
+                    {
+                        firstError = hr;
+                    }
+                }
+            };
+
+            Utility::RunConcurrently(threadCount, worker, monitor);
+
+            if (FAILED(firstError))
+            {
+                AICLI_TERMINATE_CONTEXT(firstError);
+            }
+        }
+    }
+
     std::vector<Argument> HashCommand::GetArguments() const
     {
         return {
@@ -38,31 +275,7 @@ namespace AppInstaller::CLI
     void HashCommand::ExecuteInternal(Execution::Context& context) const
     {
         context <<
-            Workflow::VerifyFile(Execution::Args::Type::HashFile) <<
-            [](Execution::Context& context)
-        {
-            auto inputFile = context.Args.GetArg(Execution::Args::Type::HashFile);
-            std::ifstream inStream{ Utility::ConvertToUTF16(inputFile), std::ifstream::binary };
-
-            context.Reporter.Info() << "InstallerSha256: "_liv << Utility::LocIndString{ Utility::SHA256::ConvertToString(Utility::SHA256::ComputeHash(inStream)) } << std::endl;
-
-            if (context.Args.Contains(Execution::Args::Type::Msix))
-            {
-                try
-                {
-                    Msix::MsixInfo msixInfo{ inputFile };
-                    auto signatureHash = msixInfo.GetSignatureHash();
-
-                    context.Reporter.Info() << "SignatureSha256: "_liv << Utility::LocIndString{ Utility::SHA256::ConvertToString(signatureHash) } << std::endl;
-                }
-                catch (const wil::ResultException& re)
-                {
-                    context.Reporter.Warn() << 
-                        Resource::String::MsixSignatureHashFailed << std::endl <<
-                        Resource::String::VerifyFileSignedMsix << std::endl;
-                    AICLI_TERMINATE_CONTEXT(re.GetErrorCode());
-                }
-            }
-        };
+            Workflow::VerifyFile(Execution::Args::Type::HashFile, true) <<
+            HashFiles;
     }
 }
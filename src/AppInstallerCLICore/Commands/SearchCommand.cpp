@@ -82,6 +82,7 @@ namespace AppInstaller::CLI
         context <<
             Workflow::OpenSource() <<
             Workflow::SearchSourceForMany <<
+            Workflow::SearchSourceForManyFuzzyIfNoMatches <<
             Workflow::HandleSearchResultFailures;
 
             if (context.Args.Contains(Execution::Args::Type::ListVersions))
@@ -11,6 +11,8 @@
 #include <AppInstallerFileLogger.h>
 #include <winget/OutputDebugStringLogger.h>
 #include "Public/ShutdownMonitoring.h"
+#include "StartupTrace.h"
+#include <winget/SQLiteProfiler.h>
 
 #ifndef AICLI_DISABLE_TEST_HOOKS
 #include <winget/Debugging.h>
@@ -78,10 +80,40 @@ namespace AppInstaller::CLI
             main.Wait = WaitOnMainWaitEvent;
             ShutdownMonitoring::ServerShutdownSynchronization::AddComponent(main);
         }
+
+        // Determines whether the invocation only needs the minimum of initialization. Shell completion runs on every
+        // key press and, like printing the version, does not need a log file or the log directory to be cleaned up.
+        bool IsLightweightInvocation(const std::vector<std::string>& args)
+        {
+            if (args.empty())
+            {
+                return false;
+            }
+
+            const std::string& first = args[0];
+            return Utility::CaseInsensitiveEquals(first, "complete") || first == "--version" || first == "-v";
+        }
+
+        void WriteTraceFileIfRequested(Execution::Context& context, const StartupTrace& startupTrace)
+        {
+            if (context.Args.Contains(Execution::Args::Type::TraceFile))
+            {
+                try
+                {
+                    auto& traceRecorder = Execution::TraceRecorder::Instance();
+                    startupTrace.AddTo(traceRecorder);
+                    traceRecorder.WriteTraceFile(Utility::ConvertToUTF16(context.Args.GetArg(Execution::Args::Type::TraceFile)));
+                }
+                CATCH_LOG();
+            }
+        }
     }
 
     int CoreMain(int argc, wchar_t const** argv) try
     {
+        StartupTrace startupTrace;
+        startupTrace.EndPhase("process");
+
         // This prevents the OS package management from terminating the CLI process before it has had a chance to gracefully exit.
         RegisterShutdownBlocker();
         auto signalMainExit = wil::scope_exit([]() { GetMainWaitEvent().SetEvent(); });
@@ -105,46 +137,54 @@ namespace AppInstaller::CLI
 #endif
 
         Logging::UseGlobalTelemetryLoggerActivityIdOnly();
+        startupTrace.EndPhase("initialize");
 
         Execution::Context context;
         auto previousThreadGlobals = context.SetForCurrentThread();
+        startupTrace.EndPhase("context");
+
+        // Convert incoming wide char args to UTF8
+        std::vector<std::string> utf8Args;
+        for (int i = 1; i < argc; ++i)
+        {
+            utf8Args.emplace_back(Utility::ConvertToUTF8(argv[i]));
+        }
+
+        bool isLightweightInvocation = IsLightweightInvocation(utf8Args);
 
         // Set up debug string logging during initialization
         Logging::OutputDebugStringLogger::Add();
         Logging::Log().SetEnabledChannels(Logging::Channel::All);
         Logging::Log().SetLevel(Logging::Level::Verbose);
 
-        Logging::Log().SetEnabledChannels(Settings::User().Get<Settings::Setting::LoggingChannelPreference>());
-        Logging::Log().SetLevel(Settings::User().Get<Settings::Setting::LoggingLevelPreference>());
-        Logging::FileLogger::Add();
+        if (!isLightweightInvocation)
+        {
+            Logging::Log().SetEnabledChannels(Settings::User().Get<Settings::Setting::LoggingChannelPreference>());
+            Logging::Log().SetLevel(Settings::User().Get<Settings::Setting::LoggingLevelPreference>());
+            Logging::FileLogger::Add();
+
+            if (Settings::User().Get<Settings::Setting::LoggingSQLProfile>())
+            {
+                Logging::Log().EnableChannel(Logging::Channel::SQL);
+                SQLite::Profiler::Instance().Enable(Settings::User().Get<Settings::Setting::LoggingSQLSlowStatementThresholdInMs>());
+            }
+        }
+
         Logging::OutputDebugStringLogger::Remove();
         Logging::EnableWilFailureTelemetry();
+        startupTrace.EndPhase("logging");
 
         // Set output to UTF8
         ConsoleOutputCPRestore utf8CP(CP_UTF8);
 
         Logging::Telemetry().SetCaller("winget-cli");
         Logging::Telemetry().LogStartup();
-
-#ifndef AICLI_DISABLE_TEST_HOOKS
-        if (!Settings::User().Get<Settings::Setting::KeepAllLogFiles>())
-#endif
-        {
-            // Initiate the background cleanup of the log file location.
-            Logging::FileLogger::BeginCleanup();
-        }
+        startupTrace.EndPhase("telemetry");
 
         context.EnableSignalTerminationHandler();
 
         context << Workflow::ReportExecutionStage(Workflow::ExecutionStage::ParseArgs);
 
-        // Convert incoming wide char args to UTF8
-        std::vector<std::string> utf8Args;
-        for (int i = 1; i < argc; ++i)
-        {
-            utf8Args.emplace_back(Utility::ConvertToUTF8(argv[i]));
-        }
-
         AICLI_LOG(CLI, Info, << "WinGet invoked with arguments:" << [&]() {
                 std::stringstream strstr;
                 for (const auto& arg : utf8Args)
@@ -201,7 +241,38 @@ namespace AppInstaller::CLI
             return Workflow::HandleException(context, std::current_exception());
         }
 
-        return Execute(context, command);
+        startupTrace.EndPhase("parse");
+        startupTrace.Log();
+
+        if (context.Args.Contains(Execution::Args::Type::TraceFile))
+        {
+            // Record every workflow task from here on, including those run in sub-contexts and on other threads.
+            Execution::TraceRecorder::Instance().Enable(startupTrace.GetStart());
+        }
+
+        bool cleanupLogFiles = !isLightweightInvocation;
+#ifndef AICLI_DISABLE_TEST_HOOKS
+        cleanupLogFiles = cleanupLogFiles && !Settings::User().Get<Settings::Setting::KeepAllLogFiles>();
+#endif
+
+        if (cleanupLogFiles)
+        {
+            // Initiate the background cleanup of the log file location.
+            // This waits until the arguments are parsed so that it does not compete with the startup of the process.
+            Logging::FileLogger::BeginCleanup();
+        }
+
+        int result = Execute(context, command);
+
+        startupTrace.EndPhase("execute");
+        WriteTraceFileIfRequested(context, startupTrace);
+
+        if (SQLite::Profiler::Instance().IsEnabled())
+        {
+            SQLite::Profiler::Instance().LogSummary();
+        }
+
+        return result;
     }
     // End of the line exceptions that are not ever expected.
     // Telemetry cannot be reliable beyond this point, so don't let these happen.
@@ -179,6 +179,7 @@ namespace AppInstaller::CLI::Execution
             Force, // Forces the execution of the workflow with non security related issues
             OutputFile,
             Correlation,
+            TraceFile, // Writes a trace of the execution to the given file
 
             DependencySource, // Index source to be queried against for finding dependencies
             CustomHeader, // Optional Rest source header
@@ -228,6 +228,12 @@ namespace AppInstaller::CLI::Execution
         return m_threadGlobals->SetForCurrentThread();
     }
 
+    uint32_t Context::GetNextId()
+    {
+        static std::atomic<uint32_t> s_nextId = 1;
+        return s_nextId++;
+    }
+
 #ifndef AICLI_DISABLE_TEST_HOOKS
     bool Context::ShouldExecuteWorkflowTask(const Workflow::WorkflowTask& task)
     {
@@ -165,6 +165,9 @@ namespace AppInstaller::CLI::Execution
 
         std::unique_ptr<AppInstaller::ThreadLocalStorage::PreviousThreadGlobals> SetForCurrentThread();
 
+        // Gets an identifier for the context that is unique within the process; sub-contexts get their own.
+        uint32_t GetId() const { return m_id; }
+
         // Gets the executing command
         AppInstaller::CLI::Command* GetExecutingCommand() { return m_executingCommand; }
 
@@ -201,6 +204,9 @@ namespace AppInstaller::CLI::Execution
         std::function<bool(const Workflow::WorkflowTask&)> m_shouldExecuteWorkflowTask;
 
     private:
+        static uint32_t GetNextId();
+
+        uint32_t m_id = GetNextId();
         DestructionToken m_disableSignalTerminationHandlerOnExit = false;
         bool m_isTerminated = false;
         HRESULT m_terminationHR = S_OK;
@@ -4,6 +4,7 @@
 #include <AppInstallerDownloader.h>
 #include <winget/RepositorySource.h>
 #include <winget/Manifest.h>
+#include <winget/Archive.h>
 #include <winget/ARPCorrelation.h>
 #include <winget/Authentication.h>
 #include <winget/Pin.h>
@@ -69,6 +70,7 @@ namespace AppInstaller::CLI::Execution
         RepairString,
         MsixDigests,
         InstallerDownloadAuthenticators,
+        ExtractedFiles,
         Max
     };
 
@@ -299,5 +301,12 @@ namespace AppInstaller::CLI::Execution
             // The authenticator map shared with sub contexts
             using value_t = std::shared_ptr<std::map<Authentication::AuthenticationInfo, Authentication::Authenticator>>;
         };
+
+        template<>
+        struct DataMapping<Data::ExtractedFiles>
+        {
+            // The files extracted from the archive, with the hashes computed while writing them
+            using value_t = Archive::ExtractedFiles;
+        };
     }
 }
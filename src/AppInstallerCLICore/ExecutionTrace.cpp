@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ExecutionTrace.h"
+
+namespace AppInstaller::CLI::Execution
+{
+    namespace
+    {
+        Json::Int64 ToMicroseconds(TraceRecorder::clock::duration duration)
+        {
+            return static_cast<Json::Int64>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+        }
+    }
+
+    TraceRecorder::Span::Span(TraceRecorder& recorder, std::string name, std::string_view category, std::optional<uint32_t> contextId) :
+        m_recorder(recorder)
+    {
+        m_event.Name = std::move(name);
+        m_event.Category = category;
+        m_event.ThreadId = GetCurrentThreadId();
+        m_event.ContextId = contextId;
+        m_event.Start = clock::now();
+    }
+
+    TraceRecorder::Span::~Span()
+    {
+        m_event.End = clock::now();
+        m_recorder.Add(std::move(m_event));
+    }
+
+    TraceRecorder& TraceRecorder::Instance()
+    {
+        static TraceRecorder s_instance;
+        return s_instance;
+    }
+
+    void TraceRecorder::Enable(clock::time_point origin)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_lock };
+            m_origin = origin;
+        }
+
+        m_enabled = true;
+    }
+
+    void TraceRecorder::Disable()
+    {
+        m_enabled = false;
+    }
+
+    void TraceRecorder::Add(Event&& event)
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_events.emplace_back(std::move(event));
+    }
+
+    std::vector<TraceRecorder::Event> TraceRecorder::GetEvents() const
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        return m_events;
+    }
+
+    void TraceRecorder::WriteTraceFile(const std::filesystem::path& path) const
+    {
+        Json::Value events{ Json::ValueType::arrayValue };
+        Json::Int64 processId = static_cast<Json::Int64>(GetCurrentProcessId());
+
+        {
+            std::lock_guard<std::mutex> lock{ m_lock };
+
+            for (const auto& event : m_events)
+            {
+                Json::Value value{ Json::ValueType::objectValue };
+                value["name"] = event.Name;
+                value["cat"] = std::string{ event.Category };
+                value["ph"] = "X";
+                value["ts"] = ToMicroseconds(event.Start - m_origin);
+                value["dur"] = ToMicroseconds(event.End - event.Start);
+                value["pid"] = processId;
+                value["tid"] = static_cast<Json::Int64>(event.ThreadId);
+
+                if (event.ContextId)
+                {
+                    value["args"]["context"] = event.ContextId.value();
+                }
+
+                events.append(std::move(value));
+            }
+        }
+
+        Json::Value root{ Json::ValueType::objectValue };
+        root["traceEvents"] = std::move(events);
+        root["displayTimeUnit"] = "ms";
+
+        Json::StreamWriterBuilder writerBuilder;
+        writerBuilder.settings_["indentation"] = "";
+
+        std::ofstream stream{ path, std::ios::out | std::ios::trunc };
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_OPEN_FAILED), !stream);
+        stream << Json::writeString(writerBuilder, root);
+    }
+}
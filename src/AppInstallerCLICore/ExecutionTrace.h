@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AppInstaller::CLI::Execution
+{
+    // Records timed spans of execution from any thread, to be written as a Chrome trace event file
+    // that can be opened in chrome://tracing or https://ui.perfetto.dev.
+    // Nothing is recorded until the recorder is enabled; until then, checking whether to record is a single atomic load.
+    struct TraceRecorder
+    {
+        using clock = std::chrono::steady_clock;
+
+        // A span of execution; written as a complete ("X") event.
+        struct Event
+        {
+            std::string Name;
+            std::string_view Category;
+            clock::time_point Start;
+            clock::time_point End;
+            DWORD ThreadId = 0;
+            std::optional<uint32_t> ContextId;
+        };
+
+        // Records an event for the lifetime of the object, on the thread that created it.
+        struct Span
+        {
+            Span(TraceRecorder& recorder, std::string name, std::string_view category, std::optional<uint32_t> contextId = {});
+
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+            Span(Span&&) = delete;
+            Span& operator=(Span&&) = delete;
+
+            ~Span();
+
+        private:
+            TraceRecorder& m_recorder;
+            Event m_event;
+        };
+
+        TraceRecorder() = default;
+
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        TraceRecorder(TraceRecorder&&) = delete;
+        TraceRecorder& operator=(TraceRecorder&&) = delete;
+
+        // Gets the recorder for the process.
+        static TraceRecorder& Instance();
+
+        // Starts recording; the times of the events are written relative to the given origin.
+        void Enable(clock::time_point origin);
+
+        // Stops recording; the events recorded so far are kept.
+        void Disable();
+
+        bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        // Adds the event to the trace, if recording is enabled.
+        void Add(Event&& event);
+
+        // Gets a copy of the events recorded so far.
+        std::vector<Event> GetEvents() const;
+
+        // Writes the events recorded so far to the given file.
+        void WriteTraceFile(const std::filesystem::path& path) const;
+
+    private:
+        std::atomic_bool m_enabled = false;
+        clock::time_point m_origin;
+        mutable std::mutex m_lock;
+        std::vector<Event> m_events;
+    };
+}
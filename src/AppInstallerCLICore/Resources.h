@@ -343,6 +343,8 @@ namespace AppInstaller::CLI::Resource
         WINGET_DEFINE_RESOURCE_STRINGID(GetManifestResultVersionNotFound);
         WINGET_DEFINE_RESOURCE_STRINGID(HashCommandLongDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(HashCommandShortDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(HashFileFailed);
+        WINGET_DEFINE_RESOURCE_STRINGID(HashNoFilesFound);
         WINGET_DEFINE_RESOURCE_STRINGID(HashOverrideArgumentDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(HeaderArgumentDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(HeaderArgumentNotApplicableForNonRestSourceWarning);
@@ -625,6 +627,7 @@ namespace AppInstaller::CLI::Resource
         WINGET_DEFINE_RESOURCE_STRINGID(SearchId);
         WINGET_DEFINE_RESOURCE_STRINGID(SearchMatch);
         WINGET_DEFINE_RESOURCE_STRINGID(SearchName);
+        WINGET_DEFINE_RESOURCE_STRINGID(SearchSimilarMatches);
         WINGET_DEFINE_RESOURCE_STRINGID(SearchSource);
         WINGET_DEFINE_RESOURCE_STRINGID(SearchTruncated);
         WINGET_DEFINE_RESOURCE_STRINGID(SearchVersion);
@@ -782,6 +785,7 @@ namespace AppInstaller::CLI::Resource
         WINGET_DEFINE_RESOURCE_STRINGID(ToolVersionArgumentDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(TooManyArgError);
         WINGET_DEFINE_RESOURCE_STRINGID(TooManyBehaviorsError);
+        WINGET_DEFINE_RESOURCE_STRINGID(TraceFileArgumentDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(UnableToPurgeInstallDirectory);
         WINGET_DEFINE_RESOURCE_STRINGID(Unavailable);
         WINGET_DEFINE_RESOURCE_STRINGID(UnexpectedErrorExecutingCommand);
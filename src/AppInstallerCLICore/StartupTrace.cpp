@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "StartupTrace.h"
+#include <AppInstallerDateTime.h>
+
+namespace AppInstaller::CLI
+{
+    namespace
+    {
+        // Gets the creation time of the current process in terms of the steady clock.
+        StartupTrace::clock::time_point GetProcessCreationTime()
+        {
+            auto steadyNow = StartupTrace::clock::now();
+            auto systemNow = std::chrono::system_clock::now();
+
+            FILETIME creationTime{};
+            FILETIME exitTime{};
+            FILETIME kernelTime{};
+            FILETIME userTime{};
+            if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+            {
+                LOG_LAST_ERROR();
+                return steadyNow;
+            }
+
+            auto sinceCreation = systemNow - Utility::ConvertFiletimeToSystemClock(creationTime);
+            if (sinceCreation.count() < 0)
+            {
+                // The system clock was changed under us; only the phases within CoreMain can be measured.
+                return steadyNow;
+            }
+
+            return steadyNow - std::chrono::duration_cast<StartupTrace::clock::duration>(sinceCreation);
+        }
+
+        double ToMilliseconds(StartupTrace::clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    }
+
+    StartupTrace::StartupTrace() : StartupTrace(GetProcessCreationTime()) {}
+
+    StartupTrace::StartupTrace(clock::time_point start) : m_start(start), m_threadId(GetCurrentThreadId())
+    {
+        // There are only a handful of phases; avoid allocating while they are being measured.
+        m_phases.reserve(16);
+    }
+
+    void StartupTrace::EndPhase(std::string_view name)
+    {
+        m_phases.emplace_back(Phase{ name, clock::now() });
+    }
+
+    void StartupTrace::Log() const
+    {
+        if (m_phases.empty())
+        {
+            return;
+        }
+
+        AICLI_LOG(CLI, Info, << "Startup phases [ms]:" << [&]() {
+                std::ostringstream strstr;
+                strstr << std::fixed << std::setprecision(1);
+
+                clock::time_point begin = m_start;
+                for (const auto& phase : m_phases)
+                {
+                    strstr << ' ' << phase.Name << '=' << ToMilliseconds(phase.End - begin);
+                    begin = phase.End;
+                }
+
+                strstr << " total=" << ToMilliseconds(m_phases.back().End - m_start);
+                return strstr.str();
+            }());
+    }
+
+    void StartupTrace::AddTo(Execution::TraceRecorder& recorder) const
+    {
+        clock::time_point begin = m_start;
+        for (const auto& phase : m_phases)
+        {
+            Execution::TraceRecorder::Event event;
+            event.Name = phase.Name;
+            event.Category = "startup";
+            event.Start = begin;
+            event.End = phase.End;
+            event.ThreadId = m_threadId;
+            recorder.Add(std::move(event));
+
+            begin = phase.End;
+        }
+    }
+}
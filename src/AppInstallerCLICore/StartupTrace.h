@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include "ExecutionTrace.h"
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+namespace AppInstaller::CLI
+{
+    // Records when each phase of the process startup ends, so that the cost of initialization is visible.
+    // Each phase begins where the previous one ended; the first begins when the process was created,
+    // which includes the time spent loading the binaries before CoreMain is reached.
+    struct StartupTrace
+    {
+        using clock = Execution::TraceRecorder::clock;
+
+        // Starts the trace at the creation time of the current process.
+        StartupTrace();
+
+        // Starts the trace at the given time.
+        StartupTrace(clock::time_point start);
+
+        // Records that the named phase ends now.
+        // Only the view is stored, so the name must outlive the trace (a literal).
+        void EndPhase(std::string_view name);
+
+        // Writes the duration of each phase to the log.
+        void Log() const;
+
+        // Gets the time at which the first phase began.
+        clock::time_point GetStart() const { return m_start; }
+
+        // Adds the phases to the recorder as events.
+        void AddTo(Execution::TraceRecorder& recorder) const;
+
+    private:
+        struct Phase
+        {
+            std::string_view Name;
+            clock::time_point End;
+        };
+
+        clock::time_point m_start;
+        DWORD m_threadId = 0;
+        std::vector<Phase> m_phases;
+    };
+}
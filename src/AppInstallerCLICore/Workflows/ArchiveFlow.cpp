@@ -54,13 +54,37 @@ namespace AppInstaller::CLI::Workflow
         AICLI_LOG(CLI, Info, << "Extracting archive to: " << destinationFolder);
         context.Reporter.Info() << Resource::String::ExtractingArchive << std::endl;
 
-        if (Settings::User().Get<Settings::Setting::ArchiveExtractionMethod>() == Archive::ExtractionMethod::Tar)
+        Archive::ExtractionMethod extractionMethod = Settings::User().Get<Settings::Setting::ArchiveExtractionMethod>();
+
+        if (extractionMethod == Archive::ExtractionMethod::Tar)
         {
             context << ShellExecuteExtractArchive(installerPath, destinationFolder);
         }
         else
         {
-            HRESULT result = AppInstaller::Archive::TryExtractArchive(installerPath, destinationFolder);
+            HRESULT result = S_OK;
+
+            if (extractionMethod == Archive::ExtractionMethod::ShellApi)
+            {
+                result = AppInstaller::Archive::TryExtractArchive(installerPath, destinationFolder);
+            }
+            else
+            {
+                // Only the portable flow records the hashes of the extracted files, so other nested installers skip hashing.
+                const auto& installer = context.Get<Execution::Data::Installer>().value();
+                bool hashFiles = IsPortableType(installer.NestedInstallerType);
+
+                Archive::ExtractedFiles extractedFiles;
+                result = context.Reporter.ExecuteWithProgress([&](IProgressCallback& progress)
+                    {
+                        return AppInstaller::Archive::TryExtractZipArchive(installerPath, destinationFolder, progress, hashFiles ? &extractedFiles : nullptr);
+                    }, true);
+
+                if (SUCCEEDED(result) && hashFiles)
+                {
+                    context.Add<Execution::Data::ExtractedFiles>(std::move(extractedFiles));
+                }
+            }
 
             if (SUCCEEDED(result))
             {
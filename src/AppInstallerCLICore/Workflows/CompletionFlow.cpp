@@ -22,6 +22,203 @@ namespace AppInstaller::CLI::Workflow
                 stream << value << std::endl;
             }
         }
+
+        // Gets the fields that the completion indexes of the sources hold for the argument, in the order that the standard
+        // completion searches them. Empty if the argument is not completed from package fields.
+        std::vector<Repository::PackageMatchField> GetCompletionIndexFields(Execution::Args::Type type)
+        {
+            switch (type)
+            {
+            case Execution::Args::Type::Query:
+            case Execution::Args::Type::MultiQuery:
+                // The fields of SearchSourceForSingleCompletion.
+                return { Repository::PackageMatchField::Id, Repository::PackageMatchField::Name, Repository::PackageMatchField::Moniker };
+            case Execution::Args::Type::Id: return { Repository::PackageMatchField::Id };
+            case Execution::Args::Type::Name: return { Repository::PackageMatchField::Name };
+            case Execution::Args::Type::Moniker: return { Repository::PackageMatchField::Moniker };
+            case Execution::Args::Type::Tag: return { Repository::PackageMatchField::Tag };
+            case Execution::Args::Type::Command: return { Repository::PackageMatchField::Command };
+            default: return {};
+            }
+        }
+
+        // Sorts the values into case folded order and removes duplicates, keeping no more than maximum values when it is not 0.
+        void SortCompletionValues(std::vector<std::string>& values, size_t maximum)
+        {
+            std::vector<std::pair<std::string, std::string>> keyedValues;
+            keyedValues.reserve(values.size());
+            for (auto& value : values)
+            {
+                keyedValues.emplace_back(Utility::FoldCase(std::string_view{ value }), std::move(value));
+            }
+
+            std::sort(keyedValues.begin(), keyedValues.end());
+            keyedValues.erase(std::unique(keyedValues.begin(), keyedValues.end()), keyedValues.end());
+
+            if (maximum && keyedValues.size() > maximum)
+            {
+                keyedValues.resize(maximum);
+            }
+
+            values.clear();
+            for (auto& keyedValue : keyedValues)
+            {
+                values.emplace_back(std::move(keyedValue.second));
+            }
+        }
+
+        // Completes the value from the completion indexes of the sources, opening and searching only those sources without one.
+        // The values of each field are sorted together, and the fields are output in the order that the standard completion searches them.
+        // Returns false if no source has an index, or the index cannot be used, in which case the standard completion should be used.
+        bool TryCompleteFromCompletionIndex(Execution::Context& context, Execution::Args::Type type)
+        {
+            std::vector<Repository::PackageMatchField> fields = GetCompletionIndexFields(type);
+            if (fields.empty())
+            {
+                return false;
+            }
+
+            const std::string& word = context.Get<Data::CompletionData>().Word();
+            bool isQuery = (type == Execution::Args::Type::Query || type == Execution::Args::Type::MultiQuery);
+
+            // The standard completion does not complete an empty query.
+            if (isQuery && word.empty())
+            {
+                return false;
+            }
+
+            // The index only holds the values themselves, so the other fields cannot be used to filter them.
+            for (auto filterType : { Execution::Args::Type::Id, Execution::Args::Type::Name, Execution::Args::Type::Moniker,
+                Execution::Args::Type::ProductCode, Execution::Args::Type::Tag, Execution::Args::Type::Command })
+            {
+                if (context.Args.Contains(filterType))
+                {
+                    return false;
+                }
+            }
+
+            size_t maximum = 0;
+            std::vector<std::vector<std::string>> fieldValues(fields.size());
+            std::vector<Repository::SourceDetails> unindexedSources;
+
+            try
+            {
+                std::string_view sourceName;
+                if (context.Args.Contains(Execution::Args::Type::Source))
+                {
+                    sourceName = context.Args.GetArg(Execution::Args::Type::Source);
+                }
+
+                Repository::Source source{ sourceName };
+                if (!source)
+                {
+                    return false;
+                }
+
+                if (context.Args.Contains(Execution::Args::Type::Count))
+                {
+                    maximum = static_cast<size_t>(std::stoi(std::string{ context.Args.GetArg(Execution::Args::Type::Count) }));
+                }
+
+                for (size_t i = 0; i < fields.size(); ++i)
+                {
+                    Repository::CompletionValuesResult completionValues = source.GetCompletionValues(fields[i], word, maximum);
+
+                    // When no source has an index, the standard completion is the same without reading them again.
+                    if (completionValues.IndexedSourceCount == 0)
+                    {
+                        return false;
+                    }
+
+                    fieldValues[i] = std::move(completionValues.Values);
+                    unindexedSources = std::move(completionValues.UnindexedSources);
+                }
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION_MSG("Failed to read the completion indexes");
+                return false;
+            }
+
+            if (!unindexedSources.empty())
+            {
+                for (const auto& details : unindexedSources)
+                {
+                    context << Workflow::OpenNamedSourceForSources(details.Name);
+                    if (context.IsTerminated())
+                    {
+                        return true;
+                    }
+                }
+
+                const auto& sources = context.Get<Data::Sources>();
+                context.Add<Data::Source>(sources.size() == 1 ? sources[0] : Repository::Source{ sources });
+
+                if (isQuery)
+                {
+                    context << Workflow::SearchSourceForSingleCompletion;
+                }
+                else
+                {
+                    context << Workflow::SearchSourceForCompletionField(fields[0]);
+                }
+
+                if (context.IsTerminated())
+                {
+                    return true;
+                }
+
+                for (const auto& match : context.Get<Data::SearchResult>().Matches)
+                {
+                    // As with CompleteWithMatchedField, a match without a value completes the package identifier.
+                    Repository::PackageMatchField field = match.MatchCriteria.Field;
+                    std::string value = match.MatchCriteria.Value;
+                    if (value.empty())
+                    {
+                        field = Repository::PackageMatchField::Id;
+                        value = match.Package->GetProperty(Repository::PackageProperty::Id);
+                    }
+
+                    auto itr = std::find(fields.begin(), fields.end(), field);
+                    size_t index = (itr == fields.end() ? fields.size() - 1 : static_cast<size_t>(itr - fields.begin()));
+                    fieldValues[index].emplace_back(std::move(value));
+                }
+
+                for (auto& values : fieldValues)
+                {
+                    SortCompletionValues(values, maximum);
+                }
+            }
+
+            // A value of an earlier field is not repeated for a later one.
+            std::vector<std::string> result;
+            std::set<std::string> foldedValues;
+            for (auto& values : fieldValues)
+            {
+                for (auto& value : values)
+                {
+                    if (maximum && result.size() >= maximum)
+                    {
+                        break;
+                    }
+
+                    if (foldedValues.emplace(Utility::FoldCase(std::string_view{ value })).second)
+                    {
+                        result.emplace_back(std::move(value));
+                    }
+                }
+            }
+
+            AICLI_LOG(CLI, Verbose, << "Completed " << result.size() << " values using the completion indexes of the sources");
+
+            auto stream = context.Reporter.Completion();
+            for (const auto& value : result)
+            {
+                OutputCompletionString(stream, value);
+            }
+
+            return true;
+        }
     }
 
     void CompleteSourceName(Execution::Context& context)
@@ -128,6 +325,11 @@ namespace AppInstaller::CLI::Workflow
 
     void CompleteWithSingleSemanticsForValue::operator()(Execution::Context& context) const
     {
+        if (TryCompleteFromCompletionIndex(context, m_type))
+        {
+            return;
+        }
+
         switch (m_type)
         {
         case Execution::Args::Type::Query:
@@ -79,6 +79,21 @@ namespace AppInstaller::CLI::Workflow
                 AICLI_TERMINATE_CONTEXT(APPINSTALLER_CLI_ERROR_INVALID_MANIFEST);
             }
         }
+
+        // Gets the hash computed while the file was extracted, or empty if it must be computed from the file.
+        std::string GetExtractedFileSha256(Execution::Context& context, const std::filesystem::path& path)
+        {
+            if (context.Contains(Execution::Data::ExtractedFiles))
+            {
+                auto hash = Archive::GetExtractedFileHash(context.Get<Execution::Data::ExtractedFiles>(), path);
+                if (hash)
+                {
+                    return SHA256::ConvertToString(hash.value());
+                }
+            }
+
+            return {};
+        }
     }
 
     void VerifyPackageAndSourceMatch(Execution::Context& context)
@@ -209,7 +224,7 @@ namespace AppInstaller::CLI::Workflow
                 }
                 else
                 {
-                    entries.emplace_back(std::move(PortableFileEntry::CreateFileEntry(entryPath, targetPath, {})));
+                    entries.emplace_back(std::move(PortableFileEntry::CreateFileEntry(entryPath, targetPath, GetExtractedFileSha256(context, entryPath))));
                 }
             }
 
@@ -260,7 +275,7 @@ namespace AppInstaller::CLI::Workflow
             AppInstaller::Filesystem::AppendExtension(commandAlias, ".exe");
 
             const std::filesystem::path& targetFullPath = targetInstallDirectory / commandAlias;
-            entries.emplace_back(std::move(PortableFileEntry::CreateFileEntry(installerPath, targetFullPath, {})));
+            entries.emplace_back(std::move(PortableFileEntry::CreateFileEntry(installerPath, targetFullPath, GetExtractedFileSha256(context, installerPath))));
             entries.emplace_back(std::move(PortableFileEntry::CreateSymlinkEntry(symlinkDirectory / commandAlias, targetFullPath)));
         }
 
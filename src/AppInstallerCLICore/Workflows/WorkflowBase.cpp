@@ -3,6 +3,7 @@
 #include "pch.h"
 #include "WorkflowBase.h"
 #include "ExecutionContext.h"
+#include "ExecutionTrace.h"
 #include "PackageTableSortHelper.h"
 #include "PromptFlow.h"
 #include "ShowFlow.h"
@@ -316,6 +317,34 @@ namespace AppInstaller::CLI::Workflow
             }
         }
 
+        // Searches the source for many packages, matching the query and filters with the given match type.
+        SearchResult SearchSourceForManyWithMatchType(Execution::Context& context, std::string_view type, MatchType matchType)
+        {
+            const auto& args = context.Args;
+
+            SearchRequest searchRequest;
+
+            if (args.Contains(Execution::Args::Type::Query))
+            {
+                searchRequest.Query.emplace(RequestMatch(matchType, args.GetArg(Execution::Args::Type::Query)));
+            }
+
+            SearchSourceApplyFilters(context, searchRequest, matchType);
+
+            Logging::Telemetry().LogSearchRequest(
+                type,
+                args.GetArg(Execution::Args::Type::Query),
+                args.GetArg(Execution::Args::Type::Id),
+                args.GetArg(Execution::Args::Type::Name),
+                args.GetArg(Execution::Args::Type::Moniker),
+                args.GetArg(Execution::Args::Type::Tag),
+                args.GetArg(Execution::Args::Type::Command),
+                searchRequest.MaximumResults,
+                searchRequest.ToString());
+
+            return context.Get<Execution::Data::Source>().Search(searchRequest);
+        }
+
         // Data shown on a line of a table displaying installed packages
         struct InstalledPackagesTableLine
         {
@@ -544,6 +573,20 @@ namespace AppInstaller::CLI::Workflow
         }
     }
 
+    std::string WorkflowTask::GetTraceName() const
+    {
+        if (m_isFunc)
+        {
+            std::ostringstream strstr;
+            strstr << "Task+0x" << std::hex << (reinterpret_cast<char*>(m_func) - reinterpret_cast<char*>(&__ImageBase));
+            return strstr.str();
+        }
+        else
+        {
+            return m_name;
+        }
+    }
+
     Repository::PredefinedSource DetermineInstalledSource(const Execution::Context& context)
     {
         Repository::PredefinedSource installedSource = Repository::PredefinedSource::Installed;
@@ -845,35 +888,36 @@ namespace AppInstaller::CLI::Workflow
 
     void SearchSourceForMany(Execution::Context& context)
     {
-        const auto& args = context.Args;
-
         MatchType matchType = MatchType::Substring;
-        if (args.Contains(Execution::Args::Type::Exact))
+        if (context.Args.Contains(Execution::Args::Type::Exact))
         {
             matchType = MatchType::Exact;
         }
 
-        SearchRequest searchRequest;
+        context.Add<Execution::Data::SearchResult>(SearchSourceForManyWithMatchType(context, "many", matchType));
+    }
 
-        if (args.Contains(Execution::Args::Type::Query))
+    void SearchSourceForManyFuzzyIfNoMatches(Execution::Context& context)
+    {
+        const auto& searchResult = context.Get<Execution::Data::SearchResult>();
+
+        // An exact search is taken as meant, and a search that failed on a source may have matched there.
+        if (context.Args.Contains(Execution::Args::Type::Exact) || !searchResult.Matches.empty() || !searchResult.Failures.empty())
         {
-            searchRequest.Query.emplace(RequestMatch(matchType, args.GetArg(Execution::Args::Type::Query)));
+            return;
         }
 
-        SearchSourceApplyFilters(context, searchRequest, matchType);
-
-        Logging::Telemetry().LogSearchRequest(
-            "many",
-            args.GetArg(Execution::Args::Type::Query),
-            args.GetArg(Execution::Args::Type::Id),
-            args.GetArg(Execution::Args::Type::Name),
-            args.GetArg(Execution::Args::Type::Moniker),
-            args.GetArg(Execution::Args::Type::Tag),
-            args.GetArg(Execution::Args::Type::Command),
-            searchRequest.MaximumResults,
-            searchRequest.ToString());
+        SearchResult fuzzyResult = SearchSourceForManyWithMatchType(context, "fuzzy", MatchType::FuzzySubstring);
 
-        context.Add<Execution::Data::SearchResult>(context.Get<Execution::Data::Source>().Search(searchRequest));
+        if (!fuzzyResult.Matches.empty())
+        {
+            context.Reporter.Info() << Resource::String::SearchSimilarMatches << std::endl;
+            context.Add<Execution::Data::SearchResult>(std::move(fuzzyResult));
+        }
+        else if (!fuzzyResult.Failures.empty())
+        {
+            AICLI_LOG(CLI, Info, << "Search for similar packages failed on " << fuzzyResult.Failures.size() << " source(s)");
+        }
     }
 
     void GetSearchRequestForSingle(Execution::Context& context)
@@ -1534,18 +1578,21 @@ namespace AppInstaller::CLI::Workflow
 
     void VerifyFile::operator()(Execution::Context& context) const
     {
-        std::filesystem::path path = Utility::ConvertToUTF16(context.Args.GetArg(m_arg));
-
-        if (!std::filesystem::exists(path))
+        for (const auto& arg : *context.Args.GetArgs(m_arg))
         {
-            context.Reporter.Error() << Resource::String::VerifyFileFailedNotExist(Utility::LocIndView{ path.u8string() }) << std::endl;
-            AICLI_TERMINATE_CONTEXT(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
-        }
+            std::filesystem::path path = Utility::ConvertToUTF16(arg);
 
-        if (std::filesystem::is_directory(path))
-        {
-            context.Reporter.Error() << Resource::String::VerifyFileFailedIsDirectory(Utility::LocIndView{ path.u8string() }) << std::endl;
-            AICLI_TERMINATE_CONTEXT(HRESULT_FROM_WIN32(ERROR_DIRECTORY_NOT_SUPPORTED));
+            if (!std::filesystem::exists(path))
+            {
+                context.Reporter.Error() << Resource::String::VerifyFileFailedNotExist(Utility::LocIndView{ path.u8string() }) << std::endl;
+                AICLI_TERMINATE_CONTEXT(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+            }
+
+            if (!m_allowDirectory && std::filesystem::is_directory(path))
+            {
+                context.Reporter.Error() << Resource::String::VerifyFileFailedIsDirectory(Utility::LocIndView{ path.u8string() }) << std::endl;
+                AICLI_TERMINATE_CONTEXT(HRESULT_FROM_WIN32(ERROR_DIRECTORY_NOT_SUPPORTED));
+            }
         }
     }
 
@@ -1849,6 +1896,14 @@ AppInstaller::CLI::Execution::Context& operator<<(AppInstaller::CLI::Execution::
 #endif
         {
             task.Log();
+
+            std::optional<AppInstaller::CLI::Execution::TraceRecorder::Span> traceSpan;
+            auto& traceRecorder = AppInstaller::CLI::Execution::TraceRecorder::Instance();
+            if (traceRecorder.IsEnabled())
+            {
+                traceSpan.emplace(traceRecorder, task.GetTraceName(), "task", context.GetId());
+            }
+
             task(context);
         }
     }
@@ -72,6 +72,10 @@ namespace AppInstaller::CLI::Workflow
         bool ExecuteAlways() const { return m_executeAlways; }
         void Log() const;
 
+        // Gets the name of the task for an execution trace; function tasks are named by their offset in the module,
+        // which can be resolved with the symbols for the build.
+        std::string GetTraceName() const;
+
     private:
         bool m_isFunc = false;
         Func m_func = nullptr;
@@ -164,6 +168,13 @@ namespace AppInstaller::CLI::Workflow
     // Outputs: SearchResult
     void SearchSourceForMany(Execution::Context& context);
 
+    // Searches the source again for packages similar to the query and filters when the search found nothing,
+    // so that a misspelled search still finds what was meant. Does nothing for an exact search.
+    // Required Args: None
+    // Inputs: Source, SearchResult
+    // Outputs: SearchResult
+    void SearchSourceForManyFuzzyIfNoMatches(Execution::Context& context);
+
     // Creates a search request object with the semantics of targeting a single package.
     // Required Args: None
     // Inputs: Query, search filters (Id, Name, etc.)
@@ -306,18 +317,19 @@ namespace AppInstaller::CLI::Workflow
         bool m_considerPins;
     };
 
-    // Ensures the file exists and is not a directory.
+    // Ensures each of the files given for the argument exists and, unless allowed, is not a directory.
     // Required Args: the one given
     // Inputs: None
     // Outputs: None
     struct VerifyFile : public WorkflowTask
     {
-        VerifyFile(Execution::Args::Type arg) : WorkflowTask("VerifyFile"), m_arg(arg) {}
+        VerifyFile(Execution::Args::Type arg, bool allowDirectory = false) : WorkflowTask("VerifyFile"), m_arg(arg), m_allowDirectory(allowDirectory) {}
 
         void operator()(Execution::Context& context) const override;
 
     private:
         Execution::Args::Type m_arg;
+        bool m_allowDirectory;
     };
 
     // Ensures the path exists.
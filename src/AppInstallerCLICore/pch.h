@@ -20,11 +20,13 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <csignal>
 #include <iostream>
 #include <fstream>
 #include <future>
 #include <functional>
+#include <iomanip>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -53,6 +53,37 @@ struct TestTelemetry : public TelemetryTraceLogger
     mutable bool WasLogSuccessfulInstallARPChangeCalled = false;
 };
 
+// Produces the ARP entry snapshots from the test's "everything" result rather than the registry.
+struct TestARPEntrySnapshotEnumerator : public IARPEntrySnapshotEnumerator
+{
+    std::vector<ARPEntrySnapshot> Enumerate() const override
+    {
+        std::vector<ARPEntrySnapshot> result;
+
+        for (const auto& match : EverythingResult->Matches)
+        {
+            auto installed = GetInstalledVersion(match.Package);
+
+            ARPEntrySnapshot snapshot;
+            snapshot.Id = installed->GetProperty(PackageVersionProperty::Id).get();
+            snapshot.DisplayVersion = installed->GetProperty(PackageVersionProperty::Version).get();
+
+            auto itr = LastWriteTimes.find(snapshot.Id);
+            if (itr != LastWriteTimes.end())
+            {
+                snapshot.LastWriteTime = itr->second;
+            }
+
+            result.emplace_back(std::move(snapshot));
+        }
+
+        return result;
+    }
+
+    const SearchResult* EverythingResult = nullptr;
+    std::map<std::string, uint64_t> LastWriteTimes;
+};
+
 struct ARPTestContext : public Context
 {
     ARPTestContext(Manifest::InstallerTypeEnum installerType = Manifest::InstallerTypeEnum::Exe) :
@@ -101,7 +132,10 @@ struct ARPTestContext : public Context
             ARPLanguage = arpLanguage;
         };
 
-        // Inject our source
+        // Inject our source, and derive the ARP entry snapshots from it
+        SnapshotEnumerator.EverythingResult = &EverythingResult;
+        IARPEntrySnapshotEnumerator::OverrideInstance(&SnapshotEnumerator);
+
         TestHook_SetSourceFactoryOverride(std::string{ Repository::Microsoft::PredefinedInstalledSourceFactory::Type() }, SourceFactory);
 
         Source = std::make_shared<TestSource>();
@@ -122,6 +156,7 @@ struct ARPTestContext : public Context
     {
         TestHook_ClearSourceFactoryOverrides();
         TestHook_SetTelemetryOverride({});
+        IARPEntrySnapshotEnumerator::ResetInstance();
     }
 
     void AddEverythingResult(std::string_view id, std::string_view name, std::string_view publisher, std::string_view version)
@@ -171,6 +206,7 @@ struct ARPTestContext : public Context
     std::istringstream IStream;
     std::shared_ptr<TestTelemetry> Logger;
     TestSourceFactory SourceFactory;
+    TestARPEntrySnapshotEnumerator SnapshotEnumerator;
     std::shared_ptr<TestSource> Source;
     SearchResult EverythingResult;
     SearchResult MatchResult;
@@ -258,10 +294,9 @@ TEST_CASE("ARPChanges_CheckSnapshot", "[ARPChanges][workflow]")
         bool found = false;
         for (auto itr = snapshot.begin(); itr != snapshot.end(); ++itr)
         {
-            if (match.Package->GetProperty(PackageProperty::Id) == std::get<0>(*itr))
+            if (match.Package->GetProperty(PackageProperty::Id).get() == itr->Id)
             {
-                REQUIRE(GetInstalledVersion(match.Package)->GetProperty(PackageVersionProperty::Version) == std::get<1>(*itr));
-                REQUIRE(GetInstalledVersion(match.Package)->GetProperty(PackageVersionProperty::Channel) == std::get<2>(*itr));
+                REQUIRE(GetInstalledVersion(match.Package)->GetProperty(PackageVersionProperty::Version).get() == itr->DisplayVersion);
 
                 snapshot.erase(itr);
                 found = true;
@@ -274,6 +309,22 @@ TEST_CASE("ARPChanges_CheckSnapshot", "[ARPChanges][workflow]")
     REQUIRE(snapshot.empty());
 }
 
+TEST_CASE("ARPChanges_LastWriteTimeChange_SingleMatch", "[ARPChanges][workflow]")
+{
+    TestHeuristicOverride heuristicOverride;
+    ARPTestContext context;
+
+    context << SnapshotARPEntries;
+    REQUIRE(context.Contains(Data::ARPCorrelationData));
+
+    // Rewriting an existing entry without changing its version is still a change
+    context.SnapshotEnumerator.LastWriteTimes["Id1"] = 1;
+    context.MatchResult.Matches.emplace_back(context.EverythingResult.Matches.front());
+
+    context << ReportARPChanges;
+    context.ExpectEvent(1, 1, 1, context.MatchResult.Matches.back().Package);
+}
+
 TEST_CASE("ARPChanges_NoChange_NoMatch", "[ARPChanges][workflow]")
 {
     TestHeuristicOverride heuristicOverride;
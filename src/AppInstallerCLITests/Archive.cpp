@@ -3,12 +3,136 @@
 #include "pch.h"
 #include "TestCommon.h"
 #include <winget/Archive.h>
+#include <zlib.h>
 
 using namespace AppInstaller::Archive;
+using namespace AppInstaller::Utility;
 using namespace TestCommon;
 
 constexpr std::string_view s_ZipFile = "TestZip.zip";
 
+namespace
+{
+    struct SyntheticZipEntry
+    {
+        std::string Name;
+        std::string Data;
+        bool Compress = true;
+    };
+
+    template <typename T>
+    void AppendLittleEndian(std::string& out, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    std::string DeflateRaw(std::string_view data)
+    {
+        z_stream stream{};
+        REQUIRE(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+        std::string result(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef*>(result.data());
+        stream.avail_out = static_cast<uInt>(result.size());
+
+        int error = deflate(&stream, Z_FINISH);
+        deflateEnd(&stream);
+        REQUIRE(error == Z_STREAM_END);
+
+        result.resize(stream.total_out);
+        return result;
+    }
+
+    // Creates text that compresses about as well as typical package content.
+    std::string CreateSyntheticText(size_t size, uint32_t seed)
+    {
+        static constexpr std::string_view s_words[] = { "install", "package", "winget", "manifest", "version", "source", "portable", "archive" };
+        std::mt19937 random{ seed };
+
+        std::string result;
+        result.reserve(size + 16);
+        while (result.size() < size)
+        {
+            result += s_words[random() % ARRAYSIZE(s_words)];
+            result += (random() % 8 == 0) ? '\n' : ' ';
+        }
+
+        result.resize(size);
+        return result;
+    }
+
+    // Writes a zip archive in the plainest form that the scanner accepts; no extra fields, data descriptors or zip64.
+    void WriteSyntheticZip(const std::filesystem::path& path, const std::vector<SyntheticZipEntry>& entries)
+    {
+        // 2024-01-01 as an MS-DOS date; the time is left at midnight.
+        constexpr uint16_t dosDate = ((2024 - 1980) << 9) | (1 << 5) | 1;
+
+        std::string archive;
+        std::string centralDirectory;
+
+        for (const auto& entry : entries)
+        {
+            std::string data = entry.Compress ? DeflateRaw(entry.Data) : entry.Data;
+            uint32_t crc = static_cast<uint32_t>(crc32_z(0, reinterpret_cast<const Bytef*>(entry.Data.data()), entry.Data.size()));
+            uint16_t method = entry.Compress ? 8 : 0;
+            uint32_t offset = static_cast<uint32_t>(archive.size());
+
+            AppendLittleEndian<uint32_t>(archive, 0x04034b50);
+            AppendLittleEndian<uint16_t>(archive, 20);
+            AppendLittleEndian<uint16_t>(archive, 0);
+            AppendLittleEndian<uint16_t>(archive, method);
+            AppendLittleEndian<uint16_t>(archive, 0);
+            AppendLittleEndian<uint16_t>(archive, dosDate);
+            AppendLittleEndian<uint32_t>(archive, crc);
+            AppendLittleEndian<uint32_t>(archive, static_cast<uint32_t>(data.size()));
+            AppendLittleEndian<uint32_t>(archive, static_cast<uint32_t>(entry.Data.size()));
+            AppendLittleEndian<uint16_t>(archive, static_cast<uint16_t>(entry.Name.size()));
+            AppendLittleEndian<uint16_t>(archive, 0);
+            archive += entry.Name;
+            archive += data;
+
+            AppendLittleEndian<uint32_t>(centralDirectory, 0x02014b50);
+            AppendLittleEndian<uint16_t>(centralDirectory, 20);
+            AppendLittleEndian<uint16_t>(centralDirectory, 20);
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint16_t>(centralDirectory, method);
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint16_t>(centralDirectory, dosDate);
+            AppendLittleEndian<uint32_t>(centralDirectory, crc);
+            AppendLittleEndian<uint32_t>(centralDirectory, static_cast<uint32_t>(data.size()));
+            AppendLittleEndian<uint32_t>(centralDirectory, static_cast<uint32_t>(entry.Data.size()));
+            AppendLittleEndian<uint16_t>(centralDirectory, static_cast<uint16_t>(entry.Name.size()));
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint16_t>(centralDirectory, 0);
+            AppendLittleEndian<uint32_t>(centralDirectory, 0);
+            AppendLittleEndian<uint32_t>(centralDirectory, offset);
+            centralDirectory += entry.Name;
+        }
+
+        uint32_t centralDirectoryOffset = static_cast<uint32_t>(archive.size());
+        archive += centralDirectory;
+
+        AppendLittleEndian<uint32_t>(archive, 0x06054b50);
+        AppendLittleEndian<uint16_t>(archive, 0);
+        AppendLittleEndian<uint16_t>(archive, 0);
+        AppendLittleEndian<uint16_t>(archive, static_cast<uint16_t>(entries.size()));
+        AppendLittleEndian<uint16_t>(archive, static_cast<uint16_t>(entries.size()));
+        AppendLittleEndian<uint32_t>(archive, static_cast<uint32_t>(centralDirectory.size()));
+        AppendLittleEndian<uint32_t>(archive, centralDirectoryOffset);
+        AppendLittleEndian<uint16_t>(archive, 0);
+
+        std::ofstream stream{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+        stream.write(archive.data(), archive.size());
+    }
+}
+
 TEST_CASE("Extract_ZipArchive", "[archive]")
 {
     TestCommon::TempDirectory tempDirectory("TempDirectory");
@@ -24,6 +148,133 @@ TEST_CASE("Extract_ZipArchive", "[archive]")
     REQUIRE(std::filesystem::exists(expectedPath));
 }
 
+TEST_CASE("Extract_ZipArchive_Native", "[archive]")
+{
+    TestCommon::TempDirectory tempDirectory("TempDirectory");
+    TestDataFile testZip(s_ZipFile);
+    TestProgress progress;
+
+    HRESULT hr = TryExtractZipArchive(testZip.GetPath(), tempDirectory.GetPath(), progress);
+
+    REQUIRE(SUCCEEDED(hr));
+    REQUIRE(std::filesystem::exists(tempDirectory.GetPath() / "test.txt"));
+}
+
+TEST_CASE("Extract_SyntheticZipArchive_Native", "[archive]")
+{
+    TestCommon::TempDirectory tempDirectory("TempDirectory");
+    TestCommon::TempFile zipFile("SyntheticZip", ".zip");
+    TestProgress progress;
+
+    uint64_t lastProgress = 0;
+    progress.m_OnProgress = [&](uint64_t current, uint64_t, AppInstaller::ProgressType type)
+    {
+        REQUIRE(type == AppInstaller::ProgressType::Bytes);
+        lastProgress = current;
+    };
+
+    std::vector<SyntheticZipEntry> entries;
+    entries.push_back({ "large.txt", CreateSyntheticText(8 * 1024 * 1024, 1) });
+    entries.push_back({ "stored.txt", CreateSyntheticText(4096, 2), false });
+    for (int i = 0; i < 200; ++i)
+    {
+        entries.push_back({ "nested/" + std::to_string(i % 10) + "/" + std::to_string(i) + ".txt", CreateSyntheticText(1024, 3 + i) });
+    }
+
+    SECTION("Valid")
+    {
+        WriteSyntheticZip(zipFile, entries);
+        REQUIRE(SUCCEEDED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+
+        uint64_t totalSize = 0;
+        for (const auto& entry : entries)
+        {
+            std::ifstream stream{ tempDirectory.GetPath() / entry.Name, std::ios::in | std::ios::binary };
+            REQUIRE(stream);
+            std::string contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+            REQUIRE(contents == entry.Data);
+            totalSize += entry.Data.size();
+        }
+
+        REQUIRE(lastProgress == totalSize);
+    }
+    SECTION("Hashes")
+    {
+        WriteSyntheticZip(zipFile, entries);
+
+        ExtractedFiles extractedFiles;
+        REQUIRE(SUCCEEDED(TryExtractZipArchive(zipFile, tempDirectory, progress, &extractedFiles)));
+        REQUIRE(extractedFiles.size() == entries.size());
+
+        for (const auto& entry : entries)
+        {
+            auto hash = GetExtractedFileHash(extractedFiles, tempDirectory.GetPath() / entry.Name);
+            REQUIRE(hash);
+            REQUIRE(SHA256::AreEqual(hash.value(), SHA256::ComputeHash(entry.Data)));
+        }
+
+        // A file changed after extraction no longer uses the recorded hash
+        std::filesystem::path changedFile = tempDirectory.GetPath() / entries[1].Name;
+        {
+            std::ofstream stream{ changedFile, std::ios::out | std::ios::binary | std::ios::app };
+            stream << "changed";
+        }
+
+        REQUIRE_FALSE(GetExtractedFileHash(extractedFiles, changedFile));
+    }
+    SECTION("Corrupted data")
+    {
+        entries[1].Data[100] ^= 1;
+        WriteSyntheticZip(zipFile, entries);
+
+        // Flip the byte back in the archive, so the stored CRC no longer matches the data
+        std::fstream stream{ zipFile.GetPath(), std::ios::in | std::ios::out | std::ios::binary };
+        std::string contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+        size_t position = contents.find(entries[1].Data);
+        REQUIRE(position != std::string::npos);
+        stream.seekp(position + 100);
+        stream.put(static_cast<char>(entries[1].Data[100] ^ 1));
+        stream.close();
+
+        REQUIRE(FAILED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+    }
+    SECTION("Path traversal")
+    {
+        entries.push_back({ "nested/../../escaped.txt", CreateSyntheticText(1024, 1000) });
+        WriteSyntheticZip(zipFile, entries);
+
+        REQUIRE(FAILED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+        REQUIRE_FALSE(std::filesystem::exists(tempDirectory.GetPath().parent_path() / "escaped.txt"));
+    }
+    SECTION("Alternate data stream")
+    {
+        entries.push_back({ "stored.txt:stream", CreateSyntheticText(1024, 1000) });
+        WriteSyntheticZip(zipFile, entries);
+
+        REQUIRE(FAILED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+    }
+    SECTION("Device name")
+    {
+        std::string deviceName = GENERATE(as<std::string>{}, "CON", "nul.txt", "nested/Aux .log", "nested/COM1/file.txt", "lpt9", "CONOUT$");
+        INFO(deviceName);
+
+        entries.push_back({ deviceName, CreateSyntheticText(1024, 1000) });
+        WriteSyntheticZip(zipFile, entries);
+
+        REQUIRE(FAILED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+    }
+    SECTION("Not a device name")
+    {
+        entries.push_back({ "CONSOLE.txt", CreateSyntheticText(1024, 1000) });
+        entries.push_back({ "COM10.txt", CreateSyntheticText(1024, 1001) });
+        WriteSyntheticZip(zipFile, entries);
+
+        REQUIRE(SUCCEEDED(TryExtractZipArchive(zipFile, tempDirectory, progress)));
+        REQUIRE(std::filesystem::exists(tempDirectory.GetPath() / "CONSOLE.txt"));
+        REQUIRE(std::filesystem::exists(tempDirectory.GetPath() / "COM10.txt"));
+    }
+}
+
 TEST_CASE("Scan_ZipArchive", "[archive]")
 {
     TestDataFile testZip(s_ZipFile);
@@ -32,3 +283,78 @@ TEST_CASE("Scan_ZipArchive", "[archive]")
     bool result = ScanZipFile(testZipPath);
     REQUIRE(result);
 }
+
+TEST_CASE("Scan_SyntheticZipArchive", "[archive]")
+{
+    TestCommon::TempFile zipFile("SyntheticZip", ".zip");
+
+    std::vector<SyntheticZipEntry> entries;
+    entries.push_back({ "large.txt", CreateSyntheticText(16 * 1024 * 1024, 1) });
+    entries.push_back({ "stored.txt", CreateSyntheticText(4096, 2), false });
+    for (int i = 0; i < 100; ++i)
+    {
+        entries.push_back({ "small/" + std::to_string(i) + ".txt", CreateSyntheticText(1024, 3 + i) });
+    }
+
+    SECTION("Valid")
+    {
+        WriteSyntheticZip(zipFile, entries);
+        REQUIRE(ScanZipFile(zipFile));
+    }
+    SECTION("Corrupted data")
+    {
+        entries[1].Data[100] ^= 1;
+        WriteSyntheticZip(zipFile, entries);
+
+        // Flip the byte back in the archive, so the stored CRC no longer matches the data
+        std::fstream stream{ zipFile.GetPath(), std::ios::in | std::ios::out | std::ios::binary };
+        std::string contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+        size_t position = contents.find(entries[1].Data);
+        REQUIRE(position != std::string::npos);
+        stream.seekp(position + 100);
+        stream.put(static_cast<char>(entries[1].Data[100] ^ 1));
+        stream.close();
+
+        REQUIRE_FALSE(ScanZipFile(zipFile));
+    }
+    SECTION("Corrupted compressed data")
+    {
+        WriteSyntheticZip(zipFile, entries);
+
+        // The large entry makes up most of the archive, and is verified concurrently with the others
+        std::fstream stream{ zipFile.GetPath(), std::ios::in | std::ios::out | std::ios::binary };
+        stream.seekg(0, std::ios::end);
+        std::streamoff middle = stream.tellg() / 2;
+        stream.seekg(middle);
+        char value = static_cast<char>(stream.get());
+        stream.seekp(middle);
+        stream.put(static_cast<char>(value ^ 0x55));
+        stream.close();
+
+        REQUIRE_FALSE(ScanZipFile(zipFile));
+    }
+}
+
+TEST_CASE("Scan_SyntheticZipArchive_Benchmark", "[archive][.][benchmark]")
+{
+    TestCommon::TempFile largeZipFile("SyntheticZipLarge", ".zip");
+    WriteSyntheticZip(largeZipFile, { { "large.txt", CreateSyntheticText(512 * 1024 * 1024, 1) } });
+
+    TestCommon::TempFile manyZipFile("SyntheticZipMany", ".zip");
+    std::vector<SyntheticZipEntry> entries;
+    for (int i = 0; i < 5000; ++i)
+    {
+        entries.push_back({ "files/" + std::to_string(i) + ".txt", CreateSyntheticText(16 * 1024, i) });
+    }
+    WriteSyntheticZip(manyZipFile, entries);
+
+    BENCHMARK("Large entry")
+    {
+        return ScanZipFile(largeZipFile);
+    };
+
+    BENCHMARK("Many entries")
+    {
+        return ScanZipFile(manyZipFile);
+    };
+}
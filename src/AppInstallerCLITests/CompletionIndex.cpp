@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include "SyntheticData.h"
+#include <winget/CompletionIndex.h>
+
+using namespace std::string_literals;
+using namespace TestCommon;
+using namespace AppInstaller::Repository;
+using namespace AppInstaller::Repository::Microsoft;
+
+namespace
+{
+    std::map<PackageMatchField, std::vector<std::string>> GetTestValues()
+    {
+        std::map<PackageMatchField, std::vector<std::string>> result;
+        result[PackageMatchField::Id] = { "Contoso.Tool", "contoso.Editor", "Fabrikam.Tool", "Contoso.Tool", "", "Contoso.Player" };
+        result[PackageMatchField::Tag] = { "editor", "Editor", "tool" };
+        return result;
+    }
+}
+
+TEST_CASE("CompletionIndex_RoundTrip", "[completionindex]")
+{
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    CompletionIndex::Write(tempFile, GetTestValues());
+
+    std::optional<CompletionIndex> index = CompletionIndex::Open(tempFile);
+    REQUIRE(index);
+
+    // Duplicates and empty values are dropped, and the values are ordered ignoring case.
+    REQUIRE(index->GetValues(PackageMatchField::Id, "") == std::vector<std::string>{ "contoso.Editor", "Contoso.Player", "Contoso.Tool", "Fabrikam.Tool" });
+    REQUIRE(index->GetValues(PackageMatchField::Id, "CONTOSO.") == std::vector<std::string>{ "contoso.Editor", "Contoso.Player", "Contoso.Tool" });
+    REQUIRE(index->GetValues(PackageMatchField::Id, "contoso.t") == std::vector<std::string>{ "Contoso.Tool" });
+    REQUIRE(index->GetValues(PackageMatchField::Id, "Contoso.Tools").empty());
+    REQUIRE(index->GetValues(PackageMatchField::Id, "Zzz").empty());
+
+    // Values that differ only by case are both kept.
+    REQUIRE(index->GetValues(PackageMatchField::Tag, "ed").size() == 2);
+
+    // Fields that were not written have no values.
+    REQUIRE(index->GetValues(PackageMatchField::Moniker, "").empty());
+}
+
+TEST_CASE("CompletionIndex_Maximum", "[completionindex]")
+{
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    CompletionIndex::Write(tempFile, GetTestValues());
+
+    std::optional<CompletionIndex> index = CompletionIndex::Open(tempFile);
+    REQUIRE(index);
+
+    REQUIRE(index->GetValues(PackageMatchField::Id, "contoso", 2) == std::vector<std::string>{ "contoso.Editor", "Contoso.Player" });
+    REQUIRE(index->GetValues(PackageMatchField::Id, "contoso", 10).size() == 3);
+}
+
+TEST_CASE("CompletionIndex_Replace", "[completionindex]")
+{
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    CompletionIndex::Write(tempFile, GetTestValues());
+
+    std::map<PackageMatchField, std::vector<std::string>> values;
+    values[PackageMatchField::Id] = { "Other.Package" };
+    CompletionIndex::Write(tempFile, values);
+
+    std::optional<CompletionIndex> index = CompletionIndex::Open(tempFile);
+    REQUIRE(index);
+    REQUIRE(index->GetValues(PackageMatchField::Id, "") == std::vector<std::string>{ "Other.Package" });
+    REQUIRE(index->GetValues(PackageMatchField::Tag, "").empty());
+}
+
+TEST_CASE("CompletionIndex_Missing", "[completionindex]")
+{
+    TempDirectory tempDirectory{ "completionindex" };
+
+    REQUIRE(!CompletionIndex::Open(tempDirectory.GetPath() / "missing.idx"));
+    REQUIRE(!CompletionIndex::Open(tempDirectory.GetPath() / "missing" / "missing.idx"));
+}
+
+TEST_CASE("CompletionIndex_Invalid", "[completionindex]")
+{
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    std::string contents = GENERATE("", "WGCI", "This is not a completion index, but it is long enough to be one.");
+
+    {
+        std::ofstream stream{ tempFile.GetPath(), std::ios::out | std::ios::binary | std::ios::trunc };
+        stream << contents;
+    }
+
+    REQUIRE(!CompletionIndex::Open(tempFile));
+}
+
+TEST_CASE("CompletionIndex_Truncated", "[completionindex]")
+{
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    CompletionIndex::Write(tempFile, GetTestValues());
+    std::filesystem::resize_file(tempFile, std::filesystem::file_size(tempFile) - 4);
+
+    REQUIRE(!CompletionIndex::Open(tempFile));
+}
+
+TEST_CASE("CompletionIndex_Benchmark", "[completionindex][.][benchmark]")
+{
+    SyntheticPackageOptions options;
+    options.PackageCount = 5000;
+    options.VersionsPerPackage = 1;
+    std::vector<AppInstaller::Manifest::Manifest> manifests = CreateSyntheticManifests(options);
+
+    SQLiteIndex sqliteIndex = SQLiteIndex::CreateNew(SQLITE_MEMORY_DB_CONNECTION_TARGET, AppInstaller::SQLite::Version{ 1, 7 });
+    AddSyntheticManifests(sqliteIndex, manifests);
+
+    std::map<PackageMatchField, std::vector<std::string>> values;
+    for (PackageMatchField field : CompletionIndex::Fields)
+    {
+        values[field] = sqliteIndex.GetAllValues(field);
+    }
+
+    TempFile tempFile{ "completionindex"s, ".idx"s };
+
+    BENCHMARK("Write")
+    {
+        CompletionIndex::Write(tempFile, values);
+    };
+
+    std::vector<std::string> prefixes;
+    for (size_t i = 0; i < manifests.size(); i += manifests.size() / 20)
+    {
+        prefixes.emplace_back(manifests[i].Id.substr(0, manifests[i].Id.find('.') + 2));
+    }
+
+    BENCHMARK("Open and complete identifiers")
+    {
+        std::optional<CompletionIndex> index = CompletionIndex::Open(tempFile);
+
+        size_t result = 0;
+        for (const auto& prefix : prefixes)
+        {
+            result += index->GetValues(PackageMatchField::Id, prefix).size();
+        }
+        return result;
+    };
+
+    BENCHMARK("Search identifiers")
+    {
+        size_t result = 0;
+        for (const auto& prefix : prefixes)
+        {
+            SearchRequest request;
+            request.Inclusions.emplace_back(PackageMatchFilter(PackageMatchField::Id, MatchType::StartsWith, prefix));
+            result += sqliteIndex.Search(request).Matches.size();
+        }
+        return result;
+    };
+}
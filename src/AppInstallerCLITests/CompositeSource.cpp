@@ -4,6 +4,7 @@
 #include "TestCommon.h"
 #include "TestSource.h"
 #include "TestHooks.h"
+#include "SyntheticData.h"
 #include <CompositeSource.h>
 #include <Microsoft/SQLiteIndexSource.h>
 #include <Microsoft/PinningIndex.h>
@@ -2037,3 +2038,68 @@ TEST_CASE("CompositeSource_MappedVersions_ProperSorting", "[CompositeSource]")
     REQUIRE(installedVersions[0].Version == versionMapped2);
     REQUIRE(installedVersions[1].Version == versionMapped1);
 }
+
+TEST_CASE("CompositeSource_Correlation_Benchmark", "[CompositeSource][.][benchmark]")
+{
+    SyntheticPackageOptions options;
+    options.PackageCount = 5000;
+    std::vector<Manifest::Manifest> availableManifests = CreateSyntheticManifests(options);
+
+    // Half of the installed entries correlate to an available package, and the rest are unknown to the source.
+    std::vector<Manifest::Manifest> installedManifests = CreateSyntheticInstalledManifests(availableManifests, 400, 0.5);
+
+    SourceDetails availableDetails;
+    availableDetails.Name = "Synthetic";
+    availableDetails.Identifier = "SyntheticAvailable";
+    SQLiteIndex availableIndex = SQLiteIndex::CreateNew(SQLITE_MEMORY_DB_CONNECTION_TARGET);
+    AddSyntheticManifests(availableIndex, availableManifests);
+    auto available = std::make_shared<SQLiteIndexSource>(availableDetails, std::move(availableIndex));
+
+    // The installed source is built in the same way as the predefined installed source builds it from ARP.
+    SourceDetails installedDetails;
+    installedDetails.Identifier = "*SyntheticInstalled";
+    installedDetails.Origin = SourceOrigin::Predefined;
+    SQLiteIndex installedIndex = SQLiteIndex::CreateNew(SQLITE_MEMORY_DB_CONNECTION_TARGET, SQLite::Version::Latest(), SQLiteIndex::CreateOptions::SupportPathless);
+    AddSyntheticManifests(installedIndex, installedManifests, false);
+    auto installed = std::make_shared<SQLiteIndexSource>(installedDetails, std::move(installedIndex), /* isInstalledSource */ true);
+
+    auto tracking = std::make_shared<SQLiteIndexSource>(SourceDetails{}, SQLiteIndex::CreateNew(SQLITE_MEMORY_DB_CONNECTION_TARGET));
+    TestSourceFactory trackingFactory{ [&](const SourceDetails&) { return tracking; } };
+    TestHook_SetSourceFactoryOverride(std::string{ PackageTrackingCatalogSourceFactory::Type() }, trackingFactory);
+    auto clearOverrides = wil::scope_exit([]() { TestHook_ClearSourceFactoryOverrides(); });
+
+    CompositeSource composite{ "*SyntheticComposite" };
+    composite.SetInstalledSource(Source{ installed });
+    composite.AddAvailableSource(Source{ available });
+
+    // Verify the data set outside of the measurement, so that a change that breaks correlation is not reported as a speedup.
+    size_t expectedCorrelated = 0;
+    for (const auto& match : composite.Search({}).Matches)
+    {
+        if (!match.Package->GetAvailable().empty())
+        {
+            ++expectedCorrelated;
+        }
+    }
+    REQUIRE(expectedCorrelated == installedManifests.size() / 2);
+
+    BENCHMARK("Correlate all installed")
+    {
+        size_t correlated = 0;
+        for (const auto& match : composite.Search({}).Matches)
+        {
+            if (!match.Package->GetAvailable().empty())
+            {
+                ++correlated;
+            }
+        }
+        return correlated;
+    };
+
+    BENCHMARK("Search installed by name")
+    {
+        SearchRequest request;
+        request.Query = RequestMatch(MatchType::Substring, "studio");
+        return composite.Search(request).Matches.size();
+    };
+}
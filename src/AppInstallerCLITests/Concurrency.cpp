@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winget/Concurrency.h>
+
+using namespace AppInstaller::Utility;
+
+TEST_CASE("ForEachConcurrently_RunsEveryIndex", "[concurrency]")
+{
+    size_t count = GENERATE(size_t{ 0 }, size_t{ 1 }, size_t{ 1000 });
+    size_t maximumThreads = GENERATE(size_t{ 0 }, size_t{ 1 }, size_t{ 3 });
+
+    std::vector<std::atomic<size_t>> runs(count);
+    ForEachConcurrently(count, [&](size_t i) { ++runs[i]; }, maximumThreads);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        INFO(i);
+        REQUIRE(runs[i].load() == 1);
+    }
+}
+
+TEST_CASE("ForEachConcurrently_RethrowsFirstFailure", "[concurrency]")
+{
+    std::atomic<size_t> runs = 0;
+
+    REQUIRE_THROWS_HR(ForEachConcurrently(100, [&](size_t i)
+        {
+            ++runs;
+            if (i == 70)
+            {
+                THROW_HR(E_ACCESSDENIED);
+            }
+            else if (i == 30)
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+        }), E_INVALIDARG);
+
+    REQUIRE(runs.load() == 100);
+}
+
+TEST_CASE("RunConcurrently_Monitor", "[concurrency]")
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t running = 4;
+    bool monitored = false;
+
+    RunConcurrently(running, [&]()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                --running;
+            }
+            condition.notify_all();
+        },
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            condition.wait(lock, [&]() { return running == 0; });
+            monitored = true;
+        });
+
+    REQUIRE(running == 0);
+    REQUIRE(monitored);
+}
+
+TEST_CASE("RunConcurrently_WorkerFailure", "[concurrency]")
+{
+    std::atomic<size_t> runs = 0;
+
+    REQUIRE_THROWS_HR(RunConcurrently(4, [&]()
+        {
+            ++runs;
+            THROW_HR(E_ABORT);
+        }), E_ABORT);
+
+    REQUIRE(runs.load() == 4);
+}
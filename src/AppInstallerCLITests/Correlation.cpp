@@ -92,6 +92,115 @@ ARPEntry GetExistingARPEntryFromTestCase(const TestCase& testCase)
     return GetARPEntryFromTestCase(testCase, /* isNew */ false);
 }
 
+// The original implementation of the words edit distance algorithm, with a full table of distances
+// between the word strings. Used to check that the optimized implementation computes the same values.
+struct ReferenceWordsEditDistanceMatchConfidenceAlgorithm : public IARPMatchConfidenceAlgorithm
+{
+    using WordSequence = WordsEditDistanceMatchConfidenceAlgorithm::WordSequence;
+    using NameAndPublisher = WordsEditDistanceMatchConfidenceAlgorithm::NameAndPublisher;
+
+    void Init(const Manifest& manifest) override
+    {
+        m_namesAndPublishers.clear();
+
+        WordSequence defaultPublisher;
+        if (manifest.DefaultLocalization.Contains(Localization::Publisher))
+        {
+            defaultPublisher = NormalizeAndPreparePublisher(manifest.DefaultLocalization.Get<Localization::Publisher>());
+        }
+
+        if (manifest.DefaultLocalization.Contains(Localization::PackageName))
+        {
+            WordSequence defaultName = NormalizeAndPrepareName(manifest.DefaultLocalization.Get<Localization::PackageName>());
+            m_namesAndPublishers.emplace_back(defaultName, defaultPublisher);
+
+            for (const auto& loc : manifest.Localizations)
+            {
+                if (loc.Contains(Localization::PackageName) || loc.Contains(Localization::Publisher))
+                {
+                    auto name = loc.Contains(Localization::PackageName) ? NormalizeAndPrepareName(loc.Get<Localization::PackageName>()) : defaultName;
+                    auto publisher = loc.Contains(Localization::Publisher) ? NormalizeAndPreparePublisher(loc.Get<Localization::Publisher>()) : defaultPublisher;
+
+                    m_namesAndPublishers.emplace_back(std::move(name), std::move(publisher));
+                }
+            }
+        }
+    }
+
+    double ComputeConfidence(const ARPEntry& arpEntry) const override
+    {
+        NameAndPublisher arpNameAndPublisher(
+            NormalizeAndPrepareName(arpEntry.Entry->GetLatestVersion()->GetProperty(PackageVersionProperty::Name).get()),
+            NormalizeAndPreparePublisher(arpEntry.Entry->GetLatestVersion()->GetProperty(PackageVersionProperty::Publisher).get()));
+
+        double bestMatchingScore = 0;
+        for (const auto& manifestNameAndPublisher : m_namesAndPublishers)
+        {
+            auto nameScore = EditDistanceScore(manifestNameAndPublisher.Name, arpNameAndPublisher.Name);
+            if (nameScore < 0.2)
+            {
+                continue;
+            }
+
+            auto publisherScore = EditDistanceScore(manifestNameAndPublisher.Publisher, arpNameAndPublisher.Publisher);
+            auto namePublisherScore = std::max(
+                EditDistanceScore(manifestNameAndPublisher.NamePublisher, arpNameAndPublisher.Name),
+                EditDistanceScore(manifestNameAndPublisher.Name, arpNameAndPublisher.NamePublisher));
+
+            auto score = std::max(nameScore * (2. / 3.) + publisherScore * (1 - 2. / 3.), namePublisherScore);
+            bestMatchingScore = std::max(bestMatchingScore, score);
+        }
+
+        return bestMatchingScore * 0.8 + (arpEntry.IsNewOrUpdated ? 1 : 0) * (1 - 0.8);
+    }
+
+private:
+    static double EditDistanceScore(const WordSequence& s1, const WordSequence& s2)
+    {
+        if (s1.empty() || s2.empty())
+        {
+            return 0;
+        }
+
+        // distance[i][j] = distance between s1[0:i] and s2[0:j], only adding and removing words
+        std::vector<std::vector<double>> distance(s1.size() + 1, std::vector<double>(s2.size() + 1));
+
+        for (size_t i = 0; i <= s1.size(); ++i)
+        {
+            for (size_t j = 0; j <= s2.size(); ++j)
+            {
+                if (i == 0 || j == 0)
+                {
+                    distance[i][j] = static_cast<double>(i + j);
+                }
+                else if (s1[i - 1] == s2[j - 1])
+                {
+                    distance[i][j] = distance[i - 1][j - 1];
+                }
+                else
+                {
+                    distance[i][j] = 1 + std::min(distance[i - 1][j], distance[i][j - 1]);
+                }
+            }
+        }
+
+        return 1 - distance[s1.size()][s2.size()] / (static_cast<uint64_t>(s1.size()) + static_cast<uint64_t>(s2.size()));
+    }
+
+    WordSequence NormalizeAndPrepareName(std::string_view name) const
+    {
+        return SplitIntoWords(FoldCase(m_normalizer.NormalizeName(name).Name()));
+    }
+
+    WordSequence NormalizeAndPreparePublisher(std::string_view publisher) const
+    {
+        return SplitIntoWords(FoldCase(m_normalizer.NormalizePublisher(publisher)));
+    }
+
+    NameNormalizer m_normalizer{ NormalizationVersion::InitialPreserveWhiteSpace };
+    std::vector<NameAndPublisher> m_namesAndPublishers;
+};
+
 void ReportMatch(std::string_view label, std::string_view appName, std::string_view appPublisher, std::string_view arpName, std::string_view arpPublisher)
 {
     WARN(label << '\n' <<
@@ -304,3 +413,68 @@ TEST_CASE("Correlation_ChosenHeuristicIsGood", "[correlation]")
     auto results = EvaluateDataSetWithHeuristic(dataSet, algorithm, /* reportErrors */ true);
     ReportAndEvaluateResults(results, dataSet);
 }
+
+TEST_CASE("Correlation_HeuristicMatchesReference", "[correlation]")
+{
+    auto testCases = LoadTestData();
+
+    std::vector<ARPEntry> arpEntries;
+    for (const auto& testCase : testCases)
+    {
+        arpEntries.push_back(GetARPEntryFromTestCase(testCase, /* isNew */ arpEntries.size() % 2 == 0));
+    }
+
+    WordsEditDistanceMatchConfidenceAlgorithm algorithm;
+    ReferenceWordsEditDistanceMatchConfidenceAlgorithm reference;
+
+    size_t differences = 0;
+    for (const auto& testCase : testCases)
+    {
+        auto manifest = GetManifestFromTestCase(testCase);
+        algorithm.Init(manifest);
+        reference.Init(manifest);
+
+        for (const auto& arpEntry : arpEntries)
+        {
+            if (algorithm.ComputeConfidence(arpEntry) != reference.ComputeConfidence(arpEntry))
+            {
+                ++differences;
+            }
+        }
+    }
+
+    REQUIRE(differences == 0);
+}
+
+TEMPLATE_TEST_CASE("Correlation_Benchmark", "[correlation][.][benchmark]",
+    ReferenceWordsEditDistanceMatchConfidenceAlgorithm,
+    WordsEditDistanceMatchConfidenceAlgorithm)
+{
+    auto testCases = LoadTestData();
+
+    // Create a large ARP set by mixing up the names and publishers of the test data
+    std::mt19937 random{ 1 };
+    std::vector<ARPEntry> arpEntries;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        TestCase testCase;
+        testCase.ARPName = testCases[random() % testCases.size()].ARPName + ' ' + testCases[random() % testCases.size()].AppName;
+        testCase.ARPPublisher = testCases[random() % testCases.size()].ARPPublisher;
+        arpEntries.push_back(GetARPEntryFromTestCase(testCase, /* isNew */ i % 1000 == 0));
+    }
+
+    TestType algorithm;
+
+    BENCHMARK("Correlate with large ARP set")
+    {
+        size_t matches = 0;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            if (FindARPEntryForNewlyInstalledPackageWithHeuristics(GetManifestFromTestCase(testCases[i]), arpEntries, algorithm).Package)
+            {
+                ++matches;
+            }
+        }
+        return matches;
+    };
+}
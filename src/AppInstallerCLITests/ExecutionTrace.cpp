@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <ExecutionContext.h>
+#include <ExecutionTrace.h>
+#include <Workflows/WorkflowBase.h>
+
+using namespace AppInstaller::CLI;
+using namespace AppInstaller::CLI::Execution;
+using namespace AppInstaller::CLI::Workflow;
+using namespace TestCommon;
+
+namespace
+{
+    void InnerTask(Context&) {}
+
+    struct OuterTask : public WorkflowTask
+    {
+        OuterTask() : WorkflowTask("OuterTask") {}
+
+        void operator()(Context& context) const override
+        {
+            context << InnerTask;
+
+            auto subContext = context.CreateSubContext();
+            SubContextId = subContext->GetId();
+            *subContext << InnerTask;
+        }
+
+        mutable uint32_t SubContextId = 0;
+    };
+
+    std::vector<TraceRecorder::Event> GetEventsForContexts(const TraceRecorder& recorder, std::initializer_list<uint32_t> contextIds)
+    {
+        std::vector<TraceRecorder::Event> result;
+        for (auto& event : recorder.GetEvents())
+        {
+            if (event.ContextId && std::find(contextIds.begin(), contextIds.end(), event.ContextId.value()) != contextIds.end())
+            {
+                result.emplace_back(std::move(event));
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("ExecutionTrace_RecordsWorkflowTasks", "[executionTrace]")
+{
+    std::ostringstream output;
+    Context context{ output, std::cin };
+
+    auto& recorder = TraceRecorder::Instance();
+    recorder.Enable(TraceRecorder::clock::now());
+    auto disableRecorder = wil::scope_exit([&]() { recorder.Disable(); });
+
+    OuterTask outerTask;
+    context << outerTask;
+
+    REQUIRE(outerTask.SubContextId != 0);
+    REQUIRE(outerTask.SubContextId != context.GetId());
+
+    // Events are recorded as the tasks complete, so the outer task is last.
+    auto events = GetEventsForContexts(recorder, { context.GetId(), outerTask.SubContextId });
+    REQUIRE(events.size() == 3);
+
+    std::string innerTaskName = WorkflowTask{ InnerTask }.GetTraceName();
+    REQUIRE(innerTaskName.find("Task+0x") == 0);
+
+    REQUIRE(events[0].Name == innerTaskName);
+    REQUIRE(events[0].ContextId == context.GetId());
+    REQUIRE(events[1].Name == innerTaskName);
+    REQUIRE(events[1].ContextId == outerTask.SubContextId);
+    REQUIRE(events[2].Name == "OuterTask");
+    REQUIRE(events[2].ContextId == context.GetId());
+
+    for (const auto& event : events)
+    {
+        REQUIRE(event.Category == "task");
+        REQUIRE(event.ThreadId == GetCurrentThreadId());
+        REQUIRE(event.Start <= event.End);
+        REQUIRE(event.Start >= events[2].Start);
+        REQUIRE(event.End <= events[2].End);
+    }
+}
+
+TEST_CASE("ExecutionTrace_DisabledRecordsNothing", "[executionTrace]")
+{
+    std::ostringstream output;
+    Context context{ output, std::cin };
+
+    auto& recorder = TraceRecorder::Instance();
+    REQUIRE(!recorder.IsEnabled());
+
+    context << InnerTask;
+
+    REQUIRE(GetEventsForContexts(recorder, { context.GetId() }).empty());
+}
+
+TEST_CASE("ExecutionTrace_WriteTraceFile", "[executionTrace]")
+{
+    TraceRecorder recorder;
+    auto origin = TraceRecorder::clock::now();
+    recorder.Enable(origin);
+
+    TraceRecorder::Event event;
+    event.Name = "Event";
+    event.Category = "task";
+    event.Start = origin + std::chrono::milliseconds(2);
+    event.End = origin + std::chrono::milliseconds(5);
+    event.ThreadId = 42;
+    event.ContextId = 7;
+    recorder.Add(std::move(event));
+
+    TempFile traceFile{ "ExecutionTrace", ".json" };
+    recorder.WriteTraceFile(traceFile);
+
+    Json::Value root;
+    std::ifstream stream{ traceFile.GetPath() };
+    stream >> root;
+
+    const Json::Value& events = root["traceEvents"];
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0]["name"].asString() == "Event");
+    REQUIRE(events[0]["cat"].asString() == "task");
+    REQUIRE(events[0]["ph"].asString() == "X");
+    REQUIRE(events[0]["ts"].asInt64() == 2000);
+    REQUIRE(events[0]["dur"].asInt64() == 3000);
+    REQUIRE(events[0]["tid"].asInt64() == 42);
+    REQUIRE(events[0]["args"]["context"].asUInt() == 7);
+}
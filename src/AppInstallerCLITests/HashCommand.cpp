@@ -20,4 +20,73 @@ TEST_CASE("HashCommandWithTestMsix", "[Sha256Hash]")
 
     REQUIRE(hashOutput.str().find("Sha256: 6a2d3683fa19bf00e58e07d1313d20a5f5735ebbd6a999d33381d28740ee07ea") != std::string::npos);
     REQUIRE(hashOutput.str().find("SignatureSha256: 138781c3e6f635240353f3d14d1d57bdcb89413e49be63b375e6a5d7b93b0d07") != std::string::npos);
-}
\ No newline at end of file
+}
+
+TEST_CASE("HashCommandWithMultipleInputs", "[Sha256Hash]")
+{
+    TempDirectory directory{ "HashCommand" };
+    std::filesystem::create_directories(directory.GetPath() / "nested");
+
+    std::vector<std::pair<std::filesystem::path, std::string>> files{
+        { directory.GetPath() / "first.txt", "first" },
+        { directory.GetPath() / "nested" / "second.txt", std::string(5 * 1024 * 1024, 'x') },
+    };
+
+    for (const auto& file : files)
+    {
+        std::ofstream stream{ file.first, std::ios::out | std::ios::binary | std::ios::trunc };
+        stream << file.second;
+    }
+
+    std::ostringstream hashOutput;
+    Execution::Context context{ hashOutput, std::cin };
+    context.Args.AddArg(Execution::Args::Type::HashFile, directory.GetPath().u8string());
+    context.Args.AddArg(Execution::Args::Type::HashFile, TestDataFile("TestSignedApp.msix").GetPath().u8string());
+    HashCommand hashCommand({});
+
+    hashCommand.Execute(context);
+
+    REQUIRE_FALSE(context.IsTerminated());
+    for (const auto& file : files)
+    {
+        REQUIRE(hashOutput.str().find(file.first.u8string()) != std::string::npos);
+        REQUIRE(hashOutput.str().find("InstallerSha256: " + AppInstaller::Utility::SHA256::ConvertToString(AppInstaller::Utility::SHA256::ComputeHash(file.second))) != std::string::npos);
+    }
+
+    REQUIRE(hashOutput.str().find("InstallerSha256: 6a2d3683fa19bf00e58e07d1313d20a5f5735ebbd6a999d33381d28740ee07ea") != std::string::npos);
+    REQUIRE(hashOutput.str().find("SignatureSha256") == std::string::npos);
+}
+
+TEST_CASE("HashCommandWithEmptyDirectory", "[Sha256Hash]")
+{
+    TempDirectory directory{ "HashCommand" };
+    std::filesystem::create_directories(directory.GetPath() / "empty");
+
+    std::ostringstream hashOutput;
+    Execution::Context context{ hashOutput, std::cin };
+    context.Args.AddArg(Execution::Args::Type::HashFile, directory.GetPath().u8string());
+    HashCommand hashCommand({});
+
+    hashCommand.Execute(context);
+
+    REQUIRE(context.IsTerminated());
+    REQUIRE(context.GetTerminationHR() == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+    REQUIRE(hashOutput.str().find(Resource::LocString(Resource::String::HashNoFilesFound).get()) != std::string::npos);
+}
+
+TEST_CASE("HashCommandWithMissingInput", "[Sha256Hash]")
+{
+    TempDirectory directory{ "HashCommand" };
+
+    std::ostringstream hashOutput;
+    Execution::Context context{ hashOutput, std::cin };
+    context.Args.AddArg(Execution::Args::Type::HashFile, TestDataFile("TestSignedApp.msix").GetPath().u8string());
+    context.Args.AddArg(Execution::Args::Type::HashFile, (directory.GetPath() / "missing.txt").u8string());
+    HashCommand hashCommand({});
+
+    hashCommand.Execute(context);
+
+    REQUIRE(context.IsTerminated());
+    REQUIRE(context.GetTerminationHR() == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND));
+    REQUIRE(hashOutput.str().find("InstallerSha256") == std::string::npos);
+}
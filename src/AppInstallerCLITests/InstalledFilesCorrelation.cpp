@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winget/InstalledFilesCorrelation.h>
+
+using namespace AppInstaller::Repository::Correlation;
+using namespace AppInstaller::Utility;
+using namespace TestCommon;
+
+namespace
+{
+    std::vector<std::filesystem::path> GetPaths(const std::vector<TempFile>& files)
+    {
+        std::vector<std::filesystem::path> result;
+        for (const auto& file : files)
+        {
+            result.emplace_back(file.GetPath());
+        }
+        return result;
+    }
+
+    std::vector<TempFile> CreateFiles(size_t count, size_t size)
+    {
+        std::vector<TempFile> result;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            result.emplace_back("InstalledFile", ".bin");
+            std::ofstream stream{ result.back().GetPath(), std::ios::out | std::ios::binary | std::ios::trunc };
+            stream << std::string(size, static_cast<char>('a' + i));
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("HashInstalledFiles_WithinBudget", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(20, 1000);
+    auto paths = GetPaths(files);
+
+    auto result = HashInstalledFiles(paths, {});
+
+    REQUIRE(result.Hashes.size() == paths.size());
+    REQUIRE(result.SkippedFileCount == 0);
+    REQUIRE(result.SkippedSize == 0);
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        REQUIRE(SHA256::AreEqual(result.Hashes[i], SHA256::ComputeHash(std::string(1000, static_cast<char>('a' + i)))));
+    }
+}
+
+TEST_CASE("HashInstalledFiles_FileCountBudget", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(10, 1000);
+    auto paths = GetPaths(files);
+
+    InstalledFilesHashingBudget budget;
+    budget.MaximumFileCount = 4;
+
+    auto result = HashInstalledFiles(paths, budget);
+
+    REQUIRE(result.Hashes.size() == paths.size());
+    REQUIRE(result.SkippedFileCount == 6);
+    REQUIRE(result.SkippedSize == 6000);
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        REQUIRE(result.Hashes[i].empty() == (i >= 4));
+    }
+}
+
+TEST_CASE("HashInstalledFiles_SizeBudget", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(10, 1000);
+    auto paths = GetPaths(files);
+
+    InstalledFilesHashingBudget budget;
+    budget.MaximumTotalSize = 2500;
+
+    auto result = HashInstalledFiles(paths, budget);
+
+    REQUIRE(result.SkippedFileCount == 8);
+    REQUIRE(result.SkippedSize == 8000);
+    REQUIRE(!result.Hashes[0].empty());
+    REQUIRE(!result.Hashes[1].empty());
+    REQUIRE(result.Hashes[2].empty());
+}
+
+TEST_CASE("HashInstalledFileTargets_SharedTarget", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(2, 1000);
+    std::vector<std::filesystem::path> targets{ files[0].GetPath(), files[1].GetPath(), files[0].GetPath() };
+
+    InstallationMetadata metadata;
+    metadata.InstalledFiles.Files.resize(targets.size());
+
+    // Each distinct file only counts once against the budget, so all of the entries fit.
+    InstalledFilesHashingBudget budget;
+    budget.MaximumFileCount = 2;
+
+    HashInstalledFileTargets(metadata, targets, budget);
+
+    REQUIRE(metadata.FilesNotHashed == 0);
+    REQUIRE(metadata.BytesNotHashed == 0);
+    REQUIRE(SHA256::AreEqual(metadata.InstalledFiles.Files[0].FileSha256, SHA256::ComputeHash(std::string(1000, 'a'))));
+    REQUIRE(SHA256::AreEqual(metadata.InstalledFiles.Files[1].FileSha256, SHA256::ComputeHash(std::string(1000, 'b'))));
+    REQUIRE(SHA256::AreEqual(metadata.InstalledFiles.Files[2].FileSha256, metadata.InstalledFiles.Files[0].FileSha256));
+}
+
+TEST_CASE("HashInstalledFileTargets_OverBudget", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(3, 1000);
+    std::vector<std::filesystem::path> targets{ files[0].GetPath(), files[1].GetPath(), files[0].GetPath(), files[2].GetPath() };
+
+    InstallationMetadata metadata;
+    metadata.InstalledFiles.Files.resize(targets.size());
+
+    InstalledFilesHashingBudget budget;
+    budget.MaximumFileCount = 2;
+
+    HashInstalledFileTargets(metadata, targets, budget);
+
+    REQUIRE(metadata.FilesNotHashed == 1);
+    REQUIRE(metadata.BytesNotHashed == 1000);
+    REQUIRE(!metadata.InstalledFiles.Files[0].FileSha256.empty());
+    REQUIRE(!metadata.InstalledFiles.Files[1].FileSha256.empty());
+    REQUIRE(!metadata.InstalledFiles.Files[2].FileSha256.empty());
+    REQUIRE(metadata.InstalledFiles.Files[3].FileSha256.empty());
+}
+
+TEST_CASE("HashInstalledFiles_MissingFile", "[installedFilesCorrelation]")
+{
+    auto files = CreateFiles(2, 1000);
+    std::vector<std::filesystem::path> paths{ files[0].GetPath(), files[0].GetPath().parent_path() / "DoesNotExist.bin", files[1].GetPath() };
+
+    auto result = HashInstalledFiles(paths, {});
+
+    REQUIRE(result.SkippedFileCount == 0);
+    REQUIRE(!result.Hashes[0].empty());
+    REQUIRE(result.Hashes[1].empty());
+    REQUIRE(!result.Hashes[2].empty());
+}
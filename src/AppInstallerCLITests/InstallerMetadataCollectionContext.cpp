@@ -59,6 +59,7 @@ namespace
         std::optional<std::string> InstallerHash;
         // Schema 1.0 only cares about DefaultLocale and Locales
         std::optional<Manifest::Manifest> PackageData;
+        std::optional<web::json::value> InstalledFilesHashing;
 
         std::wstring ToJSON()
         {
@@ -109,6 +110,11 @@ namespace
                 json[L"packageData"] = std::move(packageData);
             }
 
+            if (InstalledFilesHashing)
+            {
+                json[L"installedFilesHashing"] = InstalledFilesHashing.value();
+            }
+
             return json.serialize();
         }
 
@@ -249,7 +255,13 @@ namespace
 
         void StopFileWatcher() override {}
 
+        void SetHashingBudget(InstalledFilesHashingBudget budget) override
+        {
+            HashingBudget = budget;
+        }
+
         Correlation::InstallationMetadata InstallationMetadata;
+        std::optional<InstalledFilesHashingBudget> HashingBudget;
     };
 
     InstallerMetadataCollectionContext CreateTestContext(
@@ -368,6 +380,42 @@ TEST_CASE("MetadataCollection_MinimumInput", "[metadata_collection]")
     REQUIRE(output.InstallerHash.value() == input.InstallerHash.value());
 }
 
+TEST_CASE("MetadataCollection_InstalledFilesHashingBudget", "[metadata_collection]")
+{
+    TestInput input(MinimalDefaults);
+    auto installedFilesData = std::make_unique<TestInstalledFilesCorrelation>();
+    TestInstalledFilesCorrelation* installedFilesDataPtr = installedFilesData.get();
+
+    SECTION("Not given")
+    {
+        InstallerMetadataCollectionContext context = CreateTestContext(std::make_unique<TestARPCorrelationData>(), std::move(installedFilesData), input);
+        REQUIRE_FALSE(installedFilesDataPtr->HashingBudget);
+    }
+    SECTION("Partial")
+    {
+        web::json::value hashing;
+        hashing[L"maximumFileCount"] = web::json::value::number(12);
+        input.InstalledFilesHashing = hashing;
+
+        InstallerMetadataCollectionContext context = CreateTestContext(std::make_unique<TestARPCorrelationData>(), std::move(installedFilesData), input);
+        REQUIRE(installedFilesDataPtr->HashingBudget);
+        REQUIRE(installedFilesDataPtr->HashingBudget->MaximumFileCount == 12);
+        REQUIRE(installedFilesDataPtr->HashingBudget->MaximumTotalSize == InstalledFilesHashingBudget{}.MaximumTotalSize);
+    }
+    SECTION("Full")
+    {
+        web::json::value hashing;
+        hashing[L"maximumFileCount"] = web::json::value::number(3);
+        hashing[L"maximumTotalSize"] = web::json::value::number(static_cast<uint64_t>(1024));
+        input.InstalledFilesHashing = hashing;
+
+        InstallerMetadataCollectionContext context = CreateTestContext(std::make_unique<TestARPCorrelationData>(), std::move(installedFilesData), input);
+        REQUIRE(installedFilesDataPtr->HashingBudget);
+        REQUIRE(installedFilesDataPtr->HashingBudget->MaximumFileCount == 3);
+        REQUIRE(installedFilesDataPtr->HashingBudget->MaximumTotalSize == 1024);
+    }
+}
+
 TEST_CASE("MetadataCollection_SubmissionDataCopied", "[metadata_collection]")
 {
     TestInput input(MinimalDefaults);
@@ -1106,6 +1154,86 @@ TEST_CASE("MetadataCollection_SameSubmission_SameInstaller_InstallationMetadata_
     REQUIRE(entry.Icons[0].IconTheme == Manifest::IconThemeEnum::Light);
 }
 
+TEST_CASE("MetadataCollection_SameSubmission_SameInstaller_InstalledFilesHashingBudget", "[metadata_collection]")
+{
+    std::string version = "1.3.5";
+    std::string productCode = "{guid}";
+    Manifest::InstallerTypeEnum installerType = Manifest::InstallerTypeEnum::Msi;
+
+    TestInput input(MinimalDefaults, version, productCode, installerType);
+    input.SupportedMetadataVersion = "1.2";
+    input.CurrentMetadata->SchemaVersion = { "1.2" };
+
+    web::json::value hashing;
+    hashing[L"maximumFileCount"] = web::json::value::number(1);
+    input.InstalledFilesHashing = hashing;
+
+    // The first run hashed test.exe but not test.dll
+    Manifest::InstallationMetadataInfo installedFiles;
+    installedFiles.DefaultInstallLocation = "%TEMP%\\TestApp";
+    Manifest::InstalledFile installedFile;
+    installedFile.RelativeFilePath = "test.exe";
+    installedFile.FileSha256 = Utility::SHA256::ConvertToBytes("d2a45116709136462ee7a1c42f0e75f0efa258fe959b1504dc8ea4573451b759");
+    installedFile.FileType = Manifest::InstalledFileTypeEnum::Launch;
+    installedFiles.Files.emplace_back(installedFile);
+    installedFile.RelativeFilePath = "test.dll";
+    installedFile.FileSha256.clear();
+    installedFile.FileType = Manifest::InstalledFileTypeEnum::Other;
+    installedFiles.Files.emplace_back(installedFile);
+    input.CurrentMetadata->InstallerMetadataMap.begin()->second.InstalledFiles = std::move(installedFiles);
+
+    auto correlationData = std::make_unique<TestARPCorrelationData>();
+    auto installedFilesData = std::make_unique<TestInstalledFilesCorrelation>();
+
+    Manifest::Manifest manifest;
+    manifest.DefaultLocalization.Add<Manifest::Localization::PackageName>(input.CurrentMetadata->InstallerMetadataMap.begin()->second.AppsAndFeaturesEntries[0].DisplayName);
+    manifest.DefaultLocalization.Add<Manifest::Localization::Publisher>(input.CurrentMetadata->InstallerMetadataMap.begin()->second.AppsAndFeaturesEntries[0].Publisher);
+    manifest.Version = version;
+    manifest.Installers.push_back({});
+    manifest.Installers[0].ProductCode = productCode;
+
+    IPackageVersion::Metadata metadata;
+    metadata[PackageVersionMetadata::InstalledType] = Manifest::InstallerTypeToString(installerType);
+
+    correlationData->CorrelateForNewlyInstalledResult.Package = std::make_shared<TestPackageVersion>(manifest, metadata);
+
+    // The budget limited second run hashed test.dll but not test.exe
+    Correlation::InstallationMetadata newInstalledFiles;
+    newInstalledFiles.InstalledFiles.DefaultInstallLocation = "%TEMP%\\TestApp";
+    Manifest::InstalledFile newInstalledFile;
+    newInstalledFile.RelativeFilePath = "test.exe";
+    newInstalledFile.FileType = Manifest::InstalledFileTypeEnum::Launch;
+    newInstalledFiles.InstalledFiles.Files.emplace_back(newInstalledFile);
+    newInstalledFile.RelativeFilePath = "test.dll";
+    newInstalledFile.FileSha256 = Utility::SHA256::ConvertToBytes("011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6");
+    newInstalledFile.FileType = Manifest::InstalledFileTypeEnum::Other;
+    newInstalledFiles.InstalledFiles.Files.emplace_back(newInstalledFile);
+
+    installedFilesData->InstallationMetadata = std::move(newInstalledFiles);
+    TestInstalledFilesCorrelation* installedFilesDataPtr = installedFilesData.get();
+
+    InstallerMetadataCollectionContext context = CreateTestContext(std::move(correlationData), std::move(installedFilesData), input);
+    REQUIRE(installedFilesDataPtr->HashingBudget);
+    REQUIRE(installedFilesDataPtr->HashingBudget->MaximumFileCount == 1);
+
+    TestOutput output = GetOutput(context);
+
+    REQUIRE(output.IsSuccess());
+    output.ValidateFieldPresence();
+
+    REQUIRE(output.Metadata->InstallerMetadataMap.size() == 1);
+    REQUIRE(output.Metadata->InstallerMetadataMap.count(input.InstallerHash.value()) == 1);
+    const auto& entry = output.Metadata->InstallerMetadataMap[input.InstallerHash.value()];
+
+    // Files that were not hashed do not conflict with known hashes
+    REQUIRE(entry.InstalledFiles.has_value());
+    REQUIRE(entry.InstalledFiles->Files.size() == 2);
+    REQUIRE(entry.InstalledFiles->Files[0].RelativeFilePath == "test.exe");
+    REQUIRE(entry.InstalledFiles->Files[0].FileSha256 == Utility::SHA256::ConvertToBytes("d2a45116709136462ee7a1c42f0e75f0efa258fe959b1504dc8ea4573451b759"));
+    REQUIRE(entry.InstalledFiles->Files[1].RelativeFilePath == "test.dll");
+    REQUIRE(entry.InstalledFiles->Files[1].FileSha256 == Utility::SHA256::ConvertToBytes("011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6"));
+}
+
 TEST_CASE("MetadataCollection_Merge_SameInstaller_InstalledFiles", "[metadata_collection]")
 {
     TestMerge mergeData{ MinimalDefaults };
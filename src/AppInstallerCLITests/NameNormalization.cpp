@@ -153,4 +153,66 @@ TEST_CASE("NameNorm_GetNormalizedName_GetNormalizedFields", "[name_norm]")
     REQUIRE(normalizedName2.GetNormalizedName(NormalizationField::None) == "Name");
     REQUIRE(normalizedName2.GetNormalizedName(NormalizationField::Architecture) == "Name");
     REQUIRE(normalizedName2.GetNormalizedFields() == NormalizationField::None);
+}
+
+TEST_CASE("NameNorm_Cache", "[name_norm]")
+{
+    // A unique name, so that it has not been cached by other tests
+    std::string name = "Cached Name " + ConvertToUTF8(CreateNewGuidNameWString());
+
+    NameNormalizer normer(NormalizationVersion::Initial);
+
+    NameNormalizationCacheStatistics before = NameNormalizer::GetCacheStatistics();
+    NormalizedName first = normer.NormalizeName(name);
+    NameNormalizationCacheStatistics afterFirst = NameNormalizer::GetCacheStatistics();
+
+    REQUIRE(afterFirst.Misses == before.Misses + 1);
+    REQUIRE(afterFirst.Hits == before.Hits);
+
+    // Another normalizer of the same version uses the cached result
+    NameNormalizer otherNormer(NormalizationVersion::Initial);
+    NormalizedName second = otherNormer.NormalizeName(name);
+    NameNormalizationCacheStatistics afterSecond = NameNormalizer::GetCacheStatistics();
+
+    REQUIRE(second.Name() == first.Name());
+    REQUIRE(second.Architecture() == first.Architecture());
+    REQUIRE(afterSecond.Misses == afterFirst.Misses);
+    REQUIRE(afterSecond.Hits == afterFirst.Hits + 1);
+
+    // Other versions and operations are cached separately
+    NameNormalizer preserveWhiteSpaceNormer(NormalizationVersion::InitialPreserveWhiteSpace);
+    REQUIRE(preserveWhiteSpaceNormer.NormalizeName(name).Name() != first.Name());
+    REQUIRE(normer.NormalizePublisher(name) == normer.NormalizePublisher(name));
+
+    NameNormalizationCacheStatistics afterOthers = NameNormalizer::GetCacheStatistics();
+    REQUIRE(afterOthers.Misses == afterSecond.Misses + 2);
+    REQUIRE(afterOthers.Hits == afterSecond.Hits + 1);
+}
+
+TEST_CASE("NameNorm_Benchmark", "[name_norm][.][benchmark]")
+{
+    std::ifstream namesStream(TestCommon::TestDataFile("InputNames.txt").GetPath());
+    REQUIRE(namesStream);
+    std::ifstream publishersStream(TestCommon::TestDataFile("InputPublishers.txt").GetPath());
+    REQUIRE(publishersStream);
+
+    std::vector<std::pair<std::string, std::string>> inputs;
+    std::string name;
+    std::string publisher;
+    while (std::getline(namesStream, name) && std::getline(publishersStream, publisher))
+    {
+        inputs.emplace_back(std::move(name), std::move(publisher));
+    }
+
+    NameNormalizer normer(NormalizationVersion::Initial);
+
+    BENCHMARK("Normalize corpus")
+    {
+        size_t result = 0;
+        for (const auto& input : inputs)
+        {
+            result += normer.Normalize(input.first, input.second).Name().size();
+        }
+        return result;
+    };
 }
\ No newline at end of file
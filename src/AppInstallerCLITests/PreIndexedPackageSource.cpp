@@ -4,11 +4,15 @@
 #include "TestSource.h"
 #include "TestCommon.h"
 #include "TestSettings.h"
+#include "TestHooks.h"
 #include <winget/RepositorySource.h>
 #include <AppInstallerRuntime.h>
 #include <AppInstallerStrings.h>
 #include <Microsoft/PreIndexedPackageSourceFactory.h>
+#include <Microsoft/SQLiteIndexChangeset.h>
+#include <AppInstallerMsixInfo.h>
 #include <winget/Settings.h>
+#include <winget/SQLiteWrapper.h>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -54,6 +58,42 @@ std::string GetContents(const fs::path& file)
     return ReadEntireStream(stream);
 }
 
+// Places the package where the source looks for the delta from the given version.
+void CopyDeltaFileToDirectory(const fs::path& from, const fs::path& to, std::string_view fromVersion)
+{
+    fs::path toFile = to / "source.delta";
+    fs::create_directories(toFile);
+    toFile /= std::string{ fromVersion } + ".msix";
+    fs::copy_file(from, toFile, fs::copy_options::overwrite_existing);
+}
+
+void ExtractIndex(const fs::path& package, const fs::path& indexPath)
+{
+    wil::unique_hfile file{ CreateFileW(indexPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    THROW_LAST_ERROR_IF(!file);
+
+    ProgressCallback progress;
+    Msix::MsixInfo packageInfo{ package };
+    packageInfo.WriteToFileHandle("Public\\index.db", file.get(), progress);
+}
+
+// Creates the changeset that moves the index in the base package to the one in the target package.
+void CreateChangeset(const fs::path& basePackage, const fs::path& targetPackage, const fs::path& changesetPath)
+{
+    TempFile baseIndex("pipsbase", ".db");
+    TempFile targetIndex("pipstarget", ".db");
+    ExtractIndex(basePackage, baseIndex);
+    ExtractIndex(targetPackage, targetIndex);
+
+    AppInstaller::Repository::Microsoft::SQLiteIndexChangeset::Create(baseIndex, targetIndex, changesetPath);
+}
+
+SHA256::HashBuffer GetIndexContentHash(const fs::path& indexPath)
+{
+    SQLite::Connection connection = SQLite::Connection::Create(indexPath.u8string(), SQLite::Connection::OpenDisposition::ReadOnly);
+    return AppInstaller::Repository::Microsoft::SQLiteIndexChangeset::ComputeContentHash(connection);
+}
+
 void CleanSources()
 {
     RemoveSetting(Stream::UserSources);
@@ -226,3 +266,160 @@ TEST_CASE("PIPS_Remove", "[pips]")
         UninstallCertFromSignedPackage(index);
     }
 }
+
+TEST_CASE("PIPS_UpdateWithDelta", "[pips]")
+{
+    if (!Runtime::IsRunningAsAdmin())
+    {
+        WARN("Test requires admin privilege. Skipped.");
+        return;
+    }
+
+    CleanSources();
+
+    TempDirectory dir("pipssource");
+    TestDataFile indexMsix1(s_MsixFile_1);
+    TestDataFile indexMsix2(s_MsixFile_2);
+    CopyIndexFileToDirectory(indexMsix1, dir);
+
+    bool shouldCleanCert = InstallCertFromSignedPackage(indexMsix1);
+
+    SourceDetails details;
+    details.Name = "TestName";
+    details.Type = AppInstaller::Repository::Microsoft::PreIndexedPackageSourceFactory::Type();
+    details.Arg = dir;
+    TestProgress callback;
+
+    AddSource(details, callback);
+
+    fs::path state = GetPathToFileDir();
+    std::string indexContents1 = GetContents(state / s_IndexMsixName);
+
+    TempFile changeset("pipschangeset", ".db");
+    CreateChangeset(indexMsix1, indexMsix2, changeset);
+    TestHook::SetDeltaChangeset_Override changesetOverride(changeset);
+
+    CopyIndexFileToDirectory(indexMsix2, dir);
+    CopyDeltaFileToDirectory(indexMsix2, dir, "1.0.0.0");
+
+    UpdateSource(details.Name, callback);
+
+    // The delta is kept beside the original package, which is not replaced.
+    REQUIRE(fs::exists(state / "delta" / "1.msix"));
+    REQUIRE(GetContents(state / s_IndexMsixName) == indexContents1);
+
+    // The index with the delta applied is kept, so that opening the source does not apply it again.
+    TempFile targetIndex("pipstarget", ".db");
+    ExtractIndex(indexMsix2, targetIndex);
+    REQUIRE(GetIndexContentHash(state / "delta" / "index.db") == GetIndexContentHash(targetIndex));
+
+    Source source{ details.Name };
+    REQUIRE_NOTHROW(source.Open(callback));
+
+    // The data is now at the version of the delta, so there is nothing more to update.
+    bool progressCalled = false;
+    callback.m_OnProgress = [&](uint64_t, uint64_t, ProgressType) { progressCalled = true; };
+
+    UpdateSource(details.Name, callback);
+    REQUIRE(!progressCalled);
+
+    if (shouldCleanCert)
+    {
+        UninstallCertFromSignedPackage(indexMsix1);
+    }
+}
+
+TEST_CASE("PIPS_UpdateWithDelta_ApplyFailure", "[pips]")
+{
+    if (!Runtime::IsRunningAsAdmin())
+    {
+        WARN("Test requires admin privilege. Skipped.");
+        return;
+    }
+
+    CleanSources();
+
+    TempDirectory dir("pipssource");
+    TestDataFile indexMsix1(s_MsixFile_1);
+    TestDataFile indexMsix2(s_MsixFile_2);
+    CopyIndexFileToDirectory(indexMsix1, dir);
+
+    bool shouldCleanCert = InstallCertFromSignedPackage(indexMsix1);
+
+    SourceDetails details;
+    details.Name = "TestName";
+    details.Type = AppInstaller::Repository::Microsoft::PreIndexedPackageSourceFactory::Type();
+    details.Arg = dir;
+    TestProgress callback;
+
+    AddSource(details, callback);
+
+    // The delta passes trust validation, but does not contain a changeset.
+    CopyIndexFileToDirectory(indexMsix2, dir);
+    CopyDeltaFileToDirectory(indexMsix2, dir, "1.0.0.0");
+
+    UpdateSource(details.Name, callback);
+
+    // The full package is downloaded instead.
+    fs::path state = GetPathToFileDir();
+    REQUIRE_FALSE(fs::exists(state / "delta" / "1.msix"));
+    REQUIRE(GetContents(state / s_IndexMsixName) == GetContents(indexMsix2));
+
+    if (shouldCleanCert)
+    {
+        UninstallCertFromSignedPackage(indexMsix1);
+    }
+}
+
+TEST_CASE("PIPS_UpdateWithDelta_ChainLimit", "[pips]")
+{
+    if (!Runtime::IsRunningAsAdmin())
+    {
+        WARN("Test requires admin privilege. Skipped.");
+        return;
+    }
+
+    CleanSources();
+
+    TempDirectory dir("pipssource");
+    TestDataFile indexMsix1(s_MsixFile_1);
+    TestDataFile indexMsix2(s_MsixFile_2);
+    CopyIndexFileToDirectory(indexMsix1, dir);
+
+    bool shouldCleanCert = InstallCertFromSignedPackage(indexMsix1);
+
+    SourceDetails details;
+    details.Name = "TestName";
+    details.Type = AppInstaller::Repository::Microsoft::PreIndexedPackageSourceFactory::Type();
+    details.Arg = dir;
+    TestProgress callback;
+
+    AddSource(details, callback);
+
+    // Fill the chain with deltas that leave the data at the original version, and are never opened.
+    fs::path state = GetPathToFileDir();
+    fs::create_directories(state / "delta");
+    for (int i = 1; i <= 8; ++i)
+    {
+        fs::copy_file(indexMsix1, state / "delta" / (std::to_string(i) + ".msix"));
+    }
+
+    // The delta would apply, so only the chain length prevents its use.
+    TempFile changeset("pipschangeset", ".db");
+    CreateChangeset(indexMsix1, indexMsix2, changeset);
+    TestHook::SetDeltaChangeset_Override changesetOverride(changeset);
+
+    CopyIndexFileToDirectory(indexMsix2, dir);
+    CopyDeltaFileToDirectory(indexMsix2, dir, "1.0.0.0");
+
+    UpdateSource(details.Name, callback);
+
+    // The full package replaces the package and its chain.
+    REQUIRE_FALSE(fs::exists(state / "delta"));
+    REQUIRE(GetContents(state / s_IndexMsixName) == GetContents(indexMsix2));
+
+    if (shouldCleanCert)
+    {
+        UninstallCertFromSignedPackage(indexMsix1);
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerSHA256.h>
+
+using namespace AppInstaller::Utility;
+using namespace TestCommon;
+
+namespace
+{
+    std::string CreateRandomData(size_t size, uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::string result(size, '\0');
+        for (auto& c : result)
+        {
+            c = static_cast<char>(random());
+        }
+        return result;
+    }
+
+    SHA256::HashBuffer ComputeWithBackend(SHA256::Backend backend, std::string_view data, size_t chunkSize)
+    {
+        SHA256 hasher{ backend };
+        for (size_t position = 0; position < data.size(); position += chunkSize)
+        {
+            size_t count = std::min(chunkSize, data.size() - position);
+            hasher.Add(reinterpret_cast<const uint8_t*>(data.data() + position), count);
+        }
+        return hasher.Get();
+    }
+}
+
+TEST_CASE("SHA256_KnownValues", "[sha256]")
+{
+    auto backend = GENERATE(SHA256::Backend::BCrypt, SHA256::Backend::Portable);
+
+    REQUIRE(SHA256::ConvertToString(ComputeWithBackend(backend, "", 1)) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    REQUIRE(SHA256::ConvertToString(ComputeWithBackend(backend, "abc", 1)) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    REQUIRE(SHA256::ConvertToString(ComputeWithBackend(backend, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 7)) ==
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    REQUIRE(SHA256::ConvertToString(ComputeWithBackend(backend, std::string(1000000, 'a'), 4096)) ==
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST_CASE("SHA256_BackendsMatch", "[sha256]")
+{
+    // Cover every length around the block and padding boundaries, and data added in uneven chunks.
+    for (size_t size = 0; size < 300; ++size)
+    {
+        std::string data = CreateRandomData(size, static_cast<uint32_t>(size));
+        auto expected = ComputeWithBackend(SHA256::Backend::BCrypt, data, 1024);
+
+        REQUIRE(SHA256::AreEqual(expected, ComputeWithBackend(SHA256::Backend::Portable, data, 1024)));
+        REQUIRE(SHA256::AreEqual(expected, ComputeWithBackend(SHA256::Backend::Portable, data, 13)));
+    }
+}
+
+TEST_CASE("SHA256_ComputeHashes", "[sha256]")
+{
+    std::vector<std::string> data;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        data.emplace_back(CreateRandomData(i * 97, i));
+    }
+
+    std::vector<std::string_view> buffers{ data.begin(), data.end() };
+    auto hashes = SHA256::ComputeHashes(buffers);
+
+    REQUIRE(hashes.size() == data.size());
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        REQUIRE(SHA256::AreEqual(hashes[i], SHA256::ComputeHash(data[i])));
+    }
+}
+
+TEST_CASE("SHA256_ComputeHashesFromFiles", "[sha256]")
+{
+    std::vector<TempFile> files;
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::string> data;
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        data.emplace_back(CreateRandomData(i * 10000, i));
+        files.emplace_back("SHA256", ".bin");
+        paths.emplace_back(files.back().GetPath());
+
+        std::ofstream stream{ paths.back(), std::ios::out | std::ios::binary | std::ios::trunc };
+        stream.write(data.back().data(), data.back().size());
+    }
+
+    auto hashes = SHA256::ComputeHashesFromFiles(paths);
+
+    REQUIRE(hashes.size() == paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        REQUIRE(SHA256::AreEqual(hashes[i], SHA256::ComputeHash(data[i])));
+    }
+
+    paths.emplace_back(files.front().GetPath().parent_path() / "DoesNotExist.bin");
+    REQUIRE_THROWS(SHA256::ComputeHashesFromFiles(paths));
+}
+
+TEST_CASE("SHA256_Benchmark", "[sha256][.][benchmark]")
+{
+    std::string large = CreateRandomData(64 * 1024 * 1024, 1);
+
+    std::vector<std::string> small;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        small.emplace_back(CreateRandomData(2048, i));
+    }
+    std::vector<std::string_view> smallBuffers{ small.begin(), small.end() };
+
+    BENCHMARK("Large, BCrypt")
+    {
+        return ComputeWithBackend(SHA256::Backend::BCrypt, large, large.size());
+    };
+
+    BENCHMARK("Large, portable")
+    {
+        return ComputeWithBackend(SHA256::Backend::Portable, large, large.size());
+    };
+
+    BENCHMARK("Small, BCrypt")
+    {
+        size_t result = 0;
+        for (const auto& buffer : small)
+        {
+            result += ComputeWithBackend(SHA256::Backend::BCrypt, buffer, buffer.size())[0];
+        }
+        return result;
+    };
+
+    BENCHMARK("Small, portable")
+    {
+        size_t result = 0;
+        for (const auto& buffer : small)
+        {
+            result += ComputeWithBackend(SHA256::Backend::Portable, buffer, buffer.size())[0];
+        }
+        return result;
+    };
+
+    BENCHMARK("Small, multi-buffer")
+    {
+        return SHA256::ComputeHashes(smallBuffers);
+    };
+}
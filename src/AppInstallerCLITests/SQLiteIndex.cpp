@@ -2,10 +2,12 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "TestCommon.h"
+#include "SyntheticData.h"
 #include <winget/SQLiteWrapper.h>
 #include <PackageDependenciesValidation.h>
 #include <ArpVersionValidation.h>
 #include <Microsoft/SQLiteIndex.h>
+#include <Microsoft/SQLiteIndexChangeset.h>
 #include <winget/Manifest.h>
 #include <AppInstallerStrings.h>
 #include <winget/SQLiteMetadataTable.h>
@@ -24,6 +26,7 @@
 #include <Microsoft/Schema/1_4/DependenciesTable.h>
 #include <Microsoft/Schema/2_0/Interface.h>
 #include <Microsoft/Schema/2_0/PackageUpdateTrackingTable.h>
+#include <Microsoft/Schema/FuzzyMatcher.h>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -466,6 +469,91 @@ TEST_CASE("SQLiteIndexCreateAndAddManifestFile", "[sqliteindex]")
     index.AddManifest(manifestFile, manifestPath);
 }
 
+TEST_CASE("SQLiteIndex_AddManifests_MatchesSerial", "[sqliteindex]")
+{
+    TempFile serialFile{ "repolibtest_tempdb"s, ".db"s };
+    TempFile bulkFile{ "repolibtest_tempdb"s, ".db"s };
+    INFO("Using temporary files named: " << serialFile.GetPath() << " and " << bulkFile.GetPath());
+
+    std::vector<std::pair<std::string, std::string>> files =
+    {
+        { "Manifest-Good.yaml", "microsoft/msixsdk/microsoft.msixsdk-1.7.32.yaml" },
+        { "Manifest-Good-Minimum.yaml", "microsoft/msixsdk/microsoft.msixsdk-1.07.32-beta.yaml" },
+        { "Manifest-Good-MsixInstaller.yaml", "appinstallerclitest/goodmsixinstaller/1.yaml" },
+        { "Manifest-Good-MultiLocale.yaml", "appinstallerclitest/multilocaletest/1.0.0.0.yaml" },
+        { "Manifest-Good-SystemReferenceComplex.yaml", "microsoft/sysrefcomp/1.7.32.yaml" },
+    };
+
+    SQLiteVersion version = GENERATE(SQLiteVersion{ 1, 7 }, SQLiteVersion{ 2, 0 });
+    size_t maxConcurrency = GENERATE(size_t{ 1 }, size_t{ 4 });
+
+    SQLiteIndex serialIndex = SQLiteIndex::CreateNew(serialFile, version);
+    SQLiteIndex bulkIndex = SQLiteIndex::CreateNew(bulkFile, version);
+
+    std::vector<SQLiteIndex::IdType> serialIds;
+    std::vector<SQLiteIndex::ManifestFile> manifests;
+
+    for (const auto& file : files)
+    {
+        TestDataFile manifestFile{ file.first };
+        serialIds.emplace_back(serialIndex.AddManifest(manifestFile, file.second));
+        manifests.emplace_back(SQLiteIndex::ManifestFile{ manifestFile.GetPath(), file.second });
+    }
+
+    std::vector<SQLiteIndex::IdType> bulkIds = bulkIndex.AddManifests(manifests, maxConcurrency);
+    REQUIRE(serialIds == bulkIds);
+    REQUIRE(bulkIndex.CheckConsistency(true));
+
+    auto serialResults = serialIndex.Search({});
+    auto bulkResults = bulkIndex.Search({});
+    REQUIRE(serialResults.Matches.size() == bulkResults.Matches.size());
+
+    for (size_t i = 0; i < serialResults.Matches.size(); ++i)
+    {
+        REQUIRE(serialResults.Matches[i].first == bulkResults.Matches[i].first);
+        REQUIRE(serialIndex.GetPropertyByPrimaryId(serialResults.Matches[i].first, PackageVersionProperty::Id) ==
+            bulkIndex.GetPropertyByPrimaryId(bulkResults.Matches[i].first, PackageVersionProperty::Id));
+    }
+}
+
+TEST_CASE("SQLiteIndex_AddManifests_FailureAddsNothing", "[sqliteindex]")
+{
+    TempFile tempFile{ "repolibtest_tempdb"s, ".db"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    SQLiteIndex index = CreateTestIndex(tempFile);
+
+    TestDataFile goodFile{ "Manifest-Good.yaml" };
+    TestDataFile badFile{ "Manifest-Bad-ArchInvalid.yaml" };
+
+    std::vector<SQLiteIndex::ManifestFile> manifests =
+    {
+        { goodFile.GetPath(), "microsoft/msixsdk/microsoft.msixsdk-1.7.32.yaml" },
+        { badFile.GetPath(), "bad/bad.yaml" },
+    };
+
+    REQUIRE_THROWS(index.AddManifests(manifests));
+    REQUIRE(index.Search({}).Matches.empty());
+
+    // The last manifest parses, but fails to insert as it is already present; those inserted before it are rolled back.
+    TestDataFile msixFile{ "Manifest-Good-MsixInstaller.yaml" };
+
+    manifests =
+    {
+        { goodFile.GetPath(), "microsoft/msixsdk/microsoft.msixsdk-1.7.32.yaml" },
+        { msixFile.GetPath(), "appinstallerclitest/goodmsixinstaller/1.yaml" },
+        { goodFile.GetPath(), "microsoft/msixsdk/duplicate.yaml" },
+    };
+
+    REQUIRE_THROWS_HR(index.AddManifests(manifests), HRESULT_FROM_WIN32(ERROR_ALREADY_EXISTS));
+    REQUIRE(index.Search({}).Matches.empty());
+
+    // The index is still usable afterward.
+    manifests.pop_back();
+    REQUIRE(index.AddManifests(manifests).size() == 2);
+    REQUIRE(index.Search({}).Matches.size() == 2);
+}
+
 TEST_CASE("SQLiteIndexCreateAndAddManifestDuplicate", "[sqliteindex]")
 {
     TempFile tempFile{ "repolibtest_tempdb"s, ".db"s };
@@ -3798,6 +3886,193 @@ TEST_CASE("SQLiteIndex_V2_0_UsageFlow_Complex", "[sqliteindex][V2_0]")
     PrepareAndCheckIntermediates(baseFile, preparedFile, { { manifest2 }, { manifest1, manifest3, manifest4 } }, 0s);
 }
 
+void PrepareForPackagingCopy(const std::filesystem::path& baseFile, const std::filesystem::path& preparedFile, const std::optional<std::filesystem::path>& previousPackagedFile = {})
+{
+    TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
+    INFO("Intermediates directory: " << intermediatesDirectory.GetPath());
+
+    std::filesystem::copy_file(baseFile, preparedFile, std::filesystem::copy_options::overwrite_existing);
+
+    SQLiteIndex index = SQLiteIndex::Open(preparedFile.u8string(), SQLiteStorageBase::OpenDisposition::ReadWrite);
+    index.SetProperty(SQLiteIndex::Property::IntermediateFileOutputPath, intermediatesDirectory);
+    if (previousPackagedFile)
+    {
+        index.SetProperty(SQLiteIndex::Property::PreviousPackagedIndexPath, previousPackagedFile->u8string());
+    }
+    index.PrepareForPackaging();
+}
+
+size_t CountMatches(const SQLiteIndex& index, PackageMatchField field, std::string_view value)
+{
+    SearchRequest request;
+    request.Inclusions.emplace_back(field, MatchType::Exact, value);
+    return index.Search(request).Matches.size();
+}
+
+TEST_CASE("SQLiteIndex_V2_0_IncrementalPackaging", "[sqliteindex][V2_0]")
+{
+    TempFile baseFile{ "v2_0_index_tempdb"s, ".db"s };
+    TempFile previousFile{ "v2_0_index_previous_tempdb"s, ".db"s };
+    TempFile incrementalFile{ "v2_0_index_incremental_tempdb"s, ".db"s };
+    TempFile fullFile{ "v2_0_index_full_tempdb"s, ".db"s };
+    INFO("Using files named: [" << baseFile.GetPath() << "], [" << previousFile.GetPath() << "], [" << incrementalFile.GetPath() << "] and [" << fullFile.GetPath() << "]");
+
+    std::ignore = SQLiteIndex::CreateNew(baseFile, SQLiteVersion{ 2, 0 });
+
+    ManifestAndPath manifest1;
+    CreateFakeManifestAndPath(manifest1, "Publisher1", "1.0");
+    ManifestAndPath manifest2;
+    CreateFakeManifestAndPath(manifest2, "Publisher2", "1.0");
+    manifest2.Manifest.DefaultLocalization.Add<Localization::Tags>({ "t1", "removed" });
+
+    {
+        SQLiteIndex index = SQLiteIndex::Open(baseFile, SQLiteStorageBase::OpenDisposition::ReadWrite);
+        index.SetProperty(SQLiteIndex::Property::PackageUpdateTrackingBaseTime, "");
+        index.AddManifest(manifest1.Manifest, manifest1.Path);
+        index.AddManifest(manifest2.Manifest, manifest2.Path);
+    }
+
+    PrepareForPackagingCopy(baseFile, previousFile);
+
+    // Add a version to an existing package, remove a package, and add a new package
+    ManifestAndPath manifest3;
+    CreateFakeManifestAndPath(manifest3, "Publisher1", "2.0");
+    ManifestAndPath manifest4;
+    CreateFakeManifestAndPath(manifest4, "Publisher3", "1.0");
+    manifest4.Manifest.DefaultLocalization.Add<Localization::Tags>({ "t1", "added" });
+
+    {
+        SQLiteIndex index = SQLiteIndex::Open(baseFile, SQLiteStorageBase::OpenDisposition::ReadWrite);
+        index.SetProperty(SQLiteIndex::Property::PackageUpdateTrackingBaseTime, "");
+        index.AddManifest(manifest3.Manifest, manifest3.Path);
+        index.RemoveManifest(manifest2.Manifest);
+        index.AddManifest(manifest4.Manifest, manifest4.Path);
+    }
+
+    PrepareForPackagingCopy(baseFile, incrementalFile, previousFile.GetPath());
+    PrepareForPackagingCopy(baseFile, fullFile);
+
+    SQLiteIndex incremental = SQLiteIndex::Open(incrementalFile.GetPath().u8string(), SQLiteStorageBase::OpenDisposition::Read);
+    SQLiteIndex full = SQLiteIndex::Open(fullFile.GetPath().u8string(), SQLiteStorageBase::OpenDisposition::Read);
+
+    REQUIRE(incremental.CheckConsistency(true));
+
+    REQUIRE(incremental.Search({}).Matches.size() == 2);
+    REQUIRE(full.Search({}).Matches.size() == 2);
+
+    for (const auto& [field, value] : std::vector<std::pair<PackageMatchField, std::string_view>>{
+        { PackageMatchField::Id, "Publisher1.Id" },
+        { PackageMatchField::Id, "Publisher2.Id" },
+        { PackageMatchField::Id, "Publisher3.Id" },
+        { PackageMatchField::Tag, "t1" },
+        { PackageMatchField::Tag, "removed" },
+        { PackageMatchField::Tag, "added" },
+        { PackageMatchField::Command, "test1" },
+        })
+    {
+        INFO(value);
+        REQUIRE(CountMatches(incremental, field, value) == CountMatches(full, field, value));
+    }
+
+    REQUIRE(CountMatches(incremental, PackageMatchField::Id, "Publisher2.Id") == 0);
+    REQUIRE(CountMatches(incremental, PackageMatchField::Tag, "t1") == 2);
+}
+
+TEST_CASE("SQLiteIndex_V2_0_IncrementalPackaging_MissingPreviousIsFull", "[sqliteindex][V2_0]")
+{
+    TempFile baseFile{ "v2_0_index_tempdb"s, ".db"s };
+    TempFile preparedFile{ "v2_0_index_prepared_tempdb"s, ".db"s };
+    TempFile missingFile{ "v2_0_index_missing_tempdb"s, ".db"s };
+    INFO("Using files named: [" << baseFile.GetPath() << "] and [" << preparedFile.GetPath() << "]");
+
+    std::ignore = SQLiteIndex::CreateNew(baseFile, SQLiteVersion{ 2, 0 });
+
+    ManifestAndPath manifest1;
+    CreateFakeManifestAndPath(manifest1, "Publisher1", "1.0");
+
+    {
+        SQLiteIndex index = SQLiteIndex::Open(baseFile, SQLiteStorageBase::OpenDisposition::ReadWrite);
+        index.SetProperty(SQLiteIndex::Property::PackageUpdateTrackingBaseTime, "");
+        index.AddManifest(manifest1.Manifest, manifest1.Path);
+    }
+
+    PrepareForPackagingCopy(baseFile, preparedFile, missingFile.GetPath());
+
+    SQLiteIndex index = SQLiteIndex::Open(preparedFile.GetPath().u8string(), SQLiteStorageBase::OpenDisposition::Read);
+    REQUIRE(index.Search({}).Matches.size() == 1);
+}
+
+SHA256::HashBuffer ComputeIndexContentHash(const std::filesystem::path& indexFile)
+{
+    SQLite::Connection connection = SQLite::Connection::Create(indexFile.u8string(), SQLite::Connection::OpenDisposition::ReadOnly);
+    return SQLiteIndexChangeset::ComputeContentHash(connection);
+}
+
+TEST_CASE("SQLiteIndex_V2_0_Changeset", "[sqliteindex][V2_0]")
+{
+    TempFile baseFile{ "v2_0_index_tempdb"s, ".db"s };
+    TempFile previousFile{ "v2_0_index_previous_tempdb"s, ".db"s };
+    TempFile currentFile{ "v2_0_index_current_tempdb"s, ".db"s };
+    TempFile changesetFile{ "v2_0_changeset_tempdb"s, ".db"s };
+    TempFile appliedFile{ "v2_0_index_applied_tempdb"s, ".db"s };
+    INFO("Using files named: [" << previousFile.GetPath() << "], [" << currentFile.GetPath() << "], [" << changesetFile.GetPath() << "] and [" << appliedFile.GetPath() << "]");
+
+    std::ignore = SQLiteIndex::CreateNew(baseFile, SQLiteVersion{ 2, 0 });
+
+    ManifestAndPath manifest1;
+    CreateFakeManifestAndPath(manifest1, "Publisher1", "1.0");
+    ManifestAndPath manifest2;
+    CreateFakeManifestAndPath(manifest2, "Publisher2", "1.0");
+
+    {
+        SQLiteIndex index = SQLiteIndex::Open(baseFile, SQLiteStorageBase::OpenDisposition::ReadWrite);
+        index.SetProperty(SQLiteIndex::Property::PackageUpdateTrackingBaseTime, "");
+        index.AddManifest(manifest1.Manifest, manifest1.Path);
+        index.AddManifest(manifest2.Manifest, manifest2.Path);
+    }
+
+    PrepareForPackagingCopy(baseFile, previousFile);
+
+    ManifestAndPath manifest3;
+    CreateFakeManifestAndPath(manifest3, "Publisher1", "2.0");
+    ManifestAndPath manifest4;
+    CreateFakeManifestAndPath(manifest4, "Publisher3", "1.0");
+
+    {
+        SQLiteIndex index = SQLiteIndex::Open(baseFile, SQLiteStorageBase::OpenDisposition::ReadWrite);
+        index.SetProperty(SQLiteIndex::Property::PackageUpdateTrackingBaseTime, "");
+        index.AddManifest(manifest3.Manifest, manifest3.Path);
+        index.RemoveManifest(manifest2.Manifest);
+        index.AddManifest(manifest4.Manifest, manifest4.Path);
+    }
+
+    PrepareForPackagingCopy(baseFile, currentFile);
+
+    SQLiteIndexChangeset::Create(previousFile, currentFile, changesetFile);
+
+    SECTION("Applies to base")
+    {
+        std::filesystem::copy_file(previousFile, appliedFile, std::filesystem::copy_options::overwrite_existing);
+        SQLiteIndexChangeset::Apply(appliedFile, changesetFile);
+
+        REQUIRE(ComputeIndexContentHash(appliedFile) == ComputeIndexContentHash(currentFile));
+        REQUIRE(ComputeIndexContentHash(appliedFile) != ComputeIndexContentHash(previousFile));
+
+        SQLiteIndex applied = SQLiteIndex::Open(appliedFile.GetPath().u8string(), SQLiteStorageBase::OpenDisposition::Read);
+        REQUIRE(applied.Search({}).Matches.size() == 2);
+        REQUIRE(CountMatches(applied, PackageMatchField::Id, "Publisher2.Id") == 0);
+        REQUIRE(CountMatches(applied, PackageMatchField::Id, "Publisher3.Id") == 1);
+    }
+    SECTION("Rejects other base")
+    {
+        std::filesystem::copy_file(currentFile, appliedFile, std::filesystem::copy_options::overwrite_existing);
+        auto hashBefore = ComputeIndexContentHash(appliedFile);
+
+        REQUIRE_THROWS_HR(SQLiteIndexChangeset::Apply(appliedFile, changesetFile), APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE);
+        REQUIRE(ComputeIndexContentHash(appliedFile) == hashBefore);
+    }
+}
+
 void MigratePrepareAndCheckIntermediates(const std::filesystem::path& baseFile, const std::filesystem::path& preparedFile, const std::vector<std::vector<ManifestAndPath>>& expectedIntermediatesData)
 {
     TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
@@ -3963,3 +4238,270 @@ TEST_CASE("SQLiteIndex_VersionStringPreserved", "[sqliteindex]")
 
     REQUIRE(extractedVersion == version);
 }
+
+TEST_CASE("SQLiteIndex_GetAllValues", "[sqliteindex]")
+{
+    TempFile tempFile{ "repolibtest_tempdb"s, ".db"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    SQLiteIndex index = CreateTestIndex(tempFile);
+
+    Manifest manifest1;
+    CreateFakeManifest(manifest1, "Test");
+    index.AddManifest(manifest1, GetPathFromManifest(manifest1));
+
+    Manifest manifest2;
+    CreateFakeManifest(manifest2, "Other");
+    manifest2.Moniker = "othermoniker";
+    index.AddManifest(manifest2, GetPathFromManifest(manifest2));
+
+    TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
+    INFO("Intermediates directory: " << intermediatesDirectory.GetPath());
+
+    index.SetProperty(SQLiteIndex::Property::IntermediateFileOutputPath, intermediatesDirectory);
+    index.PrepareForPackaging();
+
+    auto getValues = [&](PackageMatchField field)
+    {
+        std::vector<std::string> result = index.GetAllValues(field);
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    };
+
+    REQUIRE(getValues(PackageMatchField::Id) == std::vector<std::string>{ "Other.Id", "Test.Id" });
+    REQUIRE(getValues(PackageMatchField::Name) == std::vector<std::string>{ "Other.Id Name", "Test.Id Name" });
+    REQUIRE(getValues(PackageMatchField::Moniker) == std::vector<std::string>{ "othermoniker", "testmoniker" });
+    REQUIRE(getValues(PackageMatchField::Tag) == std::vector<std::string>{ "t1", "t2" });
+    REQUIRE(getValues(PackageMatchField::Command) == std::vector<std::string>{ "test1", "test2" });
+    REQUIRE_THROWS_HR(index.GetAllValues(PackageMatchField::ProductCode), HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
+}
+
+TEST_CASE("SQLiteIndex_Search_RankedByRelevance", "[sqliteindex]")
+{
+    TempFile tempFile{ "repolibtest_tempdb"s, ".db"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    SQLiteIndex index = CreateTestIndex(tempFile);
+
+    // Added in the reverse of the expected order, so that the ranking is not just the order of the rows.
+    std::vector<std::pair<std::string, std::string>> publishersAndNames
+    {
+        { "Publisher5", "Barcode Reader" },
+        { "Publisher4", "Visual Studio Code" },
+        { "Publisher3", "Editor for Code" },
+        { "Publisher2", "Codex Tool" },
+        { "Publisher1", "CODE" },
+    };
+
+    for (const auto& [publisher, name] : publishersAndNames)
+    {
+        Manifest manifest;
+        CreateFakeManifest(manifest, publisher);
+        manifest.DefaultLocalization.Add<Localization::PackageName>(name);
+        index.AddManifest(manifest, GetPathFromManifest(manifest));
+    }
+
+    TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
+    INFO("Intermediates directory: " << intermediatesDirectory.GetPath());
+
+    index.SetProperty(SQLiteIndex::Property::IntermediateFileOutputPath, intermediatesDirectory);
+    index.PrepareForPackaging();
+
+    // An equal name, a prefix, a word starting with the value (earlier words first), then any other match.
+    std::vector<std::string> expected{ "Publisher1.Id", "Publisher2.Id", "Publisher3.Id", "Publisher4.Id", "Publisher5.Id" };
+
+    SearchRequest request;
+    request.Query = RequestMatch(MatchType::Substring, "code");
+
+    auto results = index.Search(request);
+    REQUIRE(results.Matches.size() == expected.size());
+    REQUIRE(!results.Truncated);
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        INFO(i);
+        REQUIRE(GetIdStringById(index, results.Matches[i].first) == expected[i]);
+    }
+
+    // A limited search keeps the best of the matches.
+    request.MaximumResults = 3;
+
+    results = index.Search(request);
+    REQUIRE(results.Matches.size() == 3);
+    REQUIRE(results.Truncated);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        INFO(i);
+        REQUIRE(GetIdStringById(index, results.Matches[i].first) == expected[i]);
+    }
+}
+
+TEST_CASE("SQLiteIndex_FuzzyMatcher", "[sqliteindex]")
+{
+    using AppInstaller::Repository::Microsoft::Schema::FuzzyMatcher;
+
+    // Short values must be exact, as any difference would match too many others.
+    REQUIRE(FuzzyMatcher{ "cd", false }.GetMaximumDistance() == 0);
+    REQUIRE(FuzzyMatcher{ "code", false }.GetMaximumDistance() == 1);
+    REQUIRE(FuzzyMatcher{ "vscode", false }.GetMaximumDistance() == 2);
+
+    FuzzyMatcher matcher{ "VSCode", false };
+    REQUIRE(matcher.GetDistance("vscode") == 0u);
+    REQUIRE(matcher.GetDistance("vsocde") == 1u);
+    REQUIRE(matcher.GetDistance("vs code") == 1u);
+    REQUIRE(matcher.GetDistance("vscodium") == std::nullopt);
+    REQUIRE(matcher.GetDistance("visual studio code") == std::nullopt);
+
+    FuzzyMatcher substringMatcher{ "cdoe", true };
+    REQUIRE(substringMatcher.GetDistance("Visual Studio Code") == 1u);
+    REQUIRE(substringMatcher.GetDistance("Notepad") == std::nullopt);
+
+    REQUIRE(matcher.GetMatches({ "vsocde", "Editor", "VSCode", "vsocde" }) == std::vector<std::string>{ "VSCode", "vsocde" });
+}
+
+TEST_CASE("SQLiteIndex_Search_Fuzzy", "[sqliteindex]")
+{
+    TempFile tempFile{ "repolibtest_tempdb"s, ".db"s };
+    INFO("Using temporary file named: " << tempFile.GetPath());
+
+    SQLiteIndex index = CreateTestIndex(tempFile);
+
+    std::vector<std::pair<std::string, std::string>> publishersAndNames
+    {
+        { "Publisher1", "Visual Studio Code" },
+        { "Publisher2", "Editor for Code" },
+        { "Publisher3", "Terminal" },
+        { "Publisher4", "Terminus" },
+    };
+
+    for (const auto& [publisher, name] : publishersAndNames)
+    {
+        Manifest manifest;
+        CreateFakeManifest(manifest, publisher);
+        manifest.DefaultLocalization.Add<Localization::PackageName>(name);
+        index.AddManifest(manifest, GetPathFromManifest(manifest));
+    }
+
+    auto validateSearch = [&]()
+    {
+        // A misspelled query finds the package.
+        SearchRequest request;
+        request.Query = RequestMatch(MatchType::Fuzzy, "Vsiual Studio Code");
+
+        auto results = index.Search(request);
+        REQUIRE(results.Matches.size() == 1);
+        REQUIRE(GetIdStringById(index, results.Matches[0].first) == "Publisher1.Id");
+        REQUIRE(results.Matches[0].second.Field == PackageMatchField::Name);
+        REQUIRE(results.Matches[0].second.Type == MatchType::Fuzzy);
+
+        // A misspelled word finds the name that contains it.
+        request = {};
+        request.Inclusions.emplace_back(PackageMatchFilter(PackageMatchField::Name, MatchType::FuzzySubstring, "Edtior"));
+
+        results = index.Search(request);
+        REQUIRE(results.Matches.size() == 1);
+        REQUIRE(GetIdStringById(index, results.Matches[0].first) == "Publisher2.Id");
+
+        // A short value must match exactly.
+        request = {};
+        request.Query = RequestMatch(MatchType::Fuzzy, "Tr");
+
+        results = index.Search(request);
+        REQUIRE(results.Matches.empty());
+
+        // An exact match ranks before a fuzzy one.
+        request = {};
+        request.Query = RequestMatch(MatchType::Fuzzy, "Terminus");
+
+        results = index.Search(request);
+        REQUIRE(results.Matches.size() == 2);
+        REQUIRE(GetIdStringById(index, results.Matches[0].first) == "Publisher4.Id");
+        REQUIRE(results.Matches[0].second.Type == MatchType::CaseInsensitive);
+        REQUIRE(GetIdStringById(index, results.Matches[1].first) == "Publisher3.Id");
+        REQUIRE(results.Matches[1].second.Type == MatchType::Fuzzy);
+    };
+
+    {
+        INFO("Before packaging");
+        validateSearch();
+    }
+
+    TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
+    INFO("Intermediates directory: " << intermediatesDirectory.GetPath());
+
+    index.SetProperty(SQLiteIndex::Property::IntermediateFileOutputPath, intermediatesDirectory);
+    index.PrepareForPackaging();
+
+    {
+        INFO("After packaging");
+        validateSearch();
+    }
+}
+
+TEST_CASE("SQLiteIndex_Search_Benchmark", "[sqliteindex][.][benchmark]")
+{
+    SyntheticPackageOptions options;
+    options.PackageCount = 5000;
+    options.VersionsPerPackage = 3;
+    std::vector<Manifest> manifests = CreateSyntheticManifests(options);
+
+    // Take the query values from a spread of the packages; whole identifiers for the exact match types and a word of the name for the others.
+    std::vector<NormalizedString> identifiers;
+    std::vector<NormalizedString> lowerIdentifiers;
+    std::vector<NormalizedString> nameWords;
+    std::vector<NormalizedString> productCodes;
+    for (size_t i = 0; i < manifests.size(); i += manifests.size() / 20)
+    {
+        identifiers.emplace_back(manifests[i].Id);
+        lowerIdentifiers.emplace_back(ToLower(manifests[i].Id));
+        std::string name = manifests[i].DefaultLocalization.Get<Localization::PackageName>();
+        nameWords.emplace_back(ToLower(name.substr(0, name.find(' '))));
+        productCodes.emplace_back(manifests[i].Installers[0].ProductCode);
+    }
+
+    TempDirectory intermediatesDirectory{ "v2_0_intermediates" };
+
+    for (SQLiteVersion version : { SQLiteVersion{ 1, 7 }, SQLiteVersion{ 2, 0 } })
+    {
+        SQLiteIndex index = SQLiteIndex::CreateNew(SQLITE_MEMORY_DB_CONNECTION_TARGET, version);
+        AddSyntheticManifests(index, manifests);
+
+        if (version.MajorVersion == 2)
+        {
+            index.SetProperty(SQLiteIndex::Property::IntermediateFileOutputPath, intermediatesDirectory);
+            index.PrepareForPackaging();
+        }
+
+        std::string prefix = "[" + std::to_string(version.MajorVersion) + '.' + std::to_string(version.MinorVersion) + "] ";
+
+        for (MatchType matchType : { MatchType::Exact, MatchType::CaseInsensitive, MatchType::StartsWith, MatchType::Substring, MatchType::Wildcard, MatchType::Fuzzy, MatchType::FuzzySubstring })
+        {
+            const std::vector<NormalizedString>& values =
+                (matchType == MatchType::Exact ? identifiers : (matchType == MatchType::CaseInsensitive ? lowerIdentifiers : nameWords));
+
+            BENCHMARK(prefix + "Query " + std::string{ ToString(matchType) })
+            {
+                size_t matches = 0;
+                for (const auto& value : values)
+                {
+                    SearchRequest request;
+                    request.Query = RequestMatch(matchType, value);
+                    matches += index.Search(request).Matches.size();
+                }
+                return matches;
+            };
+        }
+
+        BENCHMARK(prefix + "ProductCode inclusions")
+        {
+            SearchRequest request;
+            for (const auto& productCode : productCodes)
+            {
+                request.Inclusions.emplace_back(PackageMatchField::ProductCode, MatchType::Exact, productCode);
+            }
+            return index.Search(request).Matches.size();
+        };
+    }
+}
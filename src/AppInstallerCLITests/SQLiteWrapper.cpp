@@ -5,6 +5,7 @@
 #include <AppInstallerErrors.h>
 #include <winget/SQLiteWrapper.h>
 #include <winget/SQLiteStatementBuilder.h>
+#include <winget/SQLiteProfiler.h>
 
 using namespace AppInstaller::SQLite;
 using namespace std::string_literals;
@@ -287,6 +288,60 @@ TEST_CASE("SQLiteWrapper_EscapeStringForLike", "[sqlitewrapper]")
     REQUIRE(expected == output);
 }
 
+TEST_CASE("SQLiteProfiler_NormalizeSQL", "[sqlitewrapper]")
+{
+    REQUIRE(Profiler::NormalizeSQL("select  first,\n  second from simpletest ") == "select first, second from simpletest");
+    REQUIRE(Profiler::NormalizeSQL("select * from t where a = 'it''s' and b = 42 and c = 1.5") == "select * from t where a = ? and b = ? and c = ?");
+    REQUIRE(Profiler::NormalizeSQL("select [col1], \"t2\".a from [main].[t2]") == "select [col1], \"t2\".a from [main].[t2]");
+    REQUIRE(Profiler::NormalizeSQL("select * from [temp].[{8D5D9E2A-6C1B-4E3F-9A7D-2B1C0F4E5A6B}] limit 10") == "select * from [temp].[{guid}] limit ?");
+    REQUIRE(Profiler::NormalizeSQL("select * from t where a = ? and b = ?1") == "select * from t where a = ? and b = ?1");
+}
+
+TEST_CASE("SQLiteProfiler_AggregatesStatements", "[sqlitewrapper]")
+{
+    // The profiler must outlive the connection, as it is the context of the trace hook.
+    Profiler profiler;
+    profiler.Enable(std::chrono::milliseconds::max());
+
+    Connection connection = Connection::Create(SQLITE_MEMORY_DB_CONNECTION_TARGET, Connection::OpenDisposition::Create);
+    profiler.Attach(connection);
+
+    CreateSimpleTestTable(connection);
+
+    InsertIntoSimpleTestTable(connection, 1, "one");
+    InsertIntoSimpleTestTable(connection, 2, "two");
+    InsertIntoSimpleTestTable(connection, 3, "three");
+
+    Statement select = Statement::Create(connection, s_selectFromSimpleTestTableSQL);
+    while (select.Step()) {}
+
+    auto statistics = profiler.GetStatistics();
+
+    auto find = [&](std::string_view prefix) -> const Profiler::StatementStatistics*
+    {
+        for (const auto& statement : statistics)
+        {
+            if (statement.SQL.rfind(prefix, 0) == 0)
+            {
+                return &statement;
+            }
+        }
+        return nullptr;
+    };
+
+    const auto* insert = find("INSERT INTO");
+    REQUIRE(insert);
+    REQUIRE(insert->Count == 3);
+    REQUIRE(insert->Rows == 0);
+
+    const auto* selectStatistics = find("select first, second from simpletest");
+    REQUIRE(selectStatistics);
+    REQUIRE(selectStatistics->Count == 1);
+    REQUIRE(selectStatistics->Rows == 3);
+    REQUIRE(selectStatistics->FullScanSteps >= 2);
+    REQUIRE(selectStatistics->MaximumTime <= selectStatistics->TotalTime);
+}
+
 TEST_CASE("SQLiteWrapper_BindWithEmbeddedNull", "[sqlitewrapper]")
 {
     Connection connection = Connection::Create(SQLITE_MEMORY_DB_CONNECTION_TARGET, Connection::OpenDisposition::Create);
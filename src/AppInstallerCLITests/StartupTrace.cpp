@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <StartupTrace.h>
+
+using namespace AppInstaller::CLI;
+using namespace AppInstaller::CLI::Execution;
+using namespace TestCommon;
+
+namespace
+{
+    Json::Value ReadTraceFile(const std::filesystem::path& path)
+    {
+        Json::Value root;
+        std::ifstream stream{ path };
+        stream >> root;
+        return root;
+    }
+}
+
+TEST_CASE("StartupTrace_WriteTraceFile", "[startupTrace]")
+{
+    StartupTrace trace{ StartupTrace::clock::now() - std::chrono::milliseconds(10) };
+    trace.EndPhase("first");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    trace.EndPhase("second");
+
+    TraceRecorder recorder;
+    recorder.Enable(trace.GetStart());
+    trace.AddTo(recorder);
+
+    TempFile traceFile{ "StartupTrace", ".json" };
+    recorder.WriteTraceFile(traceFile);
+
+    Json::Value root = ReadTraceFile(traceFile);
+    const Json::Value& events = root["traceEvents"];
+    REQUIRE(events.isArray());
+    REQUIRE(events.size() == 2);
+
+    REQUIRE(events[0]["name"].asString() == "first");
+    REQUIRE(events[0]["cat"].asString() == "startup");
+    REQUIRE(events[0]["ph"].asString() == "X");
+    REQUIRE(events[0]["ts"].asInt64() == 0);
+    REQUIRE(events[0]["dur"].asInt64() >= 10000);
+
+    // Each phase begins where the previous one ended.
+    REQUIRE(events[1]["name"].asString() == "second");
+    REQUIRE(events[1]["ts"].asInt64() == events[0]["ts"].asInt64() + events[0]["dur"].asInt64());
+    REQUIRE(events[1]["dur"].asInt64() >= 5000);
+    REQUIRE(events[1]["pid"].asInt64() == static_cast<Json::Int64>(GetCurrentProcessId()));
+}
+
+TEST_CASE("StartupTrace_StartsAtProcessCreation", "[startupTrace]")
+{
+    auto beforeTrace = StartupTrace::clock::now();
+    StartupTrace trace;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    auto beforePhase = StartupTrace::clock::now();
+    trace.EndPhase("phase");
+
+    TraceRecorder recorder;
+    recorder.Enable(trace.GetStart());
+    trace.AddTo(recorder);
+
+    TempFile traceFile{ "StartupTrace", ".json" };
+    recorder.WriteTraceFile(traceFile);
+
+    // The process was created before the trace, so the first phase is at least as long as the trace has existed.
+    Json::Value root = ReadTraceFile(traceFile);
+    auto sinceTrace = std::chrono::duration_cast<std::chrono::microseconds>(beforePhase - beforeTrace);
+    REQUIRE(root["traceEvents"][0]["dur"].asInt64() >= sinceTrace.count());
+}
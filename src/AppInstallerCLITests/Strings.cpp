@@ -144,6 +144,69 @@ TEST_CASE("FoldCase", "[strings]")
     REQUIRE(FoldCase(u8"foldc\x430se"sv) == FoldCase(u8"FOLDC\x410SE"sv));
 }
 
+TEST_CASE("FoldCase_ASCIIMatchesICU", "[strings]")
+{
+    // Cover lengths on either side of the vectorized block size, and non-ASCII in both the blocks and the tail.
+    std::string ascii = "The Quick Brown Fox Jumps Over The Lazy Dog @[`{ 0123456789";
+    for (size_t length = 0; length <= ascii.size(); ++length)
+    {
+        std::string_view input = std::string_view{ ascii }.substr(0, length);
+        INFO(input);
+        REQUIRE(FoldCase(input) == ToLower(input));
+    }
+
+    // U+00D6 and U+00F6 are the upper and lower case O with diaeresis; U+00DF is the sharp s
+    REQUIRE(FoldCase("ABCDEFGHIJKLMNOP\xC3\x96"sv) == "abcdefghijklmnop\xC3\xB6"sv);
+    REQUIRE(FoldCase("\xC3\x96" "ABCDEFGHIJKLMNOPQRSTUVWXYZ"sv) == "\xC3\xB6" "abcdefghijklmnopqrstuvwxyz"sv);
+    REQUIRE(FoldCase("STRASSE STRA\xC3\x9F" "E"sv) == "strasse strasse"sv);
+    // U+0149 folds to U+02BC U+006E, which is longer than the input
+    REQUIRE(FoldCase("\xC5\x89"sv) == "\xCA\xBC" "n"sv);
+}
+
+TEST_CASE("ICUCaseInsensitiveEquals", "[strings]")
+{
+    REQUIRE(ICUCaseInsensitiveEquals("", ""));
+    REQUIRE(ICUCaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "microsoft.windowsterminal.PREVIEW"));
+    REQUIRE(ICUCaseInsensitiveEquals("Microsoft.WindowsTerminal.Pr\xC3\x96" "view", "microsoft.windowsterminal.pr\xC3\xB6" "VIEW"));
+    REQUIRE(ICUCaseInsensitiveEquals("STRA\xC3\x9F" "E", "strasse"));
+
+    REQUIRE_FALSE(ICUCaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "Microsoft.WindowsTerminal.Previe"));
+    REQUIRE_FALSE(ICUCaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "Microsoft.WindowsTerminal.Preview_"));
+    REQUIRE_FALSE(ICUCaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "Microsoft-WindowsTerminal.Preview"));
+    REQUIRE_FALSE(ICUCaseInsensitiveEquals("@", "`"));
+    REQUIRE_FALSE(ICUCaseInsensitiveEquals("[", "{"));
+
+    REQUIRE(CaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "MICROSOFT.windowsterminal.preview"));
+    REQUIRE_FALSE(CaseInsensitiveEquals("Microsoft.WindowsTerminal.Preview", "MICROSOFT.windowsterminal.previex"));
+    REQUIRE_FALSE(CaseInsensitiveEquals("\xC3\x96", "\xC3\xB6"));
+}
+
+TEST_CASE("FoldCase_Benchmark", "[strings][.][benchmark]")
+{
+    std::string ascii = "Microsoft.VisualStudio.2022.Community.Preview";
+    std::string nonAscii = "Microsoft.VisualStudio.2022.Community.Pr\xC3\x89" "view";
+
+    BENCHMARK("FoldCase ASCII")
+    {
+        return FoldCase(std::string_view{ ascii });
+    };
+
+    BENCHMARK("FoldCase non-ASCII")
+    {
+        return FoldCase(std::string_view{ nonAscii });
+    };
+
+    BENCHMARK("ICUCaseInsensitiveEquals ASCII")
+    {
+        return ICUCaseInsensitiveEquals(ascii, "microsoft.visualstudio.2022.community.preview");
+    };
+
+    BENCHMARK("CaseInsensitiveEquals")
+    {
+        return CaseInsensitiveEquals(ascii, "microsoft.visualstudio.2022.community.preview");
+    };
+}
+
 TEST_CASE("ExpandEnvironmentVariables", "[strings]")
 {
     wchar_t buffer[MAX_PATH];
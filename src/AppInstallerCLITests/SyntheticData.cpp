@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "SyntheticData.h"
+#include <AppInstallerSHA256.h>
+#include <AppInstallerStrings.h>
+
+#include <numeric>
+
+using namespace AppInstaller;
+using namespace AppInstaller::Repository::Microsoft;
+
+namespace TestCommon
+{
+    namespace
+    {
+        constexpr std::string_view s_Words[] =
+        {
+            "Alpha", "Aurora", "Binary", "Blue", "Bridge", "Canvas", "Cloud", "Code", "Compass", "Core",
+            "Crystal", "Data", "Delta", "Desktop", "Echo", "Edge", "Falcon", "Flow", "Forge", "Galaxy",
+            "Garden", "Graph", "Harbor", "Horizon", "Image", "Insight", "Iron", "Jet", "Key", "Lab",
+            "Light", "Link", "Media", "Mesh", "Micro", "Nova", "Office", "Orbit", "Paint", "Pixel",
+            "Player", "Pulse", "Quantum", "Quick", "Radar", "River", "Script", "Shell", "Signal", "Sky",
+            "Sound", "Spark", "Studio", "Sync", "Terminal", "Tool", "Vector", "Video", "Vision", "Zip",
+        };
+
+        constexpr std::string_view s_PublisherSuffixes[] = { "", " Inc.", " Software", " Labs", " Corporation", " LLC" };
+
+        constexpr Utility::Architecture s_Architectures[] = { Utility::Architecture::X64, Utility::Architecture::X86, Utility::Architecture::Arm64 };
+
+        std::string_view GetArchitectureName(Utility::Architecture architecture)
+        {
+            switch (architecture)
+            {
+            case Utility::Architecture::X86: return "x86";
+            case Utility::Architecture::Arm64: return "arm64";
+            default: return "x64";
+            }
+        }
+
+        struct Generator
+        {
+            Generator(uint32_t seed) : m_random(seed) {}
+
+            size_t Next(size_t bound)
+            {
+                return static_cast<size_t>(m_random() % bound);
+            }
+
+            std::string_view Word()
+            {
+                return s_Words[Next(std::size(s_Words))];
+            }
+
+            std::string Words(size_t minimum, size_t maximum, std::string_view separator)
+            {
+                std::string result;
+                size_t count = minimum + Next(maximum - minimum + 1);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (i)
+                    {
+                        result += separator;
+                    }
+                    result += Word();
+                }
+                return result;
+            }
+
+            std::string Hex(size_t length)
+            {
+                constexpr std::string_view digits = "0123456789ABCDEF";
+                std::string result;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    result += digits[Next(digits.size())];
+                }
+                return result;
+            }
+
+            std::string ProductCode()
+            {
+                return '{' + Hex(8) + '-' + Hex(4) + '-' + Hex(4) + '-' + Hex(4) + '-' + Hex(12) + '}';
+            }
+
+        private:
+            std::mt19937 m_random;
+        };
+    }
+
+    std::vector<Manifest::Manifest> CreateSyntheticManifests(const SyntheticPackageOptions& options)
+    {
+        Generator generator{ options.Seed };
+        std::set<std::string> identifiers;
+
+        std::vector<Manifest::Manifest> result;
+        result.reserve(options.PackageCount * options.VersionsPerPackage);
+
+        for (size_t package = 0; package < options.PackageCount; ++package)
+        {
+            std::string publisherWord{ generator.Word() };
+            std::string publisher = publisherWord + std::string{ s_PublisherSuffixes[generator.Next(std::size(s_PublisherSuffixes))] };
+            std::string name = generator.Words(1, 3, " ");
+
+            std::string compactName = name;
+            compactName.erase(std::remove(compactName.begin(), compactName.end(), ' '), compactName.end());
+
+            std::string identifier = publisherWord + '.' + compactName;
+            if (!identifiers.insert(identifier).second)
+            {
+                identifier += std::to_string(package);
+                identifiers.insert(identifier);
+            }
+
+            std::string moniker = Utility::ToLower(name.substr(0, name.find(' '))) + std::to_string(package % 100);
+            std::vector<Manifest::string_t> tags;
+            for (size_t i = 1 + generator.Next(4); i > 0; --i)
+            {
+                tags.emplace_back(Utility::ToLower(generator.Word()));
+            }
+            std::string command = (generator.Next(3) == 0 ? moniker : std::string{});
+            std::string familyName = (generator.Next(5) == 0 ? identifier + '_' + Utility::ToLower(generator.Hex(13)) : std::string{});
+
+            size_t major = generator.Next(20);
+            size_t minor = generator.Next(10);
+            size_t installerCount = 1 + generator.Next(std::size(s_Architectures));
+
+            for (size_t version = 0; version < options.VersionsPerPackage; ++version)
+            {
+                Manifest::Manifest manifest;
+                manifest.Id = identifier;
+                manifest.Version = std::to_string(major) + '.' + std::to_string(minor + version) + '.' + std::to_string(generator.Next(1000));
+                manifest.Moniker = moniker;
+                manifest.DefaultLocalization.Add<Manifest::Localization::PackageName>(name);
+                manifest.DefaultLocalization.Add<Manifest::Localization::Publisher>(publisher);
+                manifest.DefaultLocalization.Add<Manifest::Localization::ShortDescription>(name + " by " + publisher);
+                manifest.DefaultLocalization.Add<Manifest::Localization::License>("Proprietary");
+                manifest.DefaultLocalization.Add<Manifest::Localization::Tags>(tags);
+
+                for (size_t i = 0; i < installerCount; ++i)
+                {
+                    Manifest::ManifestInstaller installer;
+                    installer.Arch = s_Architectures[i];
+                    installer.BaseInstallerType = Manifest::InstallerTypeEnum::Msi;
+                    installer.Url = "https://example.com/" + identifier + '/' + manifest.Version + '/' + std::string{ GetArchitectureName(installer.Arch) } + ".msi";
+                    installer.Sha256 = Utility::SHA256::ConvertToBytes(generator.Hex(64));
+                    installer.ProductCode = generator.ProductCode();
+                    installer.PackageFamilyName = familyName;
+
+                    if (!command.empty())
+                    {
+                        installer.Commands = { command };
+                    }
+
+                    Manifest::AppsAndFeaturesEntry entry;
+                    entry.DisplayName = name;
+                    entry.Publisher = publisher;
+                    entry.DisplayVersion = manifest.Version;
+                    installer.AppsAndFeaturesEntries.emplace_back(std::move(entry));
+
+                    manifest.Installers.emplace_back(std::move(installer));
+                }
+
+                result.emplace_back(std::move(manifest));
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<Manifest::Manifest> CreateSyntheticInstalledManifests(
+        const std::vector<Manifest::Manifest>& available,
+        size_t count,
+        double correlatedFraction,
+        uint32_t seed)
+    {
+        Generator generator{ seed };
+
+        // Choose distinct available manifests so that no ProductCode is installed twice.
+        std::vector<size_t> candidates(available.size());
+        std::iota(candidates.begin(), candidates.end(), size_t{ 0 });
+        std::shuffle(candidates.begin(), candidates.end(), std::mt19937{ seed });
+
+        size_t correlatedCount = std::min(static_cast<size_t>(static_cast<double>(count) * correlatedFraction), candidates.size());
+
+        std::vector<Manifest::Manifest> result;
+        result.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::string name;
+            std::string publisher;
+            std::string version;
+            std::string productCode;
+
+            if (i < correlatedCount)
+            {
+                const auto& source = available[candidates[i]];
+                const auto& entry = source.Installers[0].AppsAndFeaturesEntries[0];
+                name = entry.DisplayName;
+                publisher = entry.Publisher;
+                version = entry.DisplayVersion;
+                productCode = source.Installers[0].ProductCode;
+            }
+            else
+            {
+                name = generator.Words(2, 4, " ");
+                // The publisher is outside of the vocabulary of the available set, so that these never correlate by name.
+                publisher = "Contoso " + std::string{ generator.Word() };
+                version = std::to_string(generator.Next(20)) + '.' + std::to_string(generator.Next(100));
+                productCode = generator.ProductCode();
+            }
+
+            Manifest::Manifest manifest;
+            manifest.Id = "ARP\\Machine\\X64\\" + productCode;
+            manifest.Version = version;
+            manifest.DefaultLocalization.Add<Manifest::Localization::PackageName>(name);
+            manifest.DefaultLocalization.Add<Manifest::Localization::Publisher>(publisher);
+            manifest.DefaultLocalization.Add<Manifest::Localization::Tags>({ "ARP" });
+
+            manifest.Installers.emplace_back();
+            manifest.Installers[0].ProductCode = productCode;
+            manifest.Installers[0].AppsAndFeaturesEntries.emplace_back();
+            manifest.Installers[0].AppsAndFeaturesEntries[0].DisplayName = name;
+
+            result.emplace_back(std::move(manifest));
+        }
+
+        return result;
+    }
+
+    std::string CreateSyntheticManifestYaml(const Manifest::Manifest& manifest)
+    {
+        std::ostringstream stream;
+
+        stream << "# yaml-language-server: $schema=https://aka.ms/winget-manifest.singleton.1.10.0.schema.json\n\n";
+        stream << "PackageIdentifier: " << manifest.Id << '\n';
+        stream << "PackageVersion: " << manifest.Version << '\n';
+        stream << "PackageLocale: en-US\n";
+        stream << "Publisher: " << manifest.DefaultLocalization.Get<Manifest::Localization::Publisher>() << '\n';
+        stream << "PackageName: " << manifest.DefaultLocalization.Get<Manifest::Localization::PackageName>() << '\n';
+        stream << "License: " << manifest.DefaultLocalization.Get<Manifest::Localization::License>() << '\n';
+        stream << "ShortDescription: " << manifest.DefaultLocalization.Get<Manifest::Localization::ShortDescription>() << '\n';
+        stream << "Moniker: " << manifest.Moniker << '\n';
+
+        stream << "Tags:\n";
+        for (const auto& tag : manifest.DefaultLocalization.Get<Manifest::Localization::Tags>())
+        {
+            stream << "  - " << tag << '\n';
+        }
+
+        stream << "Installers:\n";
+        for (const auto& installer : manifest.Installers)
+        {
+            stream << "  - Architecture: " << GetArchitectureName(installer.Arch) << '\n';
+            stream << "    InstallerType: " << Manifest::InstallerTypeToString(installer.BaseInstallerType) << '\n';
+            stream << "    InstallerUrl: " << installer.Url << '\n';
+            stream << "    InstallerSha256: " << Utility::SHA256::ConvertToString(installer.Sha256) << '\n';
+            stream << "    ProductCode: '" << installer.ProductCode << "'\n";
+
+            if (!installer.PackageFamilyName.empty())
+            {
+                stream << "    PackageFamilyName: " << installer.PackageFamilyName << '\n';
+            }
+
+            if (!installer.Commands.empty())
+            {
+                stream << "    Commands:\n";
+                for (const auto& command : installer.Commands)
+                {
+                    stream << "      - " << command << '\n';
+                }
+            }
+
+            stream << "    AppsAndFeaturesEntries:\n";
+            for (const auto& entry : installer.AppsAndFeaturesEntries)
+            {
+                stream << "      - DisplayName: " << entry.DisplayName << '\n';
+                stream << "        Publisher: " << entry.Publisher << '\n';
+                stream << "        DisplayVersion: " << entry.DisplayVersion << '\n';
+            }
+        }
+
+        stream << "ManifestType: singleton\n";
+        stream << "ManifestVersion: 1.10.0\n";
+
+        return stream.str();
+    }
+
+    void AddSyntheticManifests(SQLiteIndex& index, const std::vector<Manifest::Manifest>& manifests, bool withPaths)
+    {
+        for (const auto& manifest : manifests)
+        {
+            if (withPaths)
+            {
+                std::string relativePath = Utility::ToLower(manifest.Id);
+                Utility::FindAndReplace(relativePath, ".", "/");
+                relativePath.append("/").append(manifest.Version).append(".yaml");
+                index.AddManifest(manifest, relativePath);
+            }
+            else
+            {
+                index.AddManifest(manifest);
+            }
+        }
+    }
+}
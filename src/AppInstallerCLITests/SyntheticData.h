@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <winget/Manifest.h>
+#include <Microsoft/SQLiteIndex.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TestCommon
+{
+    // Describes a synthetic set of packages; the same options always produce the same set.
+    struct SyntheticPackageOptions
+    {
+        size_t PackageCount = 1000;
+        size_t VersionsPerPackage = 3;
+        uint32_t Seed = 1;
+    };
+
+    // Creates a manifest for every version of a synthetic set of packages.
+    // Names, publishers, monikers, tags and commands are drawn from a fixed vocabulary so that searches find realistic numbers of matches.
+    // Every installer has a unique ProductCode and an AppsAndFeaturesEntry; some packages also have a PackageFamilyName.
+    std::vector<AppInstaller::Manifest::Manifest> CreateSyntheticManifests(const SyntheticPackageOptions& options);
+
+    // Creates manifests that model the ARP entries of a machine, in the form that the installed source creates them.
+    // The given fraction of the entries share a ProductCode with one of the available manifests; the rest are unknown to them.
+    std::vector<AppInstaller::Manifest::Manifest> CreateSyntheticInstalledManifests(
+        const std::vector<AppInstaller::Manifest::Manifest>& available,
+        size_t count,
+        double correlatedFraction,
+        uint32_t seed = 1);
+
+    // Creates the YAML for a singleton manifest with the same contents as the given manifest.
+    std::string CreateSyntheticManifestYaml(const AppInstaller::Manifest::Manifest& manifest);
+
+    // Adds the manifests to the index; if withPaths is true, each is given a relative path built from its identifier and version.
+    void AddSyntheticManifests(
+        AppInstaller::Repository::Microsoft::SQLiteIndex& index,
+        const std::vector<AppInstaller::Manifest::Manifest>& manifests,
+        bool withPaths = true);
+}
@@ -47,6 +47,7 @@ namespace AppInstaller
     namespace Repository::Microsoft
     {
         void TestHook_SetPinningIndex_Override(std::optional<std::filesystem::path>&& indexPath);
+        void TestHook_SetDeltaChangeset_Override(std::optional<std::filesystem::path>&& changesetPath);
 
         using GetARPKeyFunc = std::function<Registry::Key(Manifest::ScopeEnum, Utility::Architecture)>;
         void SetGetARPKeyOverride(GetARPKeyFunc value);
@@ -168,6 +169,19 @@ namespace TestHook
         }
     };
 
+    struct SetDeltaChangeset_Override
+    {
+        SetDeltaChangeset_Override(const std::filesystem::path& changesetPath)
+        {
+            AppInstaller::Repository::Microsoft::TestHook_SetDeltaChangeset_Override(changesetPath);
+        }
+
+        ~SetDeltaChangeset_Override()
+        {
+            AppInstaller::Repository::Microsoft::TestHook_SetDeltaChangeset_Override({});
+        }
+    };
+
     struct SetExtractIconFromArpEntryResult_Override
     {
         SetExtractIconFromArpEntryResult_Override(std::vector<AppInstaller::Repository::ExtractedIconInfo> extractedIcons) : m_extractedIcons(std::move(extractedIcons))
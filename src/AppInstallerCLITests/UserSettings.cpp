@@ -627,6 +627,22 @@ TEST_CASE("SettingsArchiveExtractionMethod", "[settings]")
 
         REQUIRE(userSettingTest.Get<Setting::ArchiveExtractionMethod>() == AppInstaller::Archive::ExtractionMethod::Tar);
     }
+    SECTION("Native")
+    {
+        std::string_view json = R"({ "installBehavior": { "archiveExtractionMethod": "native" } })";
+        SetSetting(Stream::PrimaryUserSettings, json);
+        UserSettingsTest userSettingTest;
+
+        REQUIRE(userSettingTest.Get<Setting::ArchiveExtractionMethod>() == AppInstaller::Archive::ExtractionMethod::Native);
+    }
+    SECTION("Default")
+    {
+        std::string_view json = R"({ "installBehavior": { "archiveExtractionMethod": "unknown" } })";
+        SetSetting(Stream::PrimaryUserSettings, json);
+        UserSettingsTest userSettingTest;
+
+        REQUIRE(userSettingTest.Get<Setting::ArchiveExtractionMethod>() == AppInstaller::Archive::ExtractionMethod::ShellApi);
+    }
 }
 
 TEST_CASE("SettingsInstallScope", "[settings]")
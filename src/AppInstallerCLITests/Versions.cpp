@@ -470,3 +470,45 @@ TEST_CASE("OpenTypeFontVersion", "[versions]")
     REQUIRE(version.IsUnknown());
     REQUIRE(version.ToString() == "Unknown");
 }
+
+TEST_CASE("VersionSort_Benchmark", "[versions][.][benchmark]")
+{
+    std::mt19937 random{ 1 };
+    std::vector<std::string> values;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        std::string value = std::to_string(random() % 20) + '.' + std::to_string(random() % 100) + '.' + std::to_string(random() % 10000);
+        if (random() % 4 == 0)
+        {
+            value += "-beta" + std::to_string(random() % 10);
+        }
+        values.emplace_back(std::move(value));
+    }
+
+    std::vector<Version> versions{ values.begin(), values.end() };
+
+    BENCHMARK("Parse")
+    {
+        std::vector<Version> result;
+        result.reserve(values.size());
+        for (const auto& value : values)
+        {
+            result.emplace_back(value);
+        }
+        return result;
+    };
+
+    BENCHMARK("Sort")
+    {
+        std::vector<Version> result = versions;
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    BENCHMARK("Parse and sort")
+    {
+        std::vector<Version> result{ values.begin(), values.end() };
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+}
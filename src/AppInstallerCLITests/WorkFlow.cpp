@@ -7,6 +7,7 @@
 #include <winget/Settings.h>
 #include <Workflows/DownloadFlow.h>
 #include <Commands/InstallCommand.h>
+#include <Commands/SearchCommand.h>
 #include <Commands/SettingsCommand.h>
 #include <Commands/ValidateCommand.h>
 
@@ -187,3 +188,64 @@ TEST_CASE("Export_Settings", "[Settings][workflow]")
         REQUIRE(userSettingsFileValue.find("settings.json") != std::string::npos);
     }
 }
+
+namespace
+{
+    // A source that only returns its results for a fuzzy search, as if the query were misspelled.
+    struct FuzzyOnlyTestSource : public WorkflowTestSource
+    {
+        FuzzyOnlyTestSource(std::vector<TestSourceResult>&& testSourceResults) : WorkflowTestSource(std::move(testSourceResults)) {}
+
+        SearchResult Search(const SearchRequest& request) const override
+        {
+            ++SearchCount;
+
+            if (!request.Query || request.Query->Type != MatchType::FuzzySubstring)
+            {
+                return {};
+            }
+
+            return WorkflowTestSource::Search(request);
+        }
+
+        mutable size_t SearchCount = 0;
+    };
+}
+
+TEST_CASE("SearchFlow_FuzzyIfNoMatches", "[SearchFlow][workflow]")
+{
+    std::ostringstream searchOutput;
+    TestContext context{ searchOutput, std::cin };
+    auto previousThreadGlobals = context.SetForCurrentThread();
+    auto testSource = std::make_shared<FuzzyOnlyTestSource>(std::vector<TestSourceResult>{ TSR::TestQuery_ReturnOne });
+    OverrideForOpenSource(context, testSource);
+    context.Args.AddArg(Execution::Args::Type::Query, TSR::TestQuery_ReturnOne.Query);
+
+    SearchCommand search({});
+    search.Execute(context);
+    INFO(searchOutput.str());
+
+    REQUIRE_FALSE(context.IsTerminated());
+    REQUIRE(testSource->SearchCount == 2);
+    REQUIRE(searchOutput.str().find(Resource::LocString(Resource::String::SearchSimilarMatches).get()) != std::string::npos);
+    REQUIRE(searchOutput.str().find("AppInstallerCliTest.TestExeInstaller") != std::string::npos);
+}
+
+TEST_CASE("SearchFlow_FuzzyIfNoMatches_Exact", "[SearchFlow][workflow]")
+{
+    std::ostringstream searchOutput;
+    TestContext context{ searchOutput, std::cin };
+    auto previousThreadGlobals = context.SetForCurrentThread();
+    auto testSource = std::make_shared<FuzzyOnlyTestSource>(std::vector<TestSourceResult>{ TSR::TestQuery_ReturnOne });
+    OverrideForOpenSource(context, testSource);
+    context.Args.AddArg(Execution::Args::Type::Query, TSR::TestQuery_ReturnOne.Query);
+    context.Args.AddArg(Execution::Args::Type::Exact);
+
+    SearchCommand search({});
+    search.Execute(context);
+    INFO(searchOutput.str());
+
+    REQUIRE(context.GetTerminationHR() == APPINSTALLER_CLI_ERROR_NO_APPLICATIONS_FOUND);
+    REQUIRE(testSource->SearchCount == 1);
+    REQUIRE(searchOutput.str().find(Resource::LocString(Resource::String::SearchSimilarMatches).get()) == std::string::npos);
+}
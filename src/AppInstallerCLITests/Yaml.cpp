@@ -8,6 +8,7 @@
 using namespace TestCommon;
 using namespace AppInstaller::Utility;
 using namespace AppInstaller::YAML;
+using namespace std::string_view_literals;
 
 
 TEST_CASE("YamlParserTypes", "[YAML]")
@@ -178,3 +179,111 @@ TEST_CASE("YamlContainsTooManyNestedLayers", "[YAML]")
 {
     REQUIRE_THROWS_HR(Load(TestDataFile("ContainsTooManyNestedLayers.yaml")), APPINSTALLER_CLI_ERROR_YAML_DOC_BUILD_FAILED);
 }
+
+TEST_CASE("YamlMappingNode_OrderedByKey", "[YAML]")
+{
+    auto document = Load("b: 1\na: 2\nc: 3\na: 4"sv);
+
+    const auto& mapping = document.Mapping();
+    REQUIRE(4 == mapping.size());
+    REQUIRE(mapping[0].first.as<std::string>() == "a");
+    REQUIRE(mapping[0].second.as<std::string>() == "2");
+    REQUIRE(mapping[1].first.as<std::string>() == "a");
+    REQUIRE(mapping[1].second.as<std::string>() == "4");
+    REQUIRE(mapping[2].first.as<std::string>() == "b");
+    REQUIRE(mapping[3].first.as<std::string>() == "c");
+
+    REQUIRE(document["b"].as<int>() == 1);
+    REQUIRE(document["missing"].IsNull());
+    REQUIRE_THROWS_HR(document["a"], APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY);
+}
+
+TEST_CASE("YamlNode_CopyOutlivesDocument", "[YAML]")
+{
+    Node copy;
+
+    {
+        auto document = Load(TestDataFile("Node-Merge.yaml"));
+        copy = document["StrawHats"];
+    }
+
+    REQUIRE(3 == copy.size());
+    REQUIRE(copy[0]["Name"].as<std::string>() == "Monkey D Luffy");
+
+    Node scalar{ Node::Type::Scalar, "", Mark{} };
+    {
+        std::string value = "transient";
+        scalar.SetScalar(value);
+    }
+
+    REQUIRE(scalar.as<std::string>() == "transient");
+}
+
+TEST_CASE("YamlNode_AnchorAndAlias", "[YAML]")
+{
+    auto document = Load("Anchored: &anchor shared value\nAlias: *anchor\nList: [ *anchor, *anchor, other ]\nMap: &map { Key: *anchor }\nMapAlias: *map\n"sv);
+
+    REQUIRE(document["Anchored"].as<std::string>() == "shared value");
+    REQUIRE(document["Alias"].as<std::string>() == "shared value");
+    REQUIRE(3 == document["List"].size());
+    REQUIRE(document["List"][0].as<std::string>() == "shared value");
+    REQUIRE(document["List"][1].as<std::string>() == "shared value");
+    REQUIRE(document["List"][2].as<std::string>() == "other");
+    REQUIRE(document["Map"]["Key"].as<std::string>() == "shared value");
+    REQUIRE(document["MapAlias"]["Key"].as<std::string>() == "shared value");
+}
+
+namespace
+{
+    std::string CreateLargeManifestYaml(size_t installerCount)
+    {
+        std::ostringstream stream;
+        stream << "PackageIdentifier: Benchmark.Package\nPackageVersion: 1.0.0\nManifestType: installer\nManifestVersion: 1.10.0\nInstallers:\n";
+
+        for (size_t i = 0; i < installerCount; ++i)
+        {
+            stream <<
+                "- Architecture: x64\n"
+                "  InstallerType: msi\n"
+                "  InstallerLocale: en-US\n"
+                "  Scope: machine\n"
+                "  InstallerUrl: https://example.com/installer" << i << ".msi\n"
+                "  InstallerSha256: 69D84CA8899800A5575CE31798293CD4FEBAB1D734A07C2E51E56A28E0DF8C82\n"
+                "  ProductCode: '{" << i << "}'\n"
+                "  InstallerSwitches:\n"
+                "    Silent: /quiet\n"
+                "    SilentWithProgress: /passive\n"
+                "  Commands:\n"
+                "  - command" << i << "\n";
+        }
+
+        return std::move(stream).str();
+    }
+}
+
+TEST_CASE("YamlParse_Benchmark", "[YAML][.][benchmark]")
+{
+    std::string manifest = CreateLargeManifestYaml(500);
+
+    BENCHMARK("Load")
+    {
+        return Load(manifest);
+    };
+
+    Node document = Load(manifest);
+
+    BENCHMARK("Copy")
+    {
+        return Node{ document };
+    };
+
+    BENCHMARK("Lookup")
+    {
+        size_t count = 0;
+        for (const auto& installer : document["Installers"].Sequence())
+        {
+            count += installer["InstallerUrl"].IsDefined() ? 1 : 0;
+        }
+        return count;
+    };
+}
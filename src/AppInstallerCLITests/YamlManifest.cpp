@@ -3,6 +3,7 @@
 #include "pch.h"
 #include "TestCommon.h"
 #include "TestSettings.h"
+#include "SyntheticData.h"
 #include <AppInstallerSHA256.h>
 #include <AppInstallerLanguageUtilities.h>
 #include <winget/ManifestYamlParser.h>
@@ -1895,3 +1896,40 @@ TEST_CASE("Manifest_PackageFamilyNameInheritance", "[ManifestValidation]")
     REQUIRE(!manifest.Installers.empty());
     REQUIRE(!manifest.Installers[0].PackageFamilyName.empty());
 }
+
+TEST_CASE("YamlManifest_ParseAndValidate_Benchmark", "[ManifestValidation][.][benchmark]")
+{
+    SyntheticPackageOptions options;
+    options.PackageCount = 500;
+    options.VersionsPerPackage = 1;
+
+    std::vector<std::string> corpus;
+    for (const auto& manifest : CreateSyntheticManifests(options))
+    {
+        corpus.emplace_back(CreateSyntheticManifestYaml(manifest));
+    }
+
+    // Ensure that the corpus is valid, so that the measurements include the full validation.
+    ManifestValidateOption fullValidation{ true };
+    REQUIRE_NOTHROW(YamlParser::Create(corpus[0], fullValidation));
+
+    BENCHMARK("Parse corpus")
+    {
+        size_t installers = 0;
+        for (const auto& input : corpus)
+        {
+            installers += YamlParser::Create(input).Installers.size();
+        }
+        return installers;
+    };
+
+    BENCHMARK("Parse and validate corpus")
+    {
+        size_t installers = 0;
+        for (const auto& input : corpus)
+        {
+            installers += YamlParser::Create(input, fullValidation).Installers.size();
+        }
+        return installers;
+    };
+}
@@ -11,6 +11,7 @@
 #include <Msi.h>
 #include <KnownFolders.h>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_case_info.hpp>
@@ -2,18 +2,390 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "Public/winget/Archive.h"
+#include "AppInstallerLogging.h"
+#include "AppInstallerStrings.h"
+#include <winget/Concurrency.h>
+#include <winget/Filesystem.h>
 
 // TODO: Move include statement to pch.h and resolve build errors
 #pragma warning( push )
 #pragma warning ( disable : 4189 4244 26451 )
-#include <pure.h>
+#include <pure_stream.h>
 #pragma warning ( pop )
 
+#include <atomic>
+#include <unordered_map>
+
+using namespace std::chrono_literals;
+using namespace std::string_view_literals;
+
 namespace AppInstaller::Archive
 {
     using unique_pidlist_absolute = wil::unique_any<PIDLIST_ABSOLUTE, decltype(&::CoTaskMemFree), ::CoTaskMemFree>;
     using unique_lpitemidlist = wil::unique_any<LPITEMIDLIST, decltype(&::CoTaskMemFree), ::CoTaskMemFree>;
 
+    namespace
+    {
+        // Below this much compressed data, verifying on the calling thread is faster than starting workers.
+        constexpr uint64_t s_ConcurrentScanMinimumSize = 4 * 1024 * 1024;
+
+        // How often progress is reported and cancellation checked while extracting.
+        constexpr std::chrono::milliseconds s_ExtractionProgressInterval = 100ms;
+
+        // A read-only view of an entire file. An empty file cannot be mapped, and is left without a view.
+        struct MappedFile
+        {
+            MappedFile(const std::filesystem::path& path)
+            {
+                m_file.reset(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+                THROW_LAST_ERROR_IF(!m_file);
+
+                LARGE_INTEGER fileSize{};
+                THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(m_file.get(), &fileSize));
+                m_size = static_cast<uint64_t>(fileSize.QuadPart);
+
+                if (m_size > 0)
+                {
+                    m_mapping.reset(CreateFileMappingW(m_file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+                    THROW_LAST_ERROR_IF(!m_mapping);
+
+                    m_view.reset(reinterpret_cast<uint8_t*>(MapViewOfFile(m_mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+                    THROW_LAST_ERROR_IF(!m_view);
+                }
+            }
+
+            const uint8_t* Data() const { return m_view.get(); }
+            uint64_t Size() const { return m_size; }
+
+        private:
+            wil::unique_hfile m_file;
+            wil::unique_handle m_mapping;
+            wil::unique_mapview_ptr<uint8_t> m_view;
+            uint64_t m_size = 0;
+        };
+
+        // Pages of the mapped archive that cannot be read in, such as when the file is on a network share that goes away,
+        // raise a structured exception on the thread that touches them. All reads of the view go through here to turn that
+        // into a failure; the operation must only call into pure, as no C++ unwinding happens for these exceptions.
+        template <typename Operation>
+        bool TryReadMappedView(Operation&& operation)
+        {
+            __try
+            {
+                operation();
+                return true;
+            }
+            __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+            {
+                return false;
+            }
+        }
+
+        // Verifies the data of the indexed entries on a set of workers, so that the ordered replay afterward
+        // only needs to check the results. Entries that are not verified here are verified by the replay.
+        void VerifyZipEntriesConcurrently(const uint8_t* buffer, pure_zip_stream_index& index)
+        {
+            uint64_t compressedSize = 0;
+            for (uint64_t i = 0; i < index.count && compressedSize < s_ConcurrentScanMinimumSize; ++i)
+            {
+                compressedSize += index.entries[i].cdh.compressed_size;
+            }
+
+            size_t threadCount = Utility::GetConcurrentThreadCount(static_cast<size_t>(std::min<uint64_t>(index.count, SIZE_MAX)));
+            if (threadCount <= 1 || compressedSize < s_ConcurrentScanMinimumSize)
+            {
+                return;
+            }
+
+            std::atomic<uint64_t> next = 0;
+            // The replay stops at the first entry that fails, so nothing after it needs to be verified.
+            std::atomic<uint64_t> firstFailure = index.count;
+
+            auto worker = [&]()
+            {
+                uint8_t* chunk = nullptr;
+                uint64_t chunkSize = 0;
+                if (pure_realloc(&chunk, &chunkSize, PURE_STREAM_CHUNK))
+                {
+                    return;
+                }
+
+                for (uint64_t i = next++; i < index.count && i < firstFailure; i = next++)
+                {
+                    pure_zip_stream_entry& entry = index.entries[i];
+
+                    // The ratio check would stop the replay here unless a nested archive changed the totals;
+                    // leave this and later entries to the replay rather than inflate a likely bomb.
+                    if (entry.ratio)
+                    {
+                        break;
+                    }
+
+                    // The replay will hit the same error on the calling thread, where it is reported.
+                    if (!TryReadMappedView([&]() { pure_zip_stream_verify(buffer, &entry, chunk, chunkSize); }))
+                    {
+                        break;
+                    }
+
+                    if (entry.error || (!entry.nested && entry.checksum != entry.cdh.crc32))
+                    {
+                        uint64_t current = firstFailure;
+                        while (i < current && !firstFailure.compare_exchange_weak(current, i));
+                    }
+                }
+
+                pure_free(&chunk, &chunkSize);
+            };
+
+            // The calling thread participates as well. Failing to start a thread only leaves more of the entries to the replay.
+            try
+            {
+                Utility::RunConcurrently(threadCount, worker);
+            }
+            CATCH_LOG();
+        }
+
+        // Equivalent to pure_zip_stream, with the entries of the outermost archive verified concurrently.
+        int ScanZipBuffer(const uint8_t* buffer, uint64_t size)
+        {
+            pure_ctx ctx;
+            pure_zip_stream_ctx(&ctx, 0);
+
+            pure_zip_stream_index index{};
+            auto freeIndex = wil::scope_exit([&]() { pure_zip_stream_index_free(&index); });
+
+            int result = 0;
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_READ_FAULT), !TryReadMappedView([&]() { result = pure_zip_stream_index_entries(&ctx, buffer, size, &index); }));
+            if (result)
+            {
+                return result;
+            }
+
+            VerifyZipEntriesConcurrently(buffer, index);
+
+            uint8_t* chunk = nullptr;
+            uint64_t chunkSize = 0;
+            uint8_t* data = nullptr;
+            uint64_t dataSize = 0;
+            auto freeBuffers = wil::scope_exit([&]()
+                {
+                    pure_free(&data, &dataSize);
+                    pure_free(&chunk, &chunkSize);
+                });
+
+            result = pure_realloc(&chunk, &chunkSize, PURE_STREAM_CHUNK);
+            if (result)
+            {
+                return result;
+            }
+
+            // Replaying in order gives the same result as scanning serially.
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_READ_FAULT), !TryReadMappedView([&]() { result = pure_zip_stream_meta(&ctx, buffer, &index, chunk, chunkSize, &data, &dataSize); }));
+            return result;
+        }
+
+        // A file of the archive to be extracted.
+        struct ExtractionItem
+        {
+            pure_zip_stream_entry* Entry = nullptr;
+            std::filesystem::path Path;
+            HRESULT Result = E_PENDING;
+            int ZipResult = 0;
+            // Only set when hashing while extracting.
+            Utility::SHA256::HashBuffer Hash;
+            FILETIME LastWriteTime{};
+        };
+
+        struct ExtractionSinkContext
+        {
+            HANDLE File;
+            std::atomic<uint64_t>& BytesWritten;
+            const std::atomic<bool>& Cancelled;
+            Utility::SHA256* Hash = nullptr;
+            HRESULT Result = S_OK;
+        };
+
+        int WriteExtractedData(void* context, const uint8_t* data, uint64_t size)
+        {
+            ExtractionSinkContext* sinkContext = static_cast<ExtractionSinkContext*>(context);
+
+            if (sinkContext->Cancelled)
+            {
+                sinkContext->Result = E_ABORT;
+                return 1;
+            }
+
+            while (size > 0)
+            {
+                DWORD written = 0;
+                if (!WriteFile(sinkContext->File, data, static_cast<DWORD>(std::min<uint64_t>(size, MAXDWORD)), &written, nullptr))
+                {
+                    sinkContext->Result = HRESULT_FROM_WIN32(GetLastError());
+                    return 1;
+                }
+
+                if (sinkContext->Hash)
+                {
+                    try
+                    {
+                        sinkContext->Hash->Add(data, written);
+                    }
+                    catch (...)
+                    {
+                        sinkContext->Result = wil::ResultFromCaughtException();
+                        return 1;
+                    }
+                }
+
+                data += written;
+                size -= written;
+                sinkContext->BytesWritten += written;
+            }
+
+            return 0;
+        }
+
+        // Determines whether a path component names a device, such as "CON" or "com1.txt", rather than a file.
+        // Windows ignores any extension and trailing spaces, so these would open the device instead of creating a file.
+        bool IsReservedDeviceName(std::wstring_view component)
+        {
+            component = component.substr(0, component.find(L'.'));
+
+            size_t end = component.find_last_not_of(L' ');
+            component = component.substr(0, end == std::wstring_view::npos ? 0 : end + 1);
+
+            auto equals = [&](std::wstring_view reserved)
+            {
+                return CompareStringOrdinal(component.data(), static_cast<int>(component.size()), reserved.data(), static_cast<int>(reserved.size()), TRUE) == CSTR_EQUAL;
+            };
+
+            for (std::wstring_view reserved : { L"CON"sv, L"PRN"sv, L"AUX"sv, L"NUL"sv, L"CONIN$"sv, L"CONOUT$"sv })
+            {
+                if (equals(reserved))
+                {
+                    return true;
+                }
+            }
+
+            // COM and LPT are followed by a single digit, including the superscript digits.
+            if (component.size() == 4)
+            {
+                wchar_t digit = component[3];
+                if ((digit >= L'0' && digit <= L'9') || digit == L'\x00B9' || digit == L'\x00B2' || digit == L'\x00B3')
+                {
+                    component = component.substr(0, 3);
+                    return equals(L"COM"sv) || equals(L"LPT"sv);
+                }
+            }
+
+            return false;
+        }
+
+        // Gets the path of the entry relative to the destination, or nothing if it cannot be safely extracted.
+        // pure has already rejected absolute paths, drive letters, backslashes, control characters and ".." components.
+        std::optional<std::filesystem::path> GetExtractionRelativePath(const pure_zip_cdh& cdh)
+        {
+            std::string_view name{ reinterpret_cast<const char*>(cdh.file_name), static_cast<size_t>(cdh.file_name_length) };
+            if (name.empty() || Filesystem::PathEscapesBaseDirectory(name))
+            {
+                return {};
+            }
+
+            // Names without the UTF-8 flag are in the OEM code page, as the shell treats them.
+            std::optional<std::wstring> wideName = Utility::TryConvertToUTF16(name, (cdh.general_purpose_bit_flag & PURE_ZIP_FLAG_UTF8) ? CP_UTF8 : CP_OEMCP);
+
+            // Reject characters that are not valid in a file name; a colon would otherwise name an alternate data stream.
+            if (!wideName || wideName->find_first_of(L"<>:\"|?*") != std::wstring::npos)
+            {
+                return {};
+            }
+
+            std::filesystem::path result = std::filesystem::path{ wideName.value() }.lexically_normal();
+
+            for (const auto& component : result)
+            {
+                if (IsReservedDeviceName(component.native()))
+                {
+                    return {};
+                }
+            }
+
+            return result;
+        }
+
+        // Extracts a single file; this runs on the extraction workers, so it neither throws nor logs.
+        HRESULT ExtractZipEntry(
+            const uint8_t* buffer,
+            ExtractionItem& item,
+            uint8_t* chunk,
+            uint64_t chunkSize,
+            bool computeHash,
+            std::atomic<uint64_t>& bytesWritten,
+            const std::atomic<bool>& cancelled) try
+        {
+            const pure_zip_cdh& cdh = item.Entry->cdh;
+
+            wil::unique_hfile file{ CreateFileW(item.Path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+            if (!file)
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            // Reserve the space up front so that the file is not extended by every write; this is only a hint.
+            if (cdh.uncompressed_size > 0)
+            {
+                FILE_ALLOCATION_INFO allocation{};
+                allocation.AllocationSize.QuadPart = static_cast<LONGLONG>(cdh.uncompressed_size);
+                SetFileInformationByHandle(file.get(), FileAllocationInfo, &allocation, sizeof(allocation));
+            }
+
+            std::optional<Utility::SHA256> hash;
+            if (computeHash)
+            {
+                hash.emplace();
+            }
+
+            ExtractionSinkContext sinkContext{ file.get(), bytesWritten, cancelled, hash ? &hash.value() : nullptr };
+            if (!TryReadMappedView([&]() { item.ZipResult = pure_zip_stream_extract(buffer, item.Entry, chunk, chunkSize, WriteExtractedData, &sinkContext); }))
+            {
+                return HRESULT_FROM_WIN32(ERROR_READ_FAULT);
+            }
+
+            if (item.ZipResult == PURE_STREAM_E_SINK)
+            {
+                return sinkContext.Result;
+            }
+            else if (item.ZipResult)
+            {
+                return HRESULT_FROM_WIN32(ERROR_FILE_CORRUPT);
+            }
+
+            // The time is always set explicitly, so that it is known without reading it back once the file is closed.
+            FILETIME localFileTime{};
+            if (!DosDateTimeToFileTime(static_cast<WORD>(cdh.last_mod_file_date), static_cast<WORD>(cdh.last_mod_file_time), &localFileTime) ||
+                !LocalFileTimeToFileTime(&localFileTime, &item.LastWriteTime))
+            {
+                GetSystemTimeAsFileTime(&item.LastWriteTime);
+            }
+
+            if (!SetFileTime(file.get(), nullptr, nullptr, &item.LastWriteTime))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            if (hash)
+            {
+                item.Hash = hash->Get();
+            }
+
+            return S_OK;
+        }
+        catch (...)
+        {
+            return wil::ResultFromCaughtException();
+        }
+    }
+
     HRESULT TryExtractArchive(const std::filesystem::path& archivePath, const std::filesystem::path& destPath)
     {
         wil::com_ptr<IFileOperation> pFileOperation;
@@ -49,6 +421,218 @@ namespace AppInstaller::Archive
         return S_OK;
     }
 
+    std::optional<Utility::SHA256::HashBuffer> GetExtractedFileHash(const ExtractedFiles& extractedFiles, const std::filesystem::path& path)
+    {
+        auto itr = extractedFiles.find(path);
+        if (itr == extractedFiles.end())
+        {
+            return {};
+        }
+
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(path, error);
+        if (error || size != itr->second.SizeInBytes)
+        {
+            return {};
+        }
+
+        std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(path, error);
+        if (error || lastWriteTime != itr->second.LastWriteTime)
+        {
+            return {};
+        }
+
+        return itr->second.SHA256;
+    }
+
+    HRESULT TryExtractZipArchive(const std::filesystem::path& archivePath, const std::filesystem::path& destPath, IProgressCallback& progress, ExtractedFiles* extractedFiles)
+    try
+    {
+        MappedFile archive{ archivePath };
+        if (archive.Size() == 0)
+        {
+            AICLI_LOG(Core, Error, << "Archive is empty");
+            return HRESULT_FROM_WIN32(ERROR_BAD_FORMAT);
+        }
+
+        pure_ctx ctx;
+        pure_zip_stream_ctx(&ctx, 0);
+
+        pure_zip_stream_index index{};
+        auto freeIndex = wil::scope_exit([&]() { pure_zip_stream_index_free(&index); });
+
+        int indexResult = 0;
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_READ_FAULT), !TryReadMappedView([&]() { indexResult = pure_zip_stream_index_entries(&ctx, archive.Data(), archive.Size(), &index); }));
+        THROW_HR_IF(E_OUTOFMEMORY, indexResult != 0);
+
+        if (index.error)
+        {
+            AICLI_LOG(Core, Error, << "Archive structure is not valid: " << pure_error_code(index.error));
+            return HRESULT_FROM_WIN32(ERROR_BAD_FORMAT);
+        }
+
+        // Plan the extraction serially; when a name appears more than once, the last entry wins as it would when copying.
+        std::vector<ExtractionItem> items;
+        std::unordered_map<std::string, size_t> itemsByName;
+        std::set<std::filesystem::path> directories;
+        uint64_t compressedSize = 0;
+        uint64_t uncompressedSize = 0;
+        uint64_t fileCount = 0;
+
+        for (uint64_t i = 0; i < index.count; ++i)
+        {
+            pure_zip_stream_entry& entry = index.entries[i];
+
+            std::optional<std::filesystem::path> relativePath = GetExtractionRelativePath(entry.cdh);
+            if (!relativePath)
+            {
+                AICLI_LOG(Core, Error, << "Archive entry cannot be safely extracted: " <<
+                    std::string_view{ reinterpret_cast<const char*>(entry.cdh.file_name), static_cast<size_t>(entry.cdh.file_name_length) });
+                return HRESULT_FROM_WIN32(ERROR_BAD_FORMAT);
+            }
+
+            if (entry.cdh.directory)
+            {
+                directories.emplace(destPath / relativePath.value());
+                continue;
+            }
+
+            if (pure_overflow(compressedSize, entry.cdh.compressed_size, UINT64_MAX) ||
+                pure_overflow(uncompressedSize, entry.cdh.uncompressed_size, UINT64_MAX))
+            {
+                AICLI_LOG(Core, Error, << "Archive sizes overflow");
+                return HRESULT_FROM_WIN32(ERROR_BAD_FORMAT);
+            }
+
+            compressedSize += entry.cdh.compressed_size;
+            uncompressedSize += entry.cdh.uncompressed_size;
+
+            ExtractionItem item;
+            item.Entry = &entry;
+            item.Path = destPath / relativePath.value();
+            directories.emplace(item.Path.parent_path());
+
+            auto [itr, inserted] = itemsByName.emplace(Utility::FoldCase(relativePath->u8string()), items.size());
+            if (inserted)
+            {
+                items.emplace_back(std::move(item));
+                ++fileCount;
+            }
+            else
+            {
+                items[itr->second] = std::move(item);
+            }
+        }
+
+        // The same limits as the scan; the size of each entry is also enforced as it is inflated.
+        int bombResult = fileCount > PURE_FILES_MAX ? PURE_E_ZIP_BOMB_FILES : pure_zip_verify_compression_ratio(compressedSize, uncompressedSize);
+        if (bombResult)
+        {
+            AICLI_LOG(Core, Error, << "Archive exceeds extraction limits: " << pure_error_code(bombResult));
+            return HRESULT_FROM_WIN32(ERROR_BAD_FORMAT);
+        }
+
+        // Create every directory up front, so that the workers only create files.
+        for (const auto& directory : directories)
+        {
+            std::filesystem::create_directories(directory);
+        }
+
+        AICLI_LOG(Core, Info, << "Extracting " << items.size() << " files, " << uncompressedSize << " bytes");
+
+        std::atomic<size_t> next = 0;
+        std::atomic<uint64_t> bytesWritten = 0;
+        std::atomic<bool> failed = false;
+        std::atomic<bool> cancelled = false;
+
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+        size_t threadCount = std::max<size_t>(Utility::GetConcurrentThreadCount(items.size()), 1);
+        size_t running = threadCount;
+
+        auto worker = [&]()
+        {
+            // Always count the worker as done, so that the progress loop below cannot wait forever.
+            auto markDone = wil::scope_exit([&]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ doneMutex };
+                    --running;
+                }
+                doneCondition.notify_all();
+            });
+
+            // Each worker reuses one chunk for every file it inflates.
+            uint8_t* chunk = nullptr;
+            uint64_t chunkSize = 0;
+
+            if (pure_realloc(&chunk, &chunkSize, PURE_STREAM_CHUNK) == 0)
+            {
+                for (size_t i = next++; i < items.size() && !failed && !cancelled; i = next++)
+                {
+                    items[i].Result = ExtractZipEntry(archive.Data(), items[i], chunk, chunkSize, extractedFiles != nullptr, bytesWritten, cancelled);
+                    if (FAILED(items[i].Result))
+                    {
+                        failed = true;
+                    }
+                }
+
+                pure_free(&chunk, &chunkSize);
+            }
+        };
+
+        // The calling thread owns progress, since the callback is not safe to use from the workers.
+        auto monitor = [&]()
+        {
+            std::unique_lock<std::mutex> lock{ doneMutex };
+            while (!doneCondition.wait_for(lock, s_ExtractionProgressInterval, [&]() { return running == 0; }))
+            {
+                progress.OnProgress(bytesWritten, uncompressedSize, ProgressType::Bytes);
+
+                if (progress.IsCancelledBy(CancelReason::Any))
+                {
+                    cancelled = true;
+                }
+            }
+        };
+
+        Utility::RunConcurrently(threadCount, worker, monitor);
+
+        progress.OnProgress(bytesWritten, uncompressedSize, ProgressType::Bytes);
+
+        if (cancelled)
+        {
+            AICLI_LOG(Core, Info, << "Archive extraction cancelled");
+            return E_ABORT;
+        }
+
+        for (const auto& item : items)
+        {
+            if (FAILED(item.Result))
+            {
+                AICLI_LOG(Core, Error, << "Failed to extract " << item.Path << " with 0x" << Logging::SetHRFormat << item.Result <<
+                    (item.ZipResult ? ": " : "") << (item.ZipResult ? pure_stream_error_code(item.ZipResult) : ""));
+                return item.Result;
+            }
+        }
+
+        if (extractedFiles)
+        {
+            for (auto& item : items)
+            {
+                ExtractedFile& extractedFile = (*extractedFiles)[item.Path];
+                extractedFile.SHA256 = std::move(item.Hash);
+                extractedFile.SizeInBytes = item.Entry->cdh.uncompressed_size;
+                // The file clock counts in the same units and from the same epoch as FILETIME.
+                extractedFile.LastWriteTime = std::filesystem::file_time_type{ std::filesystem::file_time_type::duration{
+                    static_cast<int64_t>((static_cast<uint64_t>(item.LastWriteTime.dwHighDateTime) << 32) | item.LastWriteTime.dwLowDateTime) } };
+            }
+        }
+
+        return S_OK;
+    }
+    CATCH_RETURN()
+
 #ifndef AICLI_DISABLE_TEST_HOOKS
     static bool* s_ScanArchiveResult_TestHook_Override = nullptr;
 
@@ -67,12 +651,21 @@ namespace AppInstaller::Archive
         }
 #endif
 
-        std::ifstream instream{ zipPath, std::ios::in | std::ios::binary };
-        std::vector<uint8_t> data{ { std::istreambuf_iterator<char>{ instream } }, std::istreambuf_iterator<char>{} };
+        MappedFile zipFile{ zipPath };
 
-        uint8_t* buffer = &data[0];
-        uint64_t flag = 0;
-        int scanResult = pure_zip(buffer, data.size(), flag);
+        // An empty file is not a zip file either.
+        if (zipFile.Size() == 0)
+        {
+            AICLI_LOG(Core, Warning, << "Archive scan failed: " << pure_error_code(PURE_E_ZIP_TOO_SMALL));
+            return false;
+        }
+
+        int scanResult = ScanZipBuffer(zipFile.Data(), zipFile.Size());
+
+        if (scanResult != 0)
+        {
+            AICLI_LOG(Core, Warning, << "Archive scan failed: " << pure_error_code(scanResult));
+        }
 
         return scanResult == 0;
     }
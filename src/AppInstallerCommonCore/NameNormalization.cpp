@@ -22,6 +22,64 @@ namespace AppInstaller::Utility
             std::wstring Publisher;
         };
 
+        // Prefilters for the normalization expressions.
+        // Most names only match a few of the expressions, and a scan for the characters that an expression
+        // requires is much cheaper than running it. The checks are only valid for values that are entirely ASCII,
+        // as case insensitive matching and the Unicode character classes allow other characters to match.
+        namespace Prefilter
+        {
+            bool IsASCII(std::wstring_view value)
+            {
+                return std::all_of(value.begin(), value.end(), [](wchar_t c) { return c < 0x80; });
+            }
+
+            bool IsLetter(wchar_t c)
+            {
+                return (c >= L'A' && c <= L'Z') || (c >= L'a' && c <= L'z');
+            }
+
+            bool IsLetterOrDigit(wchar_t c)
+            {
+                return IsLetter(c) || (c >= L'0' && c <= L'9');
+            }
+
+            bool ContainsAny(std::wstring_view value, std::wstring_view characters)
+            {
+                return value.find_first_of(characters) != std::wstring_view::npos;
+            }
+
+            bool ContainsDigit(std::wstring_view value)
+            {
+                return ContainsAny(value, L"0123456789");
+            }
+
+            // The search value must be upper case ASCII.
+            bool Contains(std::wstring_view value, std::wstring_view search)
+            {
+                auto found = std::search(value.begin(), value.end(), search.begin(), search.end(),
+                    [](wchar_t a, wchar_t b) { return ((a >= L'a' && a <= L'z') ? static_cast<wchar_t>(a - L'a' + L'A') : a) == b; });
+                return found != value.end();
+            }
+
+            // The prefix must be upper case ASCII.
+            bool StartsWith(std::wstring_view value, std::wstring_view prefix)
+            {
+                return value.length() >= prefix.length() && Contains(value.substr(0, prefix.length()), prefix);
+            }
+        }
+
+        // An expression and a check that returns false when the expression cannot match an ASCII value.
+        struct PrefilteredExpression
+        {
+            const Regex::Expression& Expression;
+            bool (*MayMatchASCII)(std::wstring_view value);
+
+            bool MayMatch(std::wstring_view value, bool isASCII) const
+            {
+                return !isASCII || MayMatchASCII(value);
+            }
+        };
+
         // To maintain consistency, changes that result in different output must be done in a new version.
         // This can potentially be ignored (if thought through) when the changes will only increase the
         // number of matches being made, with no impact to existing matches. For instance, removing an
@@ -80,11 +138,23 @@ namespace AppInstaller::Utility
                 return result;
             }
 
+            // Removes all matches from the input string, unless the prefilter shows that there are none.
+            static bool Remove(const PrefilteredExpression& re, std::wstring& input, bool isASCII)
+            {
+                return re.MayMatch(input, isASCII) && Remove(re.Expression, input);
+            }
+
             // Removes the architecture and returns the value, if any
-            Architecture RemoveArchitecture(std::wstring& value) const
+            Architecture RemoveArchitecture(std::wstring& value, bool isASCII) const
             {
                 Architecture result = Architecture::Unknown;
 
+                // Every architecture expression requires one of these numbers
+                if (isASCII && !Prefilter::Contains(value, L"32") && !Prefilter::Contains(value, L"64") && !Prefilter::Contains(value, L"86"))
+                {
+                    return result;
+                }
+
                 // Must detect this first because "32/64 bit" is a superstring of "64 bit"
                 if (Remove(Architecture32Or64Bit, value))
                 {
@@ -104,24 +174,30 @@ namespace AppInstaller::Utility
             }
 
             // Removes all matches for the given regular expressions
-            static bool RemoveAll(const std::vector<Regex::Expression*>& regexes, std::wstring& value)
+            static bool RemoveAll(const std::vector<PrefilteredExpression>& regexes, std::wstring& value, bool isASCII)
             {
                 bool result = false;
 
                 for (const auto& re : regexes)
                 {
-                    result = Remove(*re, value) || result;
+                    result = Remove(re, value, isASCII) || result;
                 }
 
                 return result;
             }
 
             // Removes all locales and returns the common value, if any
-            std::wstring RemoveLocale(std::wstring& value) const
+            std::wstring RemoveLocale(std::wstring& value, bool isASCII) const
             {
                 bool localeFound = false;
                 std::wstring result;
 
+                // Every locale contains a dash
+                if (isASCII && !Prefilter::ContainsAny(value, L"-"))
+                {
+                    return result;
+                }
+
                 std::wstring newValue;
                 auto newValueInserter = std::back_inserter(newValue);
 
@@ -281,39 +357,57 @@ namespace AppInstaller::Utility
             Regex::Expression ProgramNameSplit{ R"([^\p{L}\p{Nd}\+\&])", reOptions }; // used to separate 'words' in program names
             Regex::Expression PublisherNameSplit{ R"([^\p{L}\p{Nd}])", reOptions }; // used to separate 'words' in publisher names
 
-            const std::vector<Regex::Expression*> ProgramNameRegexes
-            {
-                &Roblox,
-                &Bomgar,
-                &PrefixParens,
-                &EmptyParens,
-                &FilePathGHS,
-                &FilePathParens,
-                &FilePathQuotes,
-                &FilePath,
-                &VersionLetter,
-                &VersionDelimited,
-                &Version,
-                &EN,
-                &NonNestedBracket,
-                &BracketEnclosed,
-                &URIProtocol,
-                &LeadingSymbols,
-                &TrailingSymbols
+            // The prefilters shared between the name and publisher expressions
+            static bool MayMatchFilePath(std::wstring_view value) { return Prefilter::Contains(value, L":\\"); }
+            static bool MayMatchVersion(std::wstring_view value) { return Prefilter::ContainsDigit(value); }
+            static bool MayMatchNonNestedBracket(std::wstring_view value) { return Prefilter::ContainsAny(value, L"(["); }
+            static bool MayMatchBracketEnclosed(std::wstring_view value) { return Prefilter::ContainsAny(value, L"([{\""); }
+            static bool MayMatchURIProtocol(std::wstring_view value) { return Prefilter::Contains(value, L"://"); }
+
+            const std::vector<PrefilteredExpression> ProgramNameRegexes
+            {
+                { Roblox, [](std::wstring_view value) { return Prefilter::StartsWith(value, L"ROBLOX"); } },
+                { Bomgar, [](std::wstring_view value) { return Prefilter::StartsWith(value, L"BOMGAR") || Prefilter::StartsWith(value, L"EMBEDDED CALLBACK"); } },
+                { PrefixParens, [](std::wstring_view value) { return !value.empty() && value[0] == L'('; } },
+                { EmptyParens, [](std::wstring_view value) { return Prefilter::ContainsAny(value, L"([\""); } },
+                { FilePathGHS, MayMatchFilePath },
+                { FilePathParens, MayMatchFilePath },
+                { FilePathQuotes, MayMatchFilePath },
+                { FilePath, MayMatchFilePath },
+                { VersionLetter, MayMatchVersion },
+                { VersionDelimited, MayMatchVersion },
+                { Version, MayMatchVersion },
+                { EN, [](std::wstring_view value) { return Prefilter::Contains(value, L"EN"); } },
+                { NonNestedBracket, MayMatchNonNestedBracket },
+                { BracketEnclosed, MayMatchBracketEnclosed },
+                { URIProtocol, MayMatchURIProtocol },
+                { LeadingSymbols, [](std::wstring_view value) { return !value.empty() && !Prefilter::IsLetterOrDigit(value.front()); } },
+                { TrailingSymbols, [](std::wstring_view value) { return !value.empty() && !Prefilter::IsLetterOrDigit(value.back()); } },
             };
 
-            const std::vector<Regex::Expression*> PublisherNameRegexes
+            const std::vector<PrefilteredExpression> PublisherNameRegexes
             {
-                &VersionDelimited,
-                &Version,
-                &NonNestedBracket,
-                &BracketEnclosed,
-                &URIProtocol,
-                &NonLetters,
-                &TrailingNonLetters,
-                &AcronymSeparators
+                { VersionDelimited, MayMatchVersion },
+                { Version, MayMatchVersion },
+                { NonNestedBracket, MayMatchNonNestedBracket },
+                { BracketEnclosed, MayMatchBracketEnclosed },
+                { URIProtocol, MayMatchURIProtocol },
+                { NonLetters, [](std::wstring_view value) { return !std::all_of(value.begin(), value.end(), Prefilter::IsLetter); } },
+                { TrailingNonLetters, [](std::wstring_view value) { return !value.empty() && !Prefilter::IsLetter(value.back()); } },
+                { AcronymSeparators, [](std::wstring_view value) { return Prefilter::ContainsAny(value, L"./"); } },
             };
 
+            // Removes the characters that are not kept in the final value, if there are any.
+            static void RemoveUndesiredCharacters(const Regex::Expression& re, std::wstring& value, bool isASCII, bool keepSpaces)
+            {
+                if (isASCII && std::all_of(value.begin(), value.end(), [&](wchar_t c) { return Prefilter::IsLetterOrDigit(c) || (keepSpaces && c == L' '); }))
+                {
+                    return;
+                }
+
+                Remove(re, value);
+            }
+
             // Add values here but use Locales in code.
             const std::vector<std::wstring_view> LocaleViews
             {
@@ -374,20 +468,26 @@ namespace AppInstaller::Utility
                 result.Name = PrepareForValidation(name);
                 while (Unwrap(result.Name)); // remove wrappers
 
+                // Every step only removes characters, so an ASCII value remains so throughout
+                bool isASCII = Prefilter::IsASCII(result.Name);
+
                 // handle (large majority of) SAP Business Object programs
-                if (SAPPackage.IsMatch(result.Name))
+                if ((!isASCII || Prefilter::ContainsAny(result.Name, L"-")) && SAPPackage.IsMatch(result.Name))
                 {
                     return result;
                 }
 
-                result.Architecture = RemoveArchitecture(result.Name);
-                result.Locale = RemoveLocale(result.Name);
+                result.Architecture = RemoveArchitecture(result.Name, isASCII);
+                result.Locale = RemoveLocale(result.Name, isASCII);
 
                 // Extract KB numbers from their parens and preserve them
-                result.Name = KBNumbers.Replace(result.Name, L"$1");
+                if (!isASCII || Prefilter::Contains(result.Name, L"(KB"))
+                {
+                    result.Name = KBNumbers.Replace(result.Name, L"$1");
+                }
 
                 // Repeatedly remove matches for the regexes to create the minimum name
-                while (RemoveAll(ProgramNameRegexes, result.Name));
+                while (RemoveAll(ProgramNameRegexes, result.Name, isASCII));
 
                 auto tokens = Split(ProgramNameSplit, result.Name, LegalEntitySuffixes);
 
@@ -395,12 +495,12 @@ namespace AppInstaller::Utility
                 if (PreserveWhiteSpace)
                 {
                     result.Name = Join(tokens, L" ");
-                    Remove(NonLetterDigitOrSpace, result.Name);
+                    RemoveUndesiredCharacters(NonLetterDigitOrSpace, result.Name, isASCII, true);
                 }
                 else
                 {
                     result.Name = Join(tokens);
-                    Remove(NonLettersAndDigits, result.Name);
+                    RemoveUndesiredCharacters(NonLettersAndDigits, result.Name, isASCII, false);
                 }
 
                 return result;
@@ -413,7 +513,9 @@ namespace AppInstaller::Utility
                 result.Publisher = PrepareForValidation(publisher);
                 while (Unwrap(result.Publisher)); // remove wrappers
 
-                while (RemoveAll(PublisherNameRegexes, result.Publisher));
+                bool isASCII = Prefilter::IsASCII(result.Publisher);
+
+                while (RemoveAll(PublisherNameRegexes, result.Publisher, isASCII));
 
                 auto tokens = Split(PublisherNameSplit, result.Publisher, LegalEntitySuffixes, true);
 
@@ -421,12 +523,12 @@ namespace AppInstaller::Utility
                 if (PreserveWhiteSpace)
                 {
                     result.Publisher = Join(tokens, L" ");
-                    Remove(NonLetterDigitOrSpace, result.Publisher);
+                    RemoveUndesiredCharacters(NonLetterDigitOrSpace, result.Publisher, isASCII, true);
                 }
                 else
                 {
                     result.Publisher = Join(tokens);
-                    Remove(NonLettersAndDigits, result.Publisher);
+                    RemoveUndesiredCharacters(NonLettersAndDigits, result.Publisher, isASCII, false);
                 }
 
                 return result;
@@ -470,9 +572,97 @@ namespace AppInstaller::Utility
                 return ConvertToUTF8(pubResult.Publisher);
             }
         };
+
+        // The process wide cache of normalization results.
+        // The same names and publishers are normalized when building the installed index, when searching it, and when correlating.
+        struct NormalizationCache
+        {
+            // Bounds the memory used by the cache; it is emptied when full rather than tracking usage.
+            constexpr static size_t s_MaximumEntries = 16 * 1024;
+
+            enum class Operation : uint8_t
+            {
+                Normalize,
+                NormalizeName,
+                NormalizePublisher,
+            };
+
+            static NormalizationCache& Instance()
+            {
+                static NormalizationCache s_instance;
+                return s_instance;
+            }
+
+            template <typename Normalizer>
+            NormalizedName Get(NormalizationVersion version, Operation operation, std::string_view name, std::string_view publisher, Normalizer&& normalizer)
+            {
+                std::string key = CreateKey(version, operation, name, publisher);
+
+                {
+                    auto sharedLock = m_lock.lock_shared();
+
+                    auto itr = m_entries.find(key);
+                    if (itr != m_entries.end())
+                    {
+                        ++m_hits;
+                        return itr->second;
+                    }
+                }
+
+                ++m_misses;
+                NormalizedName result = normalizer();
+
+                {
+                    auto exclusiveLock = m_lock.lock_exclusive();
+
+                    if (m_entries.size() >= s_MaximumEntries)
+                    {
+                        m_entries.clear();
+                    }
+
+                    m_entries.emplace(std::move(key), result);
+                }
+
+                return result;
+            }
+
+            NameNormalizationCacheStatistics GetStatistics()
+            {
+                NameNormalizationCacheStatistics result;
+                result.Hits = m_hits;
+                result.Misses = m_misses;
+
+                auto sharedLock = m_lock.lock_shared();
+                result.Entries = m_entries.size();
+
+                return result;
+            }
+
+        private:
+            // The name is length prefixed so that the boundary with the publisher is unambiguous.
+            static std::string CreateKey(NormalizationVersion version, Operation operation, std::string_view name, std::string_view publisher)
+            {
+                size_t nameSize = name.size();
+
+                std::string result;
+                result.reserve(2 + sizeof(nameSize) + name.size() + publisher.size());
+                result.push_back(static_cast<char>(version));
+                result.push_back(static_cast<char>(operation));
+                result.append(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+                result.append(name);
+                result.append(publisher);
+
+                return result;
+            }
+
+            wil::srwlock m_lock;
+            std::unordered_map<std::string, NormalizedName> m_entries;
+            std::atomic<uint64_t> m_hits{ 0 };
+            std::atomic<uint64_t> m_misses{ 0 };
+        };
     }
 
-    NameNormalizer::NameNormalizer(NormalizationVersion version)
+    NameNormalizer::NameNormalizer(NormalizationVersion version) : m_version(version)
     {
         switch (version)
         {
@@ -489,17 +679,32 @@ namespace AppInstaller::Utility
 
     NormalizedName NameNormalizer::Normalize(std::string_view name, std::string_view publisher) const
     {
-        return m_normalizer->Normalize(name, publisher);
+        return NormalizationCache::Instance().Get(m_version, NormalizationCache::Operation::Normalize, name, publisher,
+            [&]() { return m_normalizer->Normalize(name, publisher); });
     }
 
     NormalizedName NameNormalizer::NormalizeName(std::string_view name) const
     {
-        return m_normalizer->NormalizeName(name);
+        return NormalizationCache::Instance().Get(m_version, NormalizationCache::Operation::NormalizeName, name, {},
+            [&]() { return m_normalizer->NormalizeName(name); });
     }
 
     std::string NameNormalizer::NormalizePublisher(std::string_view publisher) const
     {
-        return m_normalizer->NormalizePublisher(publisher);
+        NormalizedName result = NormalizationCache::Instance().Get(m_version, NormalizationCache::Operation::NormalizePublisher, {}, publisher,
+            [&]()
+            {
+                NormalizedName normalized;
+                normalized.Publisher(m_normalizer->NormalizePublisher(publisher));
+                return normalized;
+            });
+
+        return result.Publisher();
+    }
+
+    NameNormalizationCacheStatistics NameNormalizer::GetCacheStatistics()
+    {
+        return NormalizationCache::Instance().GetStatistics();
     }
 
     std::string NormalizedName::GetNormalizedName(NormalizationField fieldsToInclude) const
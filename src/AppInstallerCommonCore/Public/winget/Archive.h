@@ -1,7 +1,11 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 #pragma once
+#include <AppInstallerProgress.h>
+#include <AppInstallerSHA256.h>
 #include <filesystem>
+#include <map>
+#include <optional>
 
 namespace AppInstaller::Archive
 {
@@ -10,9 +14,31 @@ namespace AppInstaller::Archive
         // Default archive extraction method is ShellApi.
         ShellApi,
         Tar,
+        Native,
     };
 
+    // A file written by TryExtractZipArchive, with its hash computed as it was written.
+    struct ExtractedFile
+    {
+        Utility::SHA256::HashBuffer SHA256;
+        uint64_t SizeInBytes = 0;
+        std::filesystem::file_time_type LastWriteTime;
+    };
+
+    // The files written by TryExtractZipArchive, by full path.
+    using ExtractedFiles = std::map<std::filesystem::path, ExtractedFile>;
+
+    // Gets the hash recorded for the file when it was extracted, if its size and last write time show it has not changed since.
+    std::optional<Utility::SHA256::HashBuffer> GetExtractedFileHash(const ExtractedFiles& extractedFiles, const std::filesystem::path& path);
+
+    // Extracts the archive using the Windows Shell API.
     HRESULT TryExtractArchive(const std::filesystem::path& archivePath, const std::filesystem::path& destPath);
 
+    // Extracts the zip archive, inflating its files concurrently and reporting progress in bytes.
+    // The archive is rejected if it does not pass the same structural and zip bomb checks as ScanZipFile,
+    // or if any of its paths would be written outside of the destination.
+    // If extractedFiles is given, the SHA256 of each file is computed while it is written and recorded there.
+    HRESULT TryExtractZipArchive(const std::filesystem::path& archivePath, const std::filesystem::path& destPath, IProgressCallback& progress, ExtractedFiles* extractedFiles = nullptr);
+
     bool ScanZipFile(const std::filesystem::path& zipPath);
 }
@@ -61,6 +61,14 @@ namespace AppInstaller::Utility
         std::string m_publisher;
     };
 
+    // Statistics for the process wide cache of normalization results.
+    struct NameNormalizationCacheStatistics
+    {
+        uint64_t Hits = 0;
+        uint64_t Misses = 0;
+        size_t Entries = 0;
+    };
+
     namespace details
     {
         // NameNormalizer interface to allow different versions.
@@ -81,6 +89,8 @@ namespace AppInstaller::Utility
 
     // Helper that manages the lifetime of the internals required to
     // execute the name normalization.
+    // Results are cached for the process, shared by all normalizers of the same version, so that
+    // each distinct value is only normalized once.
     struct NameNormalizer
     {
         NameNormalizer(NormalizationVersion version);
@@ -89,7 +99,11 @@ namespace AppInstaller::Utility
         NormalizedName NormalizeName(std::string_view name) const;
         std::string NormalizePublisher(std::string_view publisher) const;
 
+        // Gets the statistics for the process wide cache of normalization results.
+        static NameNormalizationCacheStatistics GetCacheStatistics();
+
     private:
+        NormalizationVersion m_version;
         std::unique_ptr<details::INameNormalizer> m_normalizer;
     };
 }
@@ -133,6 +133,8 @@ namespace AppInstaller::Settings
         LoggingFileTotalSizeLimitInMB,
         LoggingFileIndividualSizeLimitInMB,
         LoggingFileCountLimit,
+        LoggingSQLProfile,
+        LoggingSQLSlowStatementThresholdInMs,
         // Uninstall behavior
         UninstallPurgePortablePackage,
         // Download behavior
@@ -237,6 +239,8 @@ namespace AppInstaller::Settings
         SETTINGMAPPING_SPECIALIZATION(Setting::LoggingFileTotalSizeLimitInMB, uint32_t, uint32_t, 128, ".logging.file.totalSizeLimitInMB"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::LoggingFileIndividualSizeLimitInMB, uint32_t, uint32_t, 16, ".logging.file.individualSizeLimitInMB"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::LoggingFileCountLimit, uint32_t, uint32_t, 0, ".logging.file.countLimit"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::LoggingSQLProfile, bool, bool, false, ".logging.sql.profile"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::LoggingSQLSlowStatementThresholdInMs, uint32_t, std::chrono::milliseconds, 100ms, ".logging.sql.slowStatementThresholdInMs"sv);
         // Interactivity
         SETTINGMAPPING_SPECIALIZATION(Setting::InteractivityDisable, bool, bool, false, ".interactivity.disable"sv);
         // Output behavior
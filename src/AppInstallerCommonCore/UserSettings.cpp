@@ -299,6 +299,7 @@ namespace AppInstaller::Settings
         WINGET_VALIDATE_PASS_THROUGH(LoggingFileTotalSizeLimitInMB)
         WINGET_VALIDATE_PASS_THROUGH(LoggingFileIndividualSizeLimitInMB)
         WINGET_VALIDATE_PASS_THROUGH(LoggingFileCountLimit)
+        WINGET_VALIDATE_PASS_THROUGH(LoggingSQLProfile)
 
 #ifndef AICLI_DISABLE_TEST_HOOKS
         WINGET_VALIDATE_PASS_THROUGH(EnableSelfInitiatedMinidump)
@@ -319,6 +320,7 @@ namespace AppInstaller::Settings
         {
             static constexpr std::string_view s_archiveExtractionMethod_shellApi = "shellApi";
             static constexpr std::string_view s_archiveExtractionMethod_tar = "tar";
+            static constexpr std::string_view s_archiveExtractionMethod_native = "native";
 
             if (Utility::CaseInsensitiveEquals(value, s_archiveExtractionMethod_tar))
             {
@@ -328,6 +330,10 @@ namespace AppInstaller::Settings
             {
                 return Archive::ExtractionMethod::ShellApi;
             }
+            else if (Utility::CaseInsensitiveEquals(value, s_archiveExtractionMethod_native))
+            {
+                return Archive::ExtractionMethod::Native;
+            }
 
             return {};
         }
@@ -530,6 +536,11 @@ namespace AppInstaller::Settings
             return value * 24h;
         }
 
+        WINGET_VALIDATE_SIGNATURE(LoggingSQLSlowStatementThresholdInMs)
+        {
+            return std::chrono::milliseconds(value);
+        }
+
         WINGET_VALIDATE_SIGNATURE(OutputSortOrder)
         {
             std::vector<SortField> fields;
@@ -36,6 +36,7 @@
 #pragma warning( pop )
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cwctype>
@@ -57,6 +58,7 @@
 #include <stack>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <variant>
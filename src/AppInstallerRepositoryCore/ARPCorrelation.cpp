@@ -7,6 +7,7 @@
 #include "winget/NameNormalization.h"
 #include "winget/RepositorySearch.h"
 #include "winget/RepositorySource.h"
+#include "Microsoft/ARPHelper.h"
 
 using namespace AppInstaller::Manifest;
 using namespace AppInstaller::Repository;
@@ -19,6 +20,51 @@ namespace AppInstaller::Repository::Correlation
         constexpr double MatchingThreshold = 0.5;
         constexpr double MinimumDifferentiationThreshold = 0.05;
 
+        struct ARPEntrySnapshotHash
+        {
+            size_t operator()(const ARPEntrySnapshot& snapshot) const noexcept
+            {
+                size_t result = std::hash<std::string>{}(snapshot.Id);
+                result = result * 31 + std::hash<uint64_t>{}(snapshot.LastWriteTime);
+                result = result * 31 + std::hash<std::string>{}(snapshot.DisplayVersion);
+                return result;
+            }
+        };
+
+        struct RegistryARPEntrySnapshotEnumerator : public IARPEntrySnapshotEnumerator
+        {
+            std::vector<ARPEntrySnapshot> Enumerate() const override
+            {
+                std::vector<ARPEntrySnapshot> result;
+
+                Microsoft::ARPHelper arpHelper;
+                arpHelper.AddEntrySnapshotsFromARP(result, Manifest::ScopeEnum::Machine);
+                arpHelper.AddEntrySnapshotsFromARP(result, Manifest::ScopeEnum::User);
+
+                return result;
+            }
+        };
+
+        IARPEntrySnapshotEnumerator& EnumeratorInstanceInternal(std::optional<IARPEntrySnapshotEnumerator*> enumeratorOverride = {})
+        {
+            static RegistryARPEntrySnapshotEnumerator s_enumerator;
+            static IARPEntrySnapshotEnumerator* s_override = nullptr;
+
+            if (enumeratorOverride.has_value())
+            {
+                s_override = enumeratorOverride.value();
+            }
+
+            if (s_override)
+            {
+                return *s_override;
+            }
+            else
+            {
+                return s_enumerator;
+            }
+        }
+
         IARPMatchConfidenceAlgorithm& InstanceInternal(std::optional<IARPMatchConfidenceAlgorithm*> algorithmOverride = {})
         {
             static WordsEditDistanceMatchConfidenceAlgorithm s_algorithm;
@@ -57,6 +103,28 @@ namespace AppInstaller::Repository::Correlation
     }
 #endif
 
+    bool ARPEntrySnapshot::operator==(const ARPEntrySnapshot& other) const
+    {
+        return LastWriteTime == other.LastWriteTime && Id == other.Id && DisplayVersion == other.DisplayVersion;
+    }
+
+    IARPEntrySnapshotEnumerator& IARPEntrySnapshotEnumerator::Instance()
+    {
+        return EnumeratorInstanceInternal();
+    }
+
+#ifndef AICLI_DISABLE_TEST_HOOKS
+    void IARPEntrySnapshotEnumerator::OverrideInstance(IARPEntrySnapshotEnumerator* enumeratorOverride)
+    {
+        EnumeratorInstanceInternal(enumeratorOverride);
+    }
+
+    void IARPEntrySnapshotEnumerator::ResetInstance()
+    {
+        EnumeratorInstanceInternal(nullptr);
+    }
+#endif
+
     // Find the best match using heuristics
     ARPHeuristicsCorrelationResult FindARPEntryForNewlyInstalledPackageWithHeuristics(
         const Manifest::Manifest& manifest,
@@ -116,27 +184,29 @@ namespace AppInstaller::Repository::Correlation
 
     void ARPCorrelationData::CapturePreInstallSnapshot()
     {
-        ProgressCallback empty;
-        Repository::Source preInstallARP = Repository::Source(PredefinedSource::ARP);
-        preInstallARP.Open(empty);
+        // Only the lightweight snapshots are needed to detect changes, so avoid building the ARP source here.
+        m_preInstallSnapshot = IARPEntrySnapshotEnumerator::Instance().Enumerate();
+    }
+
+    void ARPCorrelationData::CapturePostInstallSnapshot()
+    {
+        std::unordered_set<std::string> changedIds;
 
-        for (const auto& entry : preInstallARP.Search({}).Matches)
         {
-            auto installed = entry.Package->GetInstalled()->GetLatestVersion();
-            if (installed)
+            std::unordered_set<ARPEntrySnapshot, ARPEntrySnapshotHash> preInstallSnapshot{ m_preInstallSnapshot.begin(), m_preInstallSnapshot.end() };
+
+            for (auto& snapshot : IARPEntrySnapshotEnumerator::Instance().Enumerate())
             {
-                m_preInstallSnapshot.emplace_back(std::make_tuple(
-                    installed->GetProperty(PackageVersionProperty::Id),
-                    installed->GetProperty(PackageVersionProperty::Version),
-                    installed->GetProperty(PackageVersionProperty::Channel)));
+                if (preInstallSnapshot.find(snapshot) == preInstallSnapshot.end())
+                {
+                    changedIds.emplace(std::move(snapshot.Id));
+                }
             }
         }
 
-        std::sort(m_preInstallSnapshot.begin(), m_preInstallSnapshot.end());
-    }
+        AICLI_LOG(Repo, Verbose, << "Found " << changedIds.size() << " new or changed ARP entries");
 
-    void ARPCorrelationData::CapturePostInstallSnapshot()
-    {
+        // The full source is still required, as correlation searches and scores every entry.
         ProgressCallback empty;
         m_postInstallSnapshotSource = Repository::Source(PredefinedSource::ARP);
         m_postInstallSnapshotSource.Open(empty);
@@ -147,13 +217,8 @@ namespace AppInstaller::Repository::Correlation
 
             if (installed)
             {
-                auto entryKey = std::make_tuple(
-                    installed->GetProperty(PackageVersionProperty::Id),
-                    installed->GetProperty(PackageVersionProperty::Version),
-                    installed->GetProperty(PackageVersionProperty::Channel));
-
-                auto itr = std::lower_bound(m_preInstallSnapshot.begin(), m_preInstallSnapshot.end(), entryKey);
-                m_postInstallSnapshot.emplace_back(entry.Package->GetInstalled(), itr == m_preInstallSnapshot.end() || *itr != entryKey);
+                bool isNewOrUpdated = changedIds.find(installed->GetProperty(PackageVersionProperty::Id).get()) != changedIds.end();
+                m_postInstallSnapshot.emplace_back(entry.Package->GetInstalled(), isNewOrUpdated);
             }
         }
     }
@@ -13,89 +13,91 @@ namespace AppInstaller::Repository::Correlation
 
     namespace
     {
-        // A simple matrix class to hold score tables without having to allocate multiple arrays.
-        struct Matrix
-        {
-            Matrix(size_t rows, size_t columns) : m_rows(rows), m_columns(columns), m_data(rows* columns) {}
-
-            double& At(size_t i, size_t j)
-            {
-                return m_data[i * m_columns + j];
-            }
+        using WordIdSequence = std::vector<uint32_t>;
 
-        private:
-            size_t m_rows;
-            size_t m_columns;
-            std::vector<double> m_data;
-        };
+        // The id given to all of the words that are not in the manifest.
+        constexpr uint32_t UnknownWordId = std::numeric_limits<uint32_t>::max();
 
-        double EditDistanceScore(const std::vector<std::string>& s1, const std::vector<std::string>& s2)
+        // Gets the length of the longest common subsequence of the two sequences.
+        size_t LongestCommonSubsequence(const WordIdSequence& s1, const WordIdSequence& s2)
         {
-            // Naive implementation of edit distance (scaled over the sequence size).
-            // This considers only the operations of adding and removing elements.
+            const WordIdSequence& shorter = s1.size() <= s2.size() ? s1 : s2;
+            const WordIdSequence& longer = s1.size() <= s2.size() ? s2 : s1;
 
-            if (s1.empty() || s2.empty())
+            if (shorter.size() <= 64)
             {
-                return 0;
-            }
-
-            // distance[i, j] = distance between s1[0:i] and s2[0:j]
-            // We don't need to hold more than two rows at a time, but it's simpler to keep the whole table.
-            Matrix distance(s1.size() + 1, s2.size() + 1);
+                // Bit-parallel algorithm (Hyyro); each bit represents an element of the shorter sequence,
+                // and the zero bits at the end mark the elements that are part of the common subsequence.
+                uint64_t v = ~0ull;
 
-            for (size_t i = 0; i < s1.size(); ++i)
-            {
-                for (size_t j = 0; j < s2.size(); ++j)
+                for (uint32_t word : longer)
                 {
-                    double& d = distance.At(i, j);
-                    if (s1[i] == s2[j])
+                    uint64_t matches = 0;
+                    for (size_t i = 0; i < shorter.size(); ++i)
                     {
-                        // If the two elements are equal, the distance is the same as from one element before.
-                        // In case we are on the first element of one of the two sequences, the distance is
-                        // equal to the cost of adding all the previous elements in the other
-                        if (i == 0)
+                        if (shorter[i] == word)
                         {
-                            d = static_cast<double>(j);
-                        }
-                        else if (j == 0)
-                        {
-                            d = static_cast<double>(i);
-                        }
-                        else
-                        {
-                            d = distance.At(i - 1, j - 1);
-                        }
-                    }
-                    else
-                    {
-                        // If the two elements are distinct, the score is the cost of removing the last element
-                        // in one sequence plus the cost of editing the remainder of both.
-                        if (i > 0 && j > 0)
-                        {
-                            d = 1 + std::min(distance.At(i - 1, j), distance.At(i, j - 1));
-                        }
-                        else if (i > 0)
-                        {
-                            d = 1 + distance.At(i - 1, j);
-                        }
-                        else if (j > 0)
-                        {
-                            d = 1 + distance.At(i, j - 1);
-                        }
-                        else
-                        {
-                            // Remove one and add the other
-                            d = 2;
+                            matches |= 1ull << i;
                         }
                     }
+
+                    uint64_t u = v & matches;
+                    v = (v + u) | (v - u);
+                }
+
+                uint64_t mask = shorter.size() == 64 ? ~0ull : (1ull << shorter.size()) - 1;
+                return std::bitset<64>(~v & mask).count();
+            }
+
+            // Two rows of the usual dynamic programming table
+            std::vector<size_t> previous(shorter.size() + 1);
+            std::vector<size_t> current(shorter.size() + 1);
+
+            for (uint32_t word : longer)
+            {
+                for (size_t i = 0; i < shorter.size(); ++i)
+                {
+                    current[i + 1] = shorter[i] == word ? previous[i] + 1 : std::max(previous[i + 1], current[i]);
                 }
+
+                std::swap(previous, current);
             }
 
+            return previous[shorter.size()];
+        }
+
+        // Scales the edit distance for sequences of the given sizes with the given common subsequence length.
+        double EditDistanceScore(size_t size1, size_t size2, size_t commonLength)
+        {
+            // The edit distance considers only the operations of adding and removing elements,
+            // so it is the elements that are not in the longest common subsequence of both.
             // Maximum distance is equal to the sum of both lengths (removing all elements from one and adding all the elements from the other).
             // We use that to scale to [0,1].
             // A smaller distance represents a higher match, so we subtract from 1 for the final score
-            double editDistance = distance.At(s1.size() - 1, s2.size() - 1);
-            return 1 - editDistance / (static_cast<uint64_t>(s1.size()) + static_cast<uint64_t>(s2.size()));
+            uint64_t totalSize = static_cast<uint64_t>(size1) + static_cast<uint64_t>(size2);
+            double editDistance = static_cast<double>(totalSize - 2 * static_cast<uint64_t>(commonLength));
+            return 1 - editDistance / totalSize;
+        }
+
+        double EditDistanceScore(const WordIdSequence& s1, const WordIdSequence& s2)
+        {
+            if (s1.empty() || s2.empty())
+            {
+                return 0;
+            }
+
+            return EditDistanceScore(s1.size(), s2.size(), LongestCommonSubsequence(s1, s2));
+        }
+
+        // Gets a score that is at least the edit distance score of the sequences, looking only at their sizes.
+        double EditDistanceScoreUpperBound(const WordIdSequence& s1, const WordIdSequence& s2)
+        {
+            if (s1.empty() || s2.empty())
+            {
+                return 0;
+            }
+
+            return EditDistanceScore(s1.size(), s2.size(), std::min(s1.size(), s2.size()));
         }
     }
 
@@ -116,6 +118,7 @@ namespace AppInstaller::Repository::Correlation
     {
         // We will use the name and publisher from each localization.
         m_namesAndPublishers.clear();
+        m_wordIds.clear();
 
         WordSequence defaultPublisher;
         if (manifest.DefaultLocalization.Contains(Manifest::Localization::Publisher))
@@ -126,7 +129,7 @@ namespace AppInstaller::Repository::Correlation
         if (manifest.DefaultLocalization.Contains(Manifest::Localization::PackageName))
         {
             WordSequence defaultName = NormalizeAndPrepareName(manifest.DefaultLocalization.Get<Manifest::Localization::PackageName>());
-            m_namesAndPublishers.emplace_back(defaultName, defaultPublisher);
+            AddManifestNameAndPublisher(NameAndPublisher{ defaultName, defaultPublisher });
 
             for (const auto& loc : manifest.Localizations)
             {
@@ -135,7 +138,7 @@ namespace AppInstaller::Repository::Correlation
                     auto name = loc.Contains(Manifest::Localization::PackageName) ? NormalizeAndPrepareName(loc.Get<Manifest::Localization::PackageName>()) : defaultName;
                     auto publisher = loc.Contains(Manifest::Localization::Publisher) ? NormalizeAndPreparePublisher(loc.Get<Manifest::Localization::Publisher>()) : defaultPublisher;
 
-                    m_namesAndPublishers.emplace_back(std::move(name), std::move(publisher));
+                    AddManifestNameAndPublisher(NameAndPublisher{ std::move(name), std::move(publisher) });
                 }
             }
         }
@@ -144,14 +147,39 @@ namespace AppInstaller::Repository::Correlation
     double WordsEditDistanceMatchConfidenceAlgorithm::ComputeConfidence(const ARPEntry& arpEntry) const
     {
         // Name and Publisher are available as multi properties, but for ARP entries there will only be 0 or 1 values.
-        NameAndPublisher arpNameAndPublisher(
+        NameAndPublisher arpWords(
             NormalizeAndPrepareName(arpEntry.Entry->GetLatestVersion()->GetProperty(PackageVersionProperty::Name).get()),
             NormalizeAndPreparePublisher(arpEntry.Entry->GetLatestVersion()->GetProperty(PackageVersionProperty::Publisher).get()));
 
+        InternedNameAndPublisher arpNameAndPublisher{ GetWordIds(arpWords.Name), GetWordIds(arpWords.Publisher), GetWordIds(arpWords.NamePublisher) };
+
+        // If no word of the name is in the manifest, the name score is 0 for every localization and none of them can match.
+        if (std::all_of(arpNameAndPublisher.Name.begin(), arpNameAndPublisher.Name.end(), [](uint32_t id) { return id == UnknownWordId; }))
+        {
+            return (arpEntry.IsNewOrUpdated ? 1 : 0) * (1 - m_stringMatchingWeight);
+        }
+
         // Get the best score across all localizations
         double bestMatchingScore = 0;
         for (const auto& manifestNameAndPublisher : m_namesAndPublishers)
         {
+            // Skip the localization if even sharing every word could not reach the name threshold, or could not beat the best score so far.
+            auto nameScoreBound = EditDistanceScoreUpperBound(manifestNameAndPublisher.Name, arpNameAndPublisher.Name);
+            if (nameScoreBound < m_nameMatchingScoreMinThreshold)
+            {
+                continue;
+            }
+
+            auto scoreBound = std::max(
+                nameScoreBound * m_nameMatchingScoreWeight + EditDistanceScoreUpperBound(manifestNameAndPublisher.Publisher, arpNameAndPublisher.Publisher) * (1 - m_nameMatchingScoreWeight),
+                std::max(
+                    EditDistanceScoreUpperBound(manifestNameAndPublisher.NamePublisher, arpNameAndPublisher.Name),
+                    EditDistanceScoreUpperBound(manifestNameAndPublisher.Name, arpNameAndPublisher.NamePublisher)));
+            if (scoreBound <= bestMatchingScore)
+            {
+                continue;
+            }
+
             // Sometimes the publisher may be included in the name, for example Microsoft PowerToys as opposed to simply PowerToys.
             // This may happen both in the ARP entry and the manifest. We try adding it in case it is in one but not in both.
             auto nameScore = EditDistanceScore(manifestNameAndPublisher.Name, arpNameAndPublisher.Name);
@@ -180,6 +208,41 @@ namespace AppInstaller::Repository::Correlation
         return result;
     }
 
+    void WordsEditDistanceMatchConfidenceAlgorithm::AddManifestNameAndPublisher(const NameAndPublisher& nameAndPublisher)
+    {
+        auto internWords = [&](const WordSequence& words)
+        {
+            WordIdSequence result;
+            result.reserve(words.size());
+
+            for (const auto& word : words)
+            {
+                result.emplace_back(m_wordIds.try_emplace(word, static_cast<uint32_t>(m_wordIds.size())).first->second);
+            }
+
+            return result;
+        };
+
+        m_namesAndPublishers.emplace_back(InternedNameAndPublisher{
+            internWords(nameAndPublisher.Name),
+            internWords(nameAndPublisher.Publisher),
+            internWords(nameAndPublisher.NamePublisher) });
+    }
+
+    WordsEditDistanceMatchConfidenceAlgorithm::WordIdSequence WordsEditDistanceMatchConfidenceAlgorithm::GetWordIds(const WordSequence& words) const
+    {
+        WordIdSequence result;
+        result.reserve(words.size());
+
+        for (const auto& word : words)
+        {
+            auto itr = m_wordIds.find(word);
+            result.emplace_back(itr == m_wordIds.end() ? UnknownWordId : itr->second);
+        }
+
+        return result;
+    }
+
     WordSequence WordsEditDistanceMatchConfidenceAlgorithm::PrepareString(std::string_view s) const
     {
         return Utility::SplitIntoWords(Utility::FoldCase(s));
@@ -0,0 +1,299 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "winget/CompletionIndex.h"
+#include <AppInstallerStrings.h>
+
+namespace AppInstaller::Repository
+{
+    namespace
+    {
+        // The file is a header, followed by a header for each field, the entries of each field sorted by key, and then the strings.
+        // All offsets are from the start of the file, except for those of the entries, which are from the start of the strings.
+        constexpr uint32_t s_CompletionIndex_Magic = 0x49434757; // "WGCI"
+        constexpr uint32_t s_CompletionIndex_Version = 1;
+
+        struct FileHeader
+        {
+            uint32_t Magic;
+            uint32_t Version;
+            uint32_t FieldCount;
+            uint32_t Reserved;
+            uint64_t StringsOffset;
+            uint64_t StringsSize;
+        };
+
+        struct FieldHeader
+        {
+            uint32_t Field;
+            uint32_t EntryCount;
+            uint64_t EntriesOffset;
+        };
+
+        // The key is the case folded value, which is what the entries are sorted and searched by.
+        struct Entry
+        {
+            uint32_t KeyOffset;
+            uint32_t KeyLength;
+            uint32_t ValueOffset;
+            uint32_t ValueLength;
+        };
+
+        static_assert(sizeof(FileHeader) == 32);
+        static_assert(sizeof(FieldHeader) == 16);
+        static_assert(sizeof(Entry) == 16);
+
+        // Stores each distinct string once.
+        struct StringTable
+        {
+            uint32_t Add(const std::string& value)
+            {
+                auto itr = m_offsets.find(value);
+                if (itr != m_offsets.end())
+                {
+                    return itr->second;
+                }
+
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE), m_data.size() + value.size() > std::numeric_limits<uint32_t>::max());
+
+                uint32_t result = static_cast<uint32_t>(m_data.size());
+                m_data.append(value);
+                m_offsets.emplace(value, result);
+                return result;
+            }
+
+            const std::string& Data() const { return m_data; }
+
+        private:
+            std::string m_data;
+            std::unordered_map<std::string, uint32_t> m_offsets;
+        };
+
+        template <typename T>
+        void WriteValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    struct CompletionIndex::implementation
+    {
+        std::string_view GetString(uint32_t offset, uint32_t length) const
+        {
+            return { Strings + offset, length };
+        }
+
+        wil::unique_hfile File;
+        wil::unique_handle Mapping;
+        wil::unique_mapview_ptr<uint8_t> View;
+        const char* Strings = nullptr;
+        std::map<PackageMatchField, std::pair<const Entry*, uint32_t>> Fields;
+    };
+
+    CompletionIndex::CompletionIndex(std::unique_ptr<implementation>&& value) : m_implementation(std::move(value)) {}
+
+    CompletionIndex::CompletionIndex(CompletionIndex&&) noexcept = default;
+    CompletionIndex& CompletionIndex::operator=(CompletionIndex&&) noexcept = default;
+
+    CompletionIndex::~CompletionIndex() = default;
+
+    void CompletionIndex::Write(const std::filesystem::path& path, const std::map<PackageMatchField, std::vector<std::string>>& values)
+    {
+        StringTable strings;
+        std::vector<std::pair<PackageMatchField, std::vector<Entry>>> fields;
+
+        for (const auto& [field, fieldValues] : values)
+        {
+            std::vector<std::pair<std::string, std::string_view>> keyedValues;
+            keyedValues.reserve(fieldValues.size());
+
+            for (const auto& value : fieldValues)
+            {
+                if (!value.empty())
+                {
+                    keyedValues.emplace_back(Utility::FoldCase(std::string_view{ value }), value);
+                }
+            }
+
+            std::sort(keyedValues.begin(), keyedValues.end());
+            keyedValues.erase(std::unique(keyedValues.begin(), keyedValues.end()), keyedValues.end());
+
+            std::vector<Entry> entries;
+            entries.reserve(keyedValues.size());
+
+            for (const auto& [key, value] : keyedValues)
+            {
+                Entry entry{};
+                entry.KeyOffset = strings.Add(key);
+                entry.KeyLength = static_cast<uint32_t>(key.size());
+                entry.ValueOffset = strings.Add(std::string{ value });
+                entry.ValueLength = static_cast<uint32_t>(value.size());
+                entries.emplace_back(entry);
+            }
+
+            fields.emplace_back(field, std::move(entries));
+        }
+
+        uint64_t offset = sizeof(FileHeader) + fields.size() * sizeof(FieldHeader);
+
+        std::vector<FieldHeader> fieldHeaders;
+        for (const auto& [field, entries] : fields)
+        {
+            FieldHeader fieldHeader{};
+            fieldHeader.Field = static_cast<uint32_t>(field);
+            fieldHeader.EntryCount = static_cast<uint32_t>(entries.size());
+            fieldHeader.EntriesOffset = offset;
+            fieldHeaders.emplace_back(fieldHeader);
+
+            offset += entries.size() * sizeof(Entry);
+        }
+
+        FileHeader header{};
+        header.Magic = s_CompletionIndex_Magic;
+        header.Version = s_CompletionIndex_Version;
+        header.FieldCount = static_cast<uint32_t>(fields.size());
+        header.StringsOffset = offset;
+        header.StringsSize = strings.Data().size();
+
+        // Write to a temporary file and move it into place, so that a reader never sees a partial index.
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream{ tempPath, std::ios::out | std::ios::binary | std::ios::trunc };
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_OPEN_FAILED), !stream);
+
+            WriteValue(stream, header);
+
+            for (const auto& fieldHeader : fieldHeaders)
+            {
+                WriteValue(stream, fieldHeader);
+            }
+
+            for (const auto& [field, entries] : fields)
+            {
+                stream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+            }
+
+            stream.write(strings.Data().data(), strings.Data().size());
+            stream.flush();
+            THROW_LAST_ERROR_IF(stream.fail());
+        }
+
+        std::filesystem::rename(tempPath, path);
+    }
+
+    std::optional<CompletionIndex> CompletionIndex::Open(const std::filesystem::path& path)
+    {
+        auto result = std::make_unique<implementation>();
+
+        // Allow the file to be replaced while it is open, so that a source update is not blocked by completion.
+        result->File.reset(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+        if (!result->File)
+        {
+            DWORD error = GetLastError();
+            if (error != ERROR_FILE_NOT_FOUND && error != ERROR_PATH_NOT_FOUND)
+            {
+                AICLI_LOG(Repo, Warning, << "Failed to open completion index [" << error << "]: " << path.u8string());
+            }
+            return {};
+        }
+
+        LARGE_INTEGER fileSize{};
+        THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(result->File.get(), &fileSize));
+        uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+
+        auto invalid = [&](std::string_view reason) -> std::optional<CompletionIndex>
+            {
+                AICLI_LOG(Repo, Warning, << "Completion index is not valid, " << reason << ": " << path.u8string());
+                return {};
+            };
+
+        if (size < sizeof(FileHeader))
+        {
+            return invalid("too small");
+        }
+
+        result->Mapping.reset(CreateFileMappingW(result->File.get(), nullptr, PAGE_READONLY, 0, 0, nullptr));
+        THROW_LAST_ERROR_IF(!result->Mapping);
+
+        result->View.reset(reinterpret_cast<uint8_t*>(MapViewOfFile(result->Mapping.get(), FILE_MAP_READ, 0, 0, 0)));
+        THROW_LAST_ERROR_IF(!result->View);
+
+        const uint8_t* data = result->View.get();
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+
+        if (header->Magic != s_CompletionIndex_Magic || header->Version != s_CompletionIndex_Version)
+        {
+            return invalid("unknown format");
+        }
+
+        if (header->StringsOffset > size || header->StringsSize > size - header->StringsOffset ||
+            static_cast<uint64_t>(header->FieldCount) * sizeof(FieldHeader) > size - sizeof(FileHeader))
+        {
+            return invalid("bad header");
+        }
+
+        result->Strings = reinterpret_cast<const char*>(data + header->StringsOffset);
+
+        const FieldHeader* fieldHeaders = reinterpret_cast<const FieldHeader*>(data + sizeof(FileHeader));
+        for (uint32_t i = 0; i < header->FieldCount; ++i)
+        {
+            const FieldHeader& fieldHeader = fieldHeaders[i];
+
+            if (fieldHeader.EntriesOffset > header->StringsOffset ||
+                static_cast<uint64_t>(fieldHeader.EntryCount) * sizeof(Entry) > header->StringsOffset - fieldHeader.EntriesOffset ||
+                fieldHeader.EntriesOffset % alignof(Entry) != 0)
+            {
+                return invalid("bad field");
+            }
+
+            const Entry* entries = reinterpret_cast<const Entry*>(data + fieldHeader.EntriesOffset);
+            for (uint32_t j = 0; j < fieldHeader.EntryCount; ++j)
+            {
+                const Entry& entry = entries[j];
+                if (static_cast<uint64_t>(entry.KeyOffset) + entry.KeyLength > header->StringsSize ||
+                    static_cast<uint64_t>(entry.ValueOffset) + entry.ValueLength > header->StringsSize)
+                {
+                    return invalid("bad entry");
+                }
+            }
+
+            result->Fields[static_cast<PackageMatchField>(fieldHeader.Field)] = { entries, fieldHeader.EntryCount };
+        }
+
+        return CompletionIndex{ std::move(result) };
+    }
+
+    std::vector<std::string> CompletionIndex::GetValues(PackageMatchField field, std::string_view prefix, size_t maximum) const
+    {
+        std::vector<std::string> result;
+
+        auto itr = m_implementation->Fields.find(field);
+        if (itr == m_implementation->Fields.end())
+        {
+            return result;
+        }
+
+        const Entry* begin = itr->second.first;
+        const Entry* end = begin + itr->second.second;
+
+        std::string foldedPrefix = Utility::FoldCase(prefix);
+        auto getKey = [&](const Entry& entry) { return m_implementation->GetString(entry.KeyOffset, entry.KeyLength); };
+
+        const Entry* current = std::lower_bound(begin, end, std::string_view{ foldedPrefix },
+            [&](const Entry& entry, std::string_view value) { return getKey(entry) < value; });
+
+        for (; current != end && getKey(*current).substr(0, foldedPrefix.size()) == foldedPrefix; ++current)
+        {
+            if (maximum && result.size() >= maximum)
+            {
+                break;
+            }
+
+            result.emplace_back(m_implementation->GetString(current->ValueOffset, current->ValueLength));
+        }
+
+        return result;
+    }
+}
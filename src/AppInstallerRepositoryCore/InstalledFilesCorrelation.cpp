@@ -4,6 +4,8 @@
 #include "winget/InstalledFilesCorrelation.h"
 #include <winget/FolderFileWatcher.h>
 #include <winget/Filesystem.h>
+#include <winget/PathTree.h>
+#include <winget/Concurrency.h>
 
 using namespace AppInstaller::Manifest;
 using namespace AppInstaller::Repository;
@@ -14,6 +16,7 @@ namespace AppInstaller::Repository::Correlation
     namespace
     {
         constexpr std::string_view s_ShellLinkFileExtension = ".lnk"sv;
+        constexpr size_t s_MaximumHashingThreads = 8;
         const std::vector<std::pair<std::filesystem::path, std::string>> s_CandidateInstallLocationRoots =
         {
             { Filesystem::GetKnownFolderPath(FOLDERID_LocalAppData), "%LOCALAPPDATA%" },
@@ -214,6 +217,97 @@ namespace AppInstaller::Repository::Correlation
         }
     }
 
+    InstalledFileHashes HashInstalledFiles(const std::vector<std::filesystem::path>& files, const InstalledFilesHashingBudget& budget)
+    {
+        InstalledFileHashes result;
+        result.Hashes.resize(files.size());
+
+        // Choose the files that fit in the budget before starting any work.
+        std::vector<size_t> filesToHash;
+        uint64_t totalSize = 0;
+
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            std::error_code error;
+            uint64_t fileSize = std::filesystem::file_size(files[i], error);
+            if (error)
+            {
+                AICLI_LOG(Repo, Warning, << "Failed to get the size of installed file " << files[i] << ": " << error.message());
+                continue;
+            }
+
+            if (filesToHash.size() >= budget.MaximumFileCount || totalSize + fileSize > budget.MaximumTotalSize)
+            {
+                ++result.SkippedFileCount;
+                result.SkippedSize += fileSize;
+                continue;
+            }
+
+            filesToHash.emplace_back(i);
+            totalSize += fileSize;
+        }
+
+        Utility::ForEachConcurrently(filesToHash.size(), [&](size_t i)
+            {
+                const auto& file = files[filesToHash[i]];
+
+                try
+                {
+                    std::ifstream in{ file, std::ifstream::binary };
+                    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_OPEN_FAILED), !in);
+                    result.Hashes[filesToHash[i]] = SHA256::ComputeHash(in);
+                }
+                catch (...)
+                {
+                    AICLI_LOG(Repo, Warning, << "Failed to hash installed file " << file);
+                    LOG_CAUGHT_EXCEPTION();
+                }
+            }, s_MaximumHashingThreads);
+
+        return result;
+    }
+
+    void HashInstalledFileTargets(InstallationMetadata& metadata, const std::vector<std::filesystem::path>& targets, const InstalledFilesHashingBudget& budget)
+    {
+        THROW_HR_IF(E_INVALIDARG, targets.size() != metadata.InstalledFiles.Files.size());
+
+        Filesystem::PathTree<std::optional<size_t>> fileToHashIndices;
+        std::vector<std::filesystem::path> filesToHash;
+        std::vector<size_t> fileToHashIndexForTarget;
+
+        for (const auto& target : targets)
+        {
+            auto& fileToHashIndex = fileToHashIndices.FindOrInsert(target);
+            if (!fileToHashIndex)
+            {
+                fileToHashIndex = filesToHash.size();
+                filesToHash.emplace_back(target);
+            }
+
+            fileToHashIndexForTarget.emplace_back(fileToHashIndex.value());
+        }
+
+        if (filesToHash.empty())
+        {
+            return;
+        }
+
+        auto hashes = HashInstalledFiles(filesToHash, budget);
+
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            metadata.InstalledFiles.Files[i].FileSha256 = hashes.Hashes[fileToHashIndexForTarget[i]];
+        }
+
+        metadata.FilesNotHashed = hashes.SkippedFileCount;
+        metadata.BytesNotHashed = hashes.SkippedSize;
+
+        if (hashes.SkippedFileCount)
+        {
+            AICLI_LOG(Repo, Warning, << "Did not hash " << hashes.SkippedFileCount << " installed files [" << hashes.SkippedSize << " bytes] as they exceed the hashing budget");
+        }
+    }
+
     InstalledFilesCorrelation::InstalledFilesCorrelation()
     {
         m_fileWatchers.emplace_back(Filesystem::GetKnownFolderPath(FOLDERID_CommonStartMenu), std::string{ s_ShellLinkFileExtension });
@@ -251,6 +345,11 @@ namespace AppInstaller::Repository::Correlation
         }
     }
 
+    void InstalledFilesCorrelation::SetHashingBudget(InstalledFilesHashingBudget budget)
+    {
+        m_hashingBudget = budget;
+    }
+
     InstallationMetadata InstalledFilesCorrelation::CorrelateForNewlyInstalled(
         const Manifest::Manifest&,
         const std::string& arpInstallLocation)
@@ -264,6 +363,10 @@ namespace AppInstaller::Repository::Correlation
             installLocation = Filesystem::GetExpandedPath(arpInstallLocation);
         }
 
+        // Files are only hashed once all of the links have been examined, so that a file targeted by multiple links
+        // is only hashed once and the hashing can be spread across threads.
+        std::vector<std::filesystem::path> fileTargets;
+
         for (auto const& files : m_files)
         {
             for (auto const& file : files.Files)
@@ -294,12 +397,11 @@ namespace AppInstaller::Repository::Correlation
                         {
                             AppInstaller::Manifest::InstalledFile fileEntry;
                             fileEntry.RelativeFilePath = relativePath->string();
-                            std::ifstream in{ linkInfo->Path, std::ifstream::binary };
-                            fileEntry.FileSha256 = Utility::SHA256::ComputeHash(in);
                             fileEntry.InvocationParameter = linkInfo->Args;
                             fileEntry.DisplayName = linkInfo->DisplayName;
                             fileEntry.FileType = installedFileType;
                             result.InstalledFiles.Files.emplace_back(std::move(fileEntry));
+                            fileTargets.emplace_back(linkInfo->Path);
                         }
                     }
 
@@ -312,6 +414,8 @@ namespace AppInstaller::Repository::Correlation
             }
         }
 
+        HashInstalledFileTargets(result, fileTargets, m_hashingBudget);
+
         if (!installLocation.empty())
         {
             result.InstalledFiles.DefaultInstallLocation = GetUnexpandedInstallLocation(installLocation);
@@ -127,6 +127,8 @@ namespace AppInstaller::Repository::Metadata
             utility::string_t MatchedEntryCount = L"matchedEntryCount";
             utility::string_t IntersectionCount = L"intersectionCount";
             utility::string_t CorrelationMeasures = L"correlationMeasures";
+            utility::string_t InstalledFilesNotHashedCount = L"installedFilesNotHashedCount";
+            utility::string_t InstalledFilesNotHashedSize = L"installedFilesNotHashedSize";
             utility::string_t Value = L"value";
             utility::string_t Name = L"name";
             utility::string_t Publisher = L"publisher";
@@ -267,7 +269,12 @@ namespace AppInstaller::Repository::Metadata
                     {
                         existingItr->DisplayName.clear();
                     }
-                    if (!Utility::SHA256::AreEqual(existingItr->FileSha256, itr->FileSha256))
+                    // An empty hash means the file was not hashed (such as when over the hashing budget), so it does not conflict.
+                    if (existingItr->FileSha256.empty())
+                    {
+                        existingItr->FileSha256 = itr->FileSha256;
+                    }
+                    else if (!itr->FileSha256.empty() && !Utility::SHA256::AreEqual(existingItr->FileSha256, itr->FileSha256))
                     {
                         existingItr->FileSha256.clear();
                     }
@@ -1236,6 +1243,12 @@ namespace AppInstaller::Repository::Metadata
         }
 
         m_outputDiagnostics[fields.CorrelationMeasures] = std::move(measuresArray);
+
+        if (installationMetadata.FilesNotHashed)
+        {
+            m_outputDiagnostics[fields.InstalledFilesNotHashedCount] = web::json::value::number(static_cast<int64_t>(installationMetadata.FilesNotHashed));
+            m_outputDiagnostics[fields.InstalledFilesNotHashedSize] = web::json::value::number(static_cast<int64_t>(installationMetadata.BytesNotHashed));
+        }
     }
 
     void InstallerMetadataCollectionContext::ParseInputJson_1_0(web::json::value& input)
@@ -1251,6 +1264,9 @@ namespace AppInstaller::Repository::Metadata
         utility::string_t installerHashFieldName = L"installerHash";
         utility::string_t defaultLocaleFieldName = L"DefaultLocale";
         utility::string_t localesFieldName = L"Locales";
+        utility::string_t installedFilesHashingFieldName = L"installedFilesHashing";
+        utility::string_t maximumFileCountFieldName = L"maximumFileCount";
+        utility::string_t maximumTotalSizeFieldName = L"maximumTotalSize";
 
         // root fields
         m_supportedMetadataVersion = Version{ GetRequiredString(input, metadataVersionFieldName) };
@@ -1302,6 +1318,27 @@ namespace AppInstaller::Repository::Metadata
                 }
             }
         }
+
+        // Optional limits on hashing the installed files; the defaults are used for any that are not given.
+        auto installedFilesHashingValue = AppInstaller::JSON::GetJsonValueFromNode(input, installedFilesHashingFieldName);
+        if (installedFilesHashingValue)
+        {
+            Correlation::InstalledFilesHashingBudget budget;
+
+            auto maximumFileCount = AppInstaller::JSON::GetRawUInt64ValueFromJsonNode(installedFilesHashingValue.value(), maximumFileCountFieldName);
+            if (maximumFileCount)
+            {
+                budget.MaximumFileCount = static_cast<size_t>(maximumFileCount.value());
+            }
+
+            auto maximumTotalSize = AppInstaller::JSON::GetRawUInt64ValueFromJsonNode(installedFilesHashingValue.value(), maximumTotalSizeFieldName);
+            if (maximumTotalSize)
+            {
+                budget.MaximumTotalSize = maximumTotalSize.value();
+            }
+
+            m_installedFilesCorrelation->SetHashingBudget(budget);
+        }
     }
 
     web::json::value InstallerMetadataCollectionContext::CreateOutputJson_1_0()
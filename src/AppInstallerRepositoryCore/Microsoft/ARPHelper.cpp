@@ -383,6 +383,49 @@ namespace AppInstaller::Repository::Microsoft
         }
     }
 
+    std::string ARPHelper::GetEntryId(std::string_view scope, std::string_view architecture, std::string_view productCode)
+    {
+        const char separator = '\\';
+
+        std::ostringstream stream;
+        stream << "ARP" << separator << scope << separator << architecture << separator << productCode;
+
+        return stream.str();
+    }
+
+    void ARPHelper::AddEntrySnapshotsFromARP(std::vector<Correlation::ARPEntrySnapshot>& snapshots, Manifest::ScopeEnum scope) const
+    {
+        for (auto architecture : Utility::GetApplicableArchitectures())
+        {
+            Registry::Key arpRootKey = GetARPKey(scope, architecture);
+
+            if (!arpRootKey)
+            {
+                continue;
+            }
+
+            std::string_view scopeString = Manifest::ScopeToString(scope);
+            std::string_view architectureString = Utility::ToString(architecture);
+
+            for (const auto& arpEntry : arpRootKey)
+            {
+                try
+                {
+                    Correlation::ARPEntrySnapshot snapshot;
+                    snapshot.Id = GetEntryId(scopeString, architectureString, arpEntry.Name());
+
+                    const FILETIME& lastWriteTime = arpEntry.LastWriteTime();
+                    snapshot.LastWriteTime = (static_cast<uint64_t>(lastWriteTime.dwHighDateTime) << 32) | lastWriteTime.dwLowDateTime;
+
+                    snapshot.DisplayVersion = GetStringValue(arpEntry.Open(), DisplayVersion);
+
+                    snapshots.emplace_back(std::move(snapshot));
+                }
+                CATCH_LOG();
+            }
+        }
+    }
+
     void ARPHelper::PopulateIndexFromKey(SQLiteIndex& index, const Registry::Key& key, std::string_view scope, std::string_view architecture, const std::map<std::string, std::string>& upgradeCodes) const
     {
         AICLI_LOG(Repo, Verbose, << "Examining ARP entries for " << scope << " | " << architecture);
@@ -399,12 +442,7 @@ namespace AppInstaller::Repository::Microsoft
                 manifest.DefaultLocalization.Add<Manifest::Localization::Tags>({ "ARP" });
 
                 // Construct a unique name for this entry
-                const char separator = '\\';
-
-                std::ostringstream stream;
-                stream << "ARP" << separator << scope << separator << architecture << separator << productCode;
-
-                manifest.Id = stream.str();
+                manifest.Id = GetEntryId(scope, architecture, productCode);
 
                 manifest.Installers.emplace_back();
                 // TODO: This likely needs some cleanup applied, as it looks like INNO tends to append an "_is#"
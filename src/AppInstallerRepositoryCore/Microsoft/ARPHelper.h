@@ -3,6 +3,7 @@
 #pragma once
 #include "Microsoft/SQLiteIndex.h"
 #include <AppInstallerArchitecture.h>
+#include <winget/ARPCorrelation.h>
 #include <winget/Registry.h>
 #include <winget/ManifestInstaller.h>
 #include <wil/registry.h>
@@ -95,6 +96,13 @@ namespace AppInstaller::Repository::Microsoft
         // product code should use PopulateIndexFromARP.
         void PopulateIndexFromKey(SQLiteIndex& index, const Registry::Key& key, std::string_view scope, std::string_view architecture, const std::map<std::string, std::string>& upgradeCodes = {}) const;
 
+        // Gets the identifier used for the ARP entry with the given key name.
+        static std::string GetEntryId(std::string_view scope, std::string_view architecture, std::string_view productCode);
+
+        // Adds a snapshot of each ARP entry from the given scope (machine/user) to the result.
+        // Only the key's last write time and DisplayVersion are read, making this much cheaper than populating an index.
+        void AddEntrySnapshotsFromARP(std::vector<Correlation::ARPEntrySnapshot>& snapshots, Manifest::ScopeEnum scope) const;
+
         // Creates registry watchers for the given scope
         std::vector<wil::unique_registry_watcher> CreateRegistryWatchers(Manifest::ScopeEnum scope, std::function<void(Manifest::ScopeEnum, Utility::Architecture, wil::RegistryChangeKind)> callback);
     };
@@ -3,6 +3,7 @@
 #include "pch.h"
 #include "Microsoft/PreIndexedPackageSourceFactory.h"
 #include "Microsoft/SQLiteIndex.h"
+#include "Microsoft/SQLiteIndexChangeset.h"
 #include "Microsoft/SQLiteIndexSource.h"
 #include "SourceUpdateChecks.h"
 
@@ -10,6 +11,7 @@
 #include <AppInstallerDeployment.h>
 #include <AppInstallerDownloader.h>
 #include <AppInstallerMsixInfo.h>
+#include <winget/CompletionIndex.h>
 #include <winget/ManagedFile.h>
 #include <winget/ExperimentalFeature.h>
 
@@ -18,6 +20,15 @@ using namespace std::string_view_literals;
 
 namespace AppInstaller::Repository::Microsoft
 {
+#ifndef AICLI_DISABLE_TEST_HOOKS
+    // Signed test packages cannot carry a changeset, so tests supply the changeset for every delta package.
+    std::optional<std::filesystem::path> s_DeltaChangesetOverride{};
+    void TestHook_SetDeltaChangeset_Override(std::optional<std::filesystem::path>&& changesetPath)
+    {
+        s_DeltaChangesetOverride = std::move(changesetPath);
+    }
+#endif
+
     namespace
     {
         static constexpr std::string_view s_PreIndexedPackageSourceFactory_PackageFileName = "source.msix"sv;
@@ -26,6 +37,17 @@ namespace AppInstaller::Repository::Microsoft
         static constexpr std::string_view s_PreIndexedPackageSourceFactory_IndexFileName = "index.db"sv;
         // TODO: This being hard coded to force using the Public directory name is not ideal.
         static constexpr std::string_view s_PreIndexedPackageSourceFactory_IndexFilePath = "Public\\index.db"sv;
+        static constexpr std::string_view s_PreIndexedPackageSourceFactory_ChangesetFilePath = "Public\\changeset.db"sv;
+        // Delta packages are published beside the full package, in a directory named after it with this suffix.
+        static constexpr std::string_view s_PreIndexedPackageSourceFactory_DeltaDirectorySuffix = ".delta"sv;
+        // Applied delta packages are kept in this directory of the local state as 1.msix, 2.msix, ...
+        static constexpr std::string_view s_PreIndexedPackageSourceFactory_DeltaDirectoryName = "delta"sv;
+        // The index with the delta packages applied is kept in the delta directory when they are accepted, so that opening the source does not apply them again.
+        static constexpr std::string_view s_PreIndexedPackageSourceFactory_DeltaIndexFileName = "index.db"sv;
+        // Once this many deltas have been applied, the full package is downloaded instead so that the chain stays bounded.
+        static constexpr size_t s_PreIndexedPackageSourceFactory_MaxDeltaChainLength = 8;
+        // The completion index is written to the local state, beside any data that the source keeps there.
+        static constexpr std::string_view s_PreIndexedPackageSourceFactory_CompletionIndexFileName = "completion.idx"sv;
 
         // Construct the package location from the given details.
         // Currently expects that the arg is an https uri pointing to the root of the data.
@@ -40,6 +62,22 @@ namespace AppInstaller::Repository::Microsoft
             return result;
         }
 
+        // Construct the location of the delta package that moves the data from the given version to the one at packageLocation.
+        // For a package at <base>/source2.msix, this is <base>/source2.delta/<fromVersion>.msix.
+        std::string GetDeltaPackageLocation(const std::string& packageLocation, const Msix::PackageVersion& fromVersion)
+        {
+            std::string result = packageLocation;
+            size_t extensionPosition = result.rfind('.');
+            THROW_HR_IF(E_INVALIDARG, extensionPosition == std::string::npos);
+
+            result.resize(extensionPosition);
+            result += s_PreIndexedPackageSourceFactory_DeltaDirectorySuffix;
+            result += '/';
+            result += fromVersion.ToString();
+            result += ".msix";
+            return result;
+        }
+
         // Gets the set of package locations that should be tried, in order.
         std::vector<std::string> GetPackageLocations(const SourceDetails& details)
         {
@@ -244,6 +282,11 @@ namespace AppInstaller::Repository::Microsoft
                 std::optional<uint64_t> downloadedBytes;
                 bool result = UpdateInternal(packageInfo.PackageLocation(), details, progress, downloadedBytes);
 
+                if (result)
+                {
+                    UpdateCompletionIndex(details, progress);
+                }
+
                 if (downloadedBytes)
                 {
                     try
@@ -293,12 +336,51 @@ namespace AppInstaller::Repository::Microsoft
                     return false;
                 }
 
-                return RemoveInternal(details, progress);
+                bool result = RemoveInternal(details, progress);
+                RemoveCompletionIndex(details);
+                return result;
             }
 
             virtual bool RemoveInternal(const SourceDetails& details, IProgressCallback&) = 0;
 
         private:
+            // Writes the completion index from the current data of the source; call while holding the exclusive lock.
+            // Completion searches the source when there is no index, so on failure the index is only removed to prevent stale values.
+            void UpdateCompletionIndex(const SourceDetails& details, IProgressCallback& progress)
+            {
+                try
+                {
+                    std::shared_ptr<SQLiteIndexSource> source = SourceCast<SQLiteIndexSource>(CreateInternal(details)->Open(progress));
+                    if (source && !progress.IsCancelledBy(CancelReason::Any))
+                    {
+                        std::map<PackageMatchField, std::vector<std::string>> values;
+                        for (PackageMatchField field : CompletionIndex::Fields)
+                        {
+                            values[field] = source->GetIndex().GetAllValues(field);
+                        }
+
+                        std::filesystem::path completionIndexPath = PreIndexedPackageSourceFactory::GetCompletionIndexPath(details);
+                        std::filesystem::create_directories(completionIndexPath.parent_path());
+                        CompletionIndex::Write(completionIndexPath, values);
+
+                        AICLI_LOG(Repo, Verbose, << "Wrote completion index for source: " << details.Name);
+                        return;
+                    }
+                }
+                CATCH_LOG();
+
+                RemoveCompletionIndex(details);
+            }
+
+            void RemoveCompletionIndex(const SourceDetails& details)
+            {
+                try
+                {
+                    std::filesystem::remove(PreIndexedPackageSourceFactory::GetCompletionIndexPath(details));
+                }
+                CATCH_LOG();
+            }
+
             Synchronization::CrossProcessLock LockExclusive(const SourceDetails& details, IProgressCallback& progress, bool isBackground = false)
             {
                 Synchronization::CrossProcessLock result(CreateNameForCPL(details));
@@ -329,6 +411,17 @@ namespace AppInstaller::Repository::Microsoft
                     {
                         AICLI_LOG(Repo, Verbose, << "Remote source data (" << updateCheck.AvailableVersion().ToString() <<
                             ") was not newer than existing (" << currentVersion.value().ToString() << "), no update needed");
+
+                        // Data acquired before the completion index existed gets one on the next update check.
+                        if (!std::filesystem::exists(PreIndexedPackageSourceFactory::GetCompletionIndexPath(details)))
+                        {
+                            auto lock = LockExclusive(details, progress, isBackground);
+                            if (lock)
+                            {
+                                UpdateCompletionIndex(details, progress);
+                            }
+                        }
+
                         return true;
                     }
                     else
@@ -353,6 +446,11 @@ namespace AppInstaller::Repository::Microsoft
                 std::optional<uint64_t> downloadedBytes = 0;
                 bool result = UpdateInternal(updateCheck.PackageLocation(), details, progress, downloadedBytes);
 
+                if (result)
+                {
+                    UpdateCompletionIndex(details, progress);
+                }
+
                 if (downloadedBytes)
                 {
                     std::optional<std::chrono::system_clock::time_point> previousIndexPublishedAt;
@@ -408,6 +506,111 @@ namespace AppInstaller::Repository::Microsoft
             return result;
         }
 
+        // Gets the delta packages that have been applied on top of the package, in the order they must be applied.
+        std::vector<std::filesystem::path> GetDesktopContextDeltaPackages(const SourceDetails& details)
+        {
+            std::filesystem::path deltaDirectory = GetStatePathFromDetails(details) / s_PreIndexedPackageSourceFactory_DeltaDirectoryName;
+            std::vector<std::filesystem::path> result;
+
+            for (size_t i = 1; ; ++i)
+            {
+                std::filesystem::path deltaPackage = deltaDirectory / (std::to_string(i) + ".msix");
+                if (!std::filesystem::exists(deltaPackage))
+                {
+                    break;
+                }
+
+                result.emplace_back(std::move(deltaPackage));
+            }
+
+            return result;
+        }
+
+        // Gets the path of the index with the delta packages applied.
+        std::filesystem::path GetDesktopContextDeltaIndexPath(const SourceDetails& details)
+        {
+            return GetStatePathFromDetails(details) / s_PreIndexedPackageSourceFactory_DeltaDirectoryName / s_PreIndexedPackageSourceFactory_DeltaIndexFileName;
+        }
+
+        // Verifies that a package acquired for the source is acceptable, and returns its version.
+        Msix::PackageVersion ValidateDesktopContextPackage(const std::filesystem::path& packagePath, const SourceDetails& details)
+        {
+            Msix::WriteLockedMsixFile packageLock{ packagePath };
+            Msix::MsixInfo msixInfo{ packagePath };
+
+            // The package should not be a bundle
+            THROW_HR_IF(APPINSTALLER_CLI_ERROR_PACKAGE_IS_BUNDLE, msixInfo.GetIsBundle());
+
+            // Ensure that family name has not changed
+            THROW_HR_IF(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE,
+                GetPackageFamilyNameFromDetails(details) != Msix::GetPackageFamilyNameFromFullName(msixInfo.GetPackageFullName()));
+
+            if (!packageLock.ValidateTrustInfo(WI_IsFlagSet(details.TrustLevel, SourceTrustLevel::StoreOrigin)))
+            {
+                AICLI_LOG(Repo, Error, << "Source update failed. Source package failed trust validation.");
+                THROW_HR(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE);
+            }
+
+            auto manifest = msixInfo.GetAppPackageManifests();
+            THROW_HR_IF(E_UNEXPECTED, manifest.size() != 1);
+
+            return manifest[0].GetIdentity().GetVersion();
+        }
+
+        // Writes the index from the package to indexPath, then applies the changeset from each delta package in order.
+        // Each delta package must pass trust validation before its changeset is used. The content hashes are only
+        // checked for the last delta when requested, as the earlier ones were checked when they were accepted.
+        void WriteDesktopContextIndex(
+            const SourceDetails& details,
+            const std::filesystem::path& packagePath,
+            const std::vector<std::filesystem::path>& deltaPackages,
+            bool verifyLastDelta,
+            const std::filesystem::path& indexPath,
+            IProgressCallback& progress)
+        {
+            {
+                auto indexFile = Utility::ManagedFile::CreateWriteLockedFile(indexPath, GENERIC_WRITE, false);
+                Msix::MsixInfo packageInfo(packagePath);
+                packageInfo.WriteToFileHandle(s_PreIndexedPackageSourceFactory_IndexFilePath, indexFile.GetFileHandle(), progress);
+            }
+
+            for (size_t i = 0; i < deltaPackages.size() && !progress.IsCancelledBy(CancelReason::Any); ++i)
+            {
+                const std::filesystem::path& deltaPackage = deltaPackages[i];
+
+                Msix::WriteLockedMsixFile deltaPackageLock{ deltaPackage };
+                THROW_HR_IF(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE, !deltaPackageLock.ValidateTrustInfo(WI_IsFlagSet(details.TrustLevel, SourceTrustLevel::StoreOrigin)));
+
+                auto changesetPath = Runtime::GetNewTempFilePath();
+                auto removeChangesetOnExit = wil::scope_exit([&]()
+                    {
+                        try
+                        {
+                            std::filesystem::remove(changesetPath);
+                        }
+                        catch (...)
+                        {
+                            AICLI_LOG(Repo, Info, << "Failed to remove temp changeset file at: " << changesetPath);
+                        }
+                    });
+
+#ifndef AICLI_DISABLE_TEST_HOOKS
+                if (s_DeltaChangesetOverride)
+                {
+                    std::filesystem::copy_file(s_DeltaChangesetOverride.value(), changesetPath, std::filesystem::copy_options::overwrite_existing);
+                }
+                else
+#endif
+                {
+                    auto changesetFile = Utility::ManagedFile::CreateWriteLockedFile(changesetPath, GENERIC_WRITE, false);
+                    Msix::MsixInfo deltaInfo(deltaPackage);
+                    deltaInfo.WriteToFileHandle(s_PreIndexedPackageSourceFactory_ChangesetFilePath, changesetFile.GetFileHandle(), progress);
+                }
+
+                SQLiteIndexChangeset::Apply(indexPath, changesetPath, verifyLastDelta && i + 1 == deltaPackages.size());
+            }
+        }
+
         std::optional<Msix::PackageVersion> DesktopContextGetCurrentVersion(const SourceDetails& details)
         {
             std::filesystem::path packageState = GetStatePathFromDetails(details);
@@ -415,6 +618,13 @@ namespace AppInstaller::Repository::Microsoft
 
             if (std::filesystem::exists(packagePath))
             {
+                // When deltas have been applied on top of the package, the latest one carries the version of the data.
+                std::vector<std::filesystem::path> deltaPackages = GetDesktopContextDeltaPackages(details);
+                if (!deltaPackages.empty())
+                {
+                    packagePath = deltaPackages.back();
+                }
+
                 // If we already have a trusted index package, use it to determine if we need to update or not.
                 Msix::WriteLockedMsixFile indexPackage{ packagePath };
                 if (indexPackage.ValidateTrustInfo(WI_IsFlagSet(details.TrustLevel, SourceTrustLevel::StoreOrigin)))
@@ -741,13 +951,47 @@ namespace AppInstaller::Repository::Microsoft
                 // Validate index package trust info.
                 THROW_HR_IF(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE, !indexPackage.ValidateTrustInfo(WI_IsFlagSet(m_details.TrustLevel, SourceTrustLevel::StoreOrigin)));
 
-                // Create a temp lock exclusive index file.
                 auto tempIndexFilePath = Runtime::GetNewTempFilePath();
-                auto tempIndexFile = Utility::ManagedFile::CreateWriteLockedFile(tempIndexFilePath, GENERIC_WRITE, true);
+                Utility::ManagedFile tempIndexFile;
+                std::vector<std::filesystem::path> deltaPackages = GetDesktopContextDeltaPackages(m_details);
 
-                // Populate temp index file.
-                Msix::MsixInfo packageInfo(packageLocation);
-                packageInfo.WriteToFileHandle(s_PreIndexedPackageSourceFactory_IndexFilePath, tempIndexFile.GetFileHandle(), progress);
+                if (deltaPackages.empty())
+                {
+                    // Create a temp lock exclusive index file.
+                    tempIndexFile = Utility::ManagedFile::CreateWriteLockedFile(tempIndexFilePath, GENERIC_WRITE, true);
+
+                    // Populate temp index file.
+                    Msix::MsixInfo packageInfo(packageLocation);
+                    packageInfo.WriteToFileHandle(s_PreIndexedPackageSourceFactory_IndexFilePath, tempIndexFile.GetFileHandle(), progress);
+                }
+                else
+                {
+                    std::filesystem::path deltaIndexPath = GetDesktopContextDeltaIndexPath(m_details);
+
+                    // The index is written when a delta is accepted; only state from before it was kept needs the deltas applied here.
+                    if (!std::filesystem::exists(deltaIndexPath) && !WriteDeltaIndex(deltaPackages, deltaIndexPath, progress))
+                    {
+                        AICLI_LOG(Repo, Info, << "Cancelling open upon request");
+                        return {};
+                    }
+
+                    // Open a copy, so that an update can replace the index while the source is open.
+                    auto removeTempIndexOnFailure = wil::scope_exit([&]()
+                        {
+                            try
+                            {
+                                std::filesystem::remove(tempIndexFilePath);
+                            }
+                            catch (...)
+                            {
+                                AICLI_LOG(Repo, Info, << "Failed to remove temp index file at: " << tempIndexFilePath);
+                            }
+                        });
+
+                    std::filesystem::copy_file(deltaIndexPath, tempIndexFilePath, std::filesystem::copy_options::overwrite_existing);
+                    tempIndexFile = Utility::ManagedFile::OpenWriteLockedFile(tempIndexFilePath, GENERIC_READ, true);
+                    removeTempIndexOnFailure.release();
+                }
 
                 if (progress.IsCancelledBy(CancelReason::Any))
                 {
@@ -764,6 +1008,36 @@ namespace AppInstaller::Repository::Microsoft
             }
 
         private:
+            // Applies the delta packages to the index of the package, writing the result to deltaIndexPath.
+            // Returns false if cancelled, in which case nothing is written.
+            bool WriteDeltaIndex(const std::vector<std::filesystem::path>& deltaPackages, const std::filesystem::path& deltaIndexPath, IProgressCallback& progress)
+            {
+                std::filesystem::path packageLocation = GetStatePathFromDetails(m_details) / s_PreIndexedPackageSourceFactory_PackageFileName;
+                std::filesystem::path newIndexPath = deltaIndexPath.u8string() + ".new";
+                auto removeNewIndexOnExit = wil::scope_exit([&]()
+                    {
+                        try
+                        {
+                            std::filesystem::remove(newIndexPath);
+                        }
+                        catch (...)
+                        {
+                            AICLI_LOG(Repo, Info, << "Failed to remove new index file at: " << newIndexPath);
+                        }
+                    });
+
+                AICLI_LOG(Repo, Info, << "Applying " << deltaPackages.size() << " delta packages to write the source index");
+                WriteDesktopContextIndex(m_details, packageLocation, deltaPackages, false, newIndexPath, progress);
+
+                if (progress.IsCancelledBy(CancelReason::Any))
+                {
+                    return false;
+                }
+
+                std::filesystem::rename(newIndexPath, deltaIndexPath);
+                return true;
+            }
+
             SourceDetails m_details;
         };
 
@@ -782,6 +1056,17 @@ namespace AppInstaller::Repository::Microsoft
 
             bool UpdateInternal(const std::string& packageLocation, const SourceDetails& details, IProgressCallback& progress, std::optional<uint64_t>& downloadedBytes) override
             {
+                if (TryUpdateWithDelta(packageLocation, details, progress, downloadedBytes))
+                {
+                    return true;
+                }
+
+                if (progress.IsCancelledBy(CancelReason::Any))
+                {
+                    AICLI_LOG(Repo, Info, << "Cancelling update upon request");
+                    return false;
+                }
+
                 // We will extract the manifest and index files directly to this location
                 std::filesystem::path packageState = GetStatePathFromDetails(details);
                 std::filesystem::create_directories(packageState);
@@ -818,25 +1103,10 @@ namespace AppInstaller::Repository::Microsoft
                     return false;
                 }
 
-                {
-                    // Extra scope to release the file lock right after trust validation.
-                    Msix::WriteLockedMsixFile tempIndexPackage{ tempPackagePath };
-                    Msix::MsixInfo tempMsixInfo{ tempPackagePath };
-
-                    // The package should not be a bundle
-                    THROW_HR_IF(APPINSTALLER_CLI_ERROR_PACKAGE_IS_BUNDLE, tempMsixInfo.GetIsBundle());
-
-                    // Ensure that family name has not changed
-                    THROW_HR_IF(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE,
-                        GetPackageFamilyNameFromDetails(details) != Msix::GetPackageFamilyNameFromFullName(tempMsixInfo.GetPackageFullName()));
-
-                    if (!tempIndexPackage.ValidateTrustInfo(WI_IsFlagSet(details.TrustLevel, SourceTrustLevel::StoreOrigin)))
-                    {
-                        AICLI_LOG(Repo, Error, << "Source update failed. Source package failed trust validation.");
-                        THROW_HR(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE);
-                    }
-                }
+                ValidateDesktopContextPackage(tempPackagePath, details);
 
+                // The deltas only apply to the package they were accepted on top of, so drop them before it is replaced.
+                std::filesystem::remove_all(packageState / s_PreIndexedPackageSourceFactory_DeltaDirectoryName);
                 std::filesystem::rename(tempPackagePath, packagePath);
                 AICLI_LOG(Repo, Info, << "Source update success.");
 
@@ -861,9 +1131,130 @@ namespace AppInstaller::Repository::Microsoft
 
                 return true;
             }
+
+        private:
+            // Attempts to move the local data forward by applying the delta package from the current version, rather than
+            // downloading the full package. Returns false if no delta could be used, and the full package should be downloaded.
+            bool TryUpdateWithDelta(const std::string& packageLocation, const SourceDetails& details, IProgressCallback& progress, std::optional<uint64_t>& downloadedBytes)
+            {
+                std::filesystem::path packageState = GetStatePathFromDetails(details);
+                std::filesystem::path packagePath = packageState / s_PreIndexedPackageSourceFactory_PackageFileName;
+
+                if (!std::filesystem::exists(packagePath))
+                {
+                    return false;
+                }
+
+                std::vector<std::filesystem::path> deltaPackages = GetDesktopContextDeltaPackages(details);
+                if (deltaPackages.size() >= s_PreIndexedPackageSourceFactory_MaxDeltaChainLength)
+                {
+                    AICLI_LOG(Repo, Info, << "Delta chain has reached " << deltaPackages.size() << " packages, downloading full package");
+                    return false;
+                }
+
+                std::optional<Msix::PackageVersion> currentVersion = DesktopContextGetCurrentVersion(details);
+                if (!currentVersion)
+                {
+                    return false;
+                }
+
+                std::string deltaLocation = GetDeltaPackageLocation(packageLocation, currentVersion.value());
+                std::filesystem::path deltaDirectory = packageState / s_PreIndexedPackageSourceFactory_DeltaDirectoryName;
+                std::filesystem::path deltaPath = deltaDirectory / (std::to_string(deltaPackages.size() + 1) + ".msix");
+                std::filesystem::path tempDeltaPath = deltaPath.u8string() + ".dnld.msix";
+                std::filesystem::path deltaIndexPath = GetDesktopContextDeltaIndexPath(details);
+                std::filesystem::path tempIndexPath = deltaIndexPath.u8string() + ".new";
+
+                auto removeTempFilesOnExit = wil::scope_exit([&]()
+                    {
+                        for (const auto& path : { tempDeltaPath, tempIndexPath })
+                        {
+                            try
+                            {
+                                std::filesystem::remove(path);
+                            }
+                            catch (...)
+                            {
+                                AICLI_LOG(Repo, Info, << "Failed to remove temp file at: " << path);
+                            }
+                        }
+                    });
+
+                try
+                {
+                    std::filesystem::create_directories(deltaDirectory);
+
+                    if (Utility::IsUrlRemote(packageLocation))
+                    {
+                        auto downloadResult = AppInstaller::Utility::Download(deltaLocation, tempDeltaPath, AppInstaller::Utility::DownloadType::Index, progress);
+                        downloadedBytes = downloadResult.SizeInBytes;
+                    }
+                    else if (std::filesystem::exists(Utility::ConvertToUTF16(deltaLocation)))
+                    {
+                        std::filesystem::copy(Utility::ConvertToUTF16(deltaLocation), tempDeltaPath);
+                    }
+                    else
+                    {
+                        AICLI_LOG(Repo, Verbose, << "No delta package found at: " << deltaLocation);
+                        return false;
+                    }
+
+                    if (progress.IsCancelledBy(CancelReason::Any))
+                    {
+                        return false;
+                    }
+
+                    Msix::PackageVersion deltaVersion = ValidateDesktopContextPackage(tempDeltaPath, details);
+                    THROW_HR_IF(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE, currentVersion.value() >= deltaVersion);
+
+                    // Prove that the new delta produces the data it claims to before accepting it; the result is kept as the index to open.
+                    deltaPackages.emplace_back(tempDeltaPath);
+                    WriteDesktopContextIndex(details, packagePath, deltaPackages, true, tempIndexPath, progress);
+
+                    if (progress.IsCancelledBy(CancelReason::Any))
+                    {
+                        return false;
+                    }
+
+                    // The index must not be left behind the chain, so the delta is removed again if the index cannot replace the previous one.
+                    std::filesystem::rename(tempDeltaPath, deltaPath);
+                    auto removeDeltaOnFailure = wil::scope_exit([&]()
+                        {
+                            try
+                            {
+                                std::filesystem::remove(deltaPath);
+                            }
+                            catch (...)
+                            {
+                                AICLI_LOG(Repo, Error, << "Failed to remove delta package at: " << deltaPath);
+                            }
+                        });
+
+                    std::filesystem::rename(tempIndexPath, deltaIndexPath);
+                    removeDeltaOnFailure.release();
+                }
+                catch (...)
+                {
+                    if (progress.IsCancelledBy(CancelReason::Any))
+                    {
+                        throw;
+                    }
+
+                    LOG_CAUGHT_EXCEPTION_MSG("Delta update failed, falling back to full package: %hs", deltaLocation.c_str());
+                    return false;
+                }
+
+                AICLI_LOG(Repo, Info, << "Source update success using delta from version " << currentVersion->ToString());
+                return true;
+            }
         };
     }
 
+    std::filesystem::path PreIndexedPackageSourceFactory::GetCompletionIndexPath(const SourceDetails& details)
+    {
+        return GetStatePathFromDetails(details) / s_PreIndexedPackageSourceFactory_CompletionIndexFileName;
+    }
+
     std::unique_ptr<ISourceFactory> PreIndexedPackageSourceFactory::Create()
     {
         if (Runtime::IsRunningInPackagedContext())
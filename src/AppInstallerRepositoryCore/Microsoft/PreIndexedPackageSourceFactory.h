@@ -29,5 +29,8 @@ namespace AppInstaller::Repository::Microsoft
 
         // Creates a source factory for this type.
         static std::unique_ptr<ISourceFactory> Create();
+
+        // Gets the path of the completion index that is written when the source is updated.
+        static std::filesystem::path GetCompletionIndexPath(const SourceDetails& details);
     };
 }
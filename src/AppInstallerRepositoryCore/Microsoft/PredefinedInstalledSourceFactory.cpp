@@ -8,6 +8,7 @@
 #include "Microsoft/SQLiteIndexSource.h"
 #include <winget/ManifestInstaller.h>
 #include <winget/COMStaticStorage.h>
+#include <winget/NameNormalization.h>
 #include <winget/Registry.h>
 #include <AppInstallerArchitecture.h>
 #include <winget/ExperimentalFeature.h>
@@ -280,7 +281,9 @@ namespace AppInstaller::Repository::Microsoft
                 }
             }
 
-            AICLI_LOG(Repo, Verbose, << " ... finished creating PredefinedInstalledSource");
+            Utility::NameNormalizationCacheStatistics normalizationCache = Utility::NameNormalizer::GetCacheStatistics();
+            AICLI_LOG(Repo, Verbose, << " ... finished creating PredefinedInstalledSource; name normalization cache has " << normalizationCache.Entries <<
+                " entries after " << normalizationCache.Hits << " hits and " << normalizationCache.Misses << " misses");
 
             return index;
         }
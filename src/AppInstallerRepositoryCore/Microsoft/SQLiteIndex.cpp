@@ -5,6 +5,7 @@
 #include <winget/SQLiteStorageBase.h>
 #include "ArpVersionValidation.h"
 #include <winget/ManifestYamlParser.h>
+#include <winget/Concurrency.h>
 
 namespace AppInstaller::Repository::Microsoft
 {
@@ -14,6 +15,32 @@ namespace AppInstaller::Repository::Microsoft
         {
             return WI_IsFlagSet(options, SQLiteIndex::CreateOptions::LargePageSize) ? 65536 : 0;
         }
+
+        // The number of manifests parsed per thread before the batch is handed to the writer.
+        // Bounds the number of parsed manifests held in memory at once.
+        constexpr size_t s_AddManifestsBatchSizePerThread = 64;
+
+        // Parses the manifests in [begin, begin + results.size()) using up to the given number of threads.
+        // If any manifest fails to parse, the failure for the earliest manifest in the range is rethrown.
+        void ParseManifestsConcurrently(
+            const std::vector<SQLiteIndex::ManifestFile>& manifests,
+            size_t begin,
+            std::vector<std::optional<Manifest::Manifest>>& results,
+            size_t threadCount)
+        {
+            Utility::ForEachConcurrently(results.size(), [&](size_t i)
+                {
+                    try
+                    {
+                        results[i] = Manifest::YamlParser::CreateFromPath(manifests[begin + i].ManifestPath);
+                    }
+                    catch (...)
+                    {
+                        AICLI_LOG(Repo, Error, << "Failed to parse manifest [" << manifests[begin + i].ManifestPath << "]");
+                        throw;
+                    }
+                }, threadCount);
+        }
     }
 
     SQLiteIndex SQLiteIndex::CreateNew(const std::string& filePath, SQLite::Version version, CreateOptions options)
@@ -114,6 +141,39 @@ namespace AppInstaller::Repository::Microsoft
         return AddManifestInternal(manifest, {});
     }
 
+    std::vector<SQLiteIndex::IdType> SQLiteIndex::AddManifests(const std::vector<ManifestFile>& manifests, size_t maxConcurrency)
+    {
+        AICLI_LOG(Repo, Info, << "Adding " << manifests.size() << " manifests");
+
+        size_t threadCount = maxConcurrency ? maxConcurrency : Utility::GetConcurrentThreadCount(std::numeric_limits<size_t>::max());
+        size_t batchSize = threadCount * s_AddManifestsBatchSizePerThread;
+
+        std::vector<IdType> result;
+        result.reserve(manifests.size());
+
+        std::lock_guard<std::mutex> lockInterface{ *m_interfaceLock };
+
+        // A single transaction for the whole set; the savepoint of each added manifest is nested within it,
+        // so that they no longer each require a commit to disk.
+        SQLite::Savepoint savepoint = SQLite::Savepoint::Create(m_dbconn, "sqliteindex_addmanifests");
+
+        for (size_t begin = 0; begin < manifests.size(); begin += batchSize)
+        {
+            std::vector<std::optional<Manifest::Manifest>> parsed(std::min(batchSize, manifests.size() - begin));
+            ParseManifestsConcurrently(manifests, begin, parsed, threadCount);
+
+            // Insert in input order so that the resulting rows match the serial path.
+            for (size_t i = 0; i < parsed.size(); ++i)
+            {
+                result.emplace_back(AddManifestInternalHoldingLock(parsed[i].value(), manifests[begin + i].RelativePath));
+            }
+        }
+
+        savepoint.Commit();
+
+        return result;
+    }
+
     SQLiteIndex::IdType SQLiteIndex::AddManifestInternal(const Manifest::Manifest& manifest, const std::optional<std::filesystem::path>& relativePath)
     {
         std::lock_guard<std::mutex> lockInterface{ *m_interfaceLock };
@@ -289,6 +349,12 @@ namespace AppInstaller::Repository::Microsoft
         return m_interface->GetMultiPropertyByPrimaryId(m_dbconn, primaryId, property);
     }
 
+    std::vector<std::string> SQLiteIndex::GetAllValues(PackageMatchField field) const
+    {
+        std::lock_guard<std::mutex> lockInterface{ *m_interfaceLock };
+        return m_interface->GetAllValues(m_dbconn, field);
+    }
+
     std::optional<SQLiteIndex::IdType> SQLiteIndex::GetManifestIdByKey(IdType id, std::string_view version, std::string_view channel) const
     {
         std::lock_guard<std::mutex> lockInterface{ *m_interfaceLock };
@@ -374,6 +440,13 @@ namespace AppInstaller::Repository::Microsoft
             m_contextData.Add<Schema::Property::IntermediateFileOutputPath>(std::move(pathValue));
         }
             break;
+        case Property::PreviousPackagedIndexPath:
+        {
+            std::filesystem::path pathValue{ Utility::ConvertToUTF16(value) };
+            THROW_HR_IF(E_INVALIDARG, pathValue.empty() || pathValue.is_relative());
+            m_contextData.Add<Schema::Property::PreviousPackagedIndexPath>(std::move(pathValue));
+        }
+            break;
         }
     }
 }
@@ -40,6 +40,13 @@ namespace AppInstaller::Repository::Microsoft
         // The type of version keys.
         using VersionKey = Schema::ISQLiteIndex::VersionKey;
 
+        // A manifest file and its repository relative path, for use with AddManifests.
+        struct ManifestFile
+        {
+            std::filesystem::path ManifestPath;
+            std::filesystem::path RelativePath;
+        };
+
         SQLiteIndex(const SQLiteIndex&) = delete;
         SQLiteIndex& operator=(const SQLiteIndex&) = delete;
 
@@ -82,6 +89,13 @@ namespace AppInstaller::Repository::Microsoft
         // Returns the manifest id.
         IdType AddManifest(const Manifest::Manifest& manifest);
 
+        // Adds the manifests at the repository relative paths to the index.
+        // Manifests are parsed and validated concurrently on up to maxConcurrency threads (0 for the hardware concurrency),
+        // then inserted in the given order inside a single transaction; the result is the same as calling AddManifest for each in turn.
+        // If the function fails, none of the manifests have been added.
+        // Returns the manifest ids, in the same order as the input.
+        std::vector<IdType> AddManifests(const std::vector<ManifestFile>& manifests, size_t maxConcurrency = 0);
+
         // Updates the manifest with matching { Id, Version, Channel } in the index.
         // The return value indicates whether the index was modified by the function.
         bool UpdateManifest(const std::filesystem::path& manifestPath, const std::filesystem::path& relativePath);
@@ -134,6 +148,9 @@ namespace AppInstaller::Repository::Microsoft
         // Gets the string values for the given property and primary id, if present.
         std::vector<std::string> GetMultiPropertyByPrimaryId(IdType primaryId, PackageVersionMultiProperty property) const;
 
+        // Gets all of the values of the given field, in no particular order and possibly with duplicates.
+        std::vector<std::string> GetAllValues(PackageMatchField field) const;
+
         // Gets the manifest id for the given { id, version, channel }, if present.
         // If version is empty, gets the value for the 'latest' version.
         std::optional<IdType> GetManifestIdByKey(IdType id, std::string_view version, std::string_view channel) const;
@@ -167,6 +184,8 @@ namespace AppInstaller::Repository::Microsoft
         {
             PackageUpdateTrackingBaseTime,
             IntermediateFileOutputPath,
+            // The packaged index produced by the previous PrepareForPackaging; enables incremental packaging.
+            PreviousPackagedIndexPath,
         };
 
         // Sets the given property.
@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "SQLiteIndexChangeset.h"
+#include <winget/SQLiteMetadataTable.h>
+
+namespace AppInstaller::Repository::Microsoft
+{
+    namespace
+    {
+        using namespace std::string_view_literals;
+
+        static constexpr std::string_view s_ChangesetMetadata_BaseContentHash = "changesetBaseContentHash"sv;
+        static constexpr std::string_view s_ChangesetMetadata_TargetContentHash = "changesetTargetContentHash"sv;
+
+        static constexpr std::string_view s_Changeset_UpsertTablePrefix = "upsert_"sv;
+        static constexpr std::string_view s_Changeset_DeleteTablePrefix = "delete_"sv;
+
+        // A table and the columns that uniquely identify its rows.
+        struct TableInfo
+        {
+            std::string Name;
+            std::vector<std::string> Columns;
+            std::vector<std::string> KeyColumns;
+        };
+
+        std::string JoinColumns(const std::vector<std::string>& columns)
+        {
+            std::ostringstream stream;
+            bool first = true;
+
+            for (const auto& column : columns)
+            {
+                if (!first)
+                {
+                    stream << ", ";
+                }
+                first = false;
+
+                stream << '[' << column << ']';
+            }
+
+            return std::move(stream).str();
+        }
+
+        void Execute(const SQLite::Connection& connection, const std::string& sql)
+        {
+            SQLite::Statement statement = SQLite::Statement::Create(connection, sql);
+            statement.Execute();
+        }
+
+        void Attach(const SQLite::Connection& connection, const std::filesystem::path& path, std::string_view schemaName)
+        {
+            std::ostringstream stream;
+            stream << "ATTACH DATABASE ? AS [" << schemaName << ']';
+
+            SQLite::Statement attach = SQLite::Statement::Create(connection, stream.str());
+            attach.Bind(1, path.u8string());
+            attach.Execute();
+        }
+
+        void Detach(const SQLite::Connection& connection, std::string_view schemaName)
+        {
+            std::ostringstream stream;
+            stream << "DETACH DATABASE [" << schemaName << ']';
+
+            Execute(connection, stream.str());
+        }
+
+        // Gets the user tables in the schema, ordered by name.
+        std::vector<TableInfo> GetTables(const SQLite::Connection& connection, std::string_view schemaName)
+        {
+            std::vector<TableInfo> result;
+
+            {
+                std::ostringstream stream;
+                stream << "SELECT [name] FROM [" << schemaName << "].[sqlite_master] WHERE [type] = 'table' AND [name] NOT LIKE 'sqlite_%' ORDER BY [name]";
+
+                SQLite::Statement select = SQLite::Statement::Create(connection, stream.str());
+
+                while (select.Step())
+                {
+                    result.emplace_back(TableInfo{ select.GetColumn<std::string>(0) });
+                }
+            }
+
+            for (auto& table : result)
+            {
+                std::ostringstream stream;
+                stream << "PRAGMA [" << schemaName << "].table_info([" << table.Name << "])";
+
+                SQLite::Statement tableInfo = SQLite::Statement::Create(connection, stream.str());
+                std::vector<std::pair<int, std::string>> keyColumns;
+
+                // Columns are: cid, name, type, notnull, dflt_value, pk
+                while (tableInfo.Step())
+                {
+                    std::string columnName = tableInfo.GetColumn<std::string>(1);
+                    int keyPosition = tableInfo.GetColumn<int>(5);
+
+                    if (keyPosition > 0)
+                    {
+                        keyColumns.emplace_back(keyPosition, columnName);
+                    }
+
+                    table.Columns.emplace_back(std::move(columnName));
+                }
+
+                THROW_HR_IF_MSG(E_INVALIDARG, keyColumns.empty(), "Table has no primary key: %hs", table.Name.c_str());
+
+                std::sort(keyColumns.begin(), keyColumns.end());
+
+                for (auto& keyColumn : keyColumns)
+                {
+                    table.KeyColumns.emplace_back(std::move(keyColumn.second));
+                }
+            }
+
+            return result;
+        }
+
+        // Gets the definition of every object in the schema, ordered by name.
+        std::string GetSchemaDefinition(const SQLite::Connection& connection, std::string_view schemaName)
+        {
+            std::ostringstream stream;
+            stream << "SELECT [type], [name], [sql] FROM [" << schemaName << "].[sqlite_master] WHERE [sql] IS NOT NULL ORDER BY [name]";
+
+            SQLite::Statement select = SQLite::Statement::Create(connection, stream.str());
+
+            std::ostringstream result;
+
+            while (select.Step())
+            {
+                result << select.GetColumn<std::string>(0) << '\n' << select.GetColumn<std::string>(1) << '\n' << select.GetColumn<std::string>(2) << '\n';
+            }
+
+            return std::move(result).str();
+        }
+
+        bool TableExists(const SQLite::Connection& connection, std::string_view schemaName, const std::string& tableName)
+        {
+            std::ostringstream stream;
+            stream << "SELECT COUNT(*) FROM [" << schemaName << "].[sqlite_master] WHERE [type] = 'table' AND [name] = ?";
+
+            SQLite::Statement select = SQLite::Statement::Create(connection, stream.str());
+            select.Bind(1, tableName);
+            THROW_HR_IF(E_UNEXPECTED, !select.Step());
+
+            return select.GetColumn<int>(0) != 0;
+        }
+
+        std::string GetChangesetValue(const SQLite::Connection& connection, std::string_view name)
+        {
+            SQLite::Statement select = SQLite::Statement::Create(connection, "SELECT [value] FROM [changeset].[metadata] WHERE [name] = ?"sv);
+            select.Bind(1, name);
+            THROW_HR_IF_MSG(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE, !select.Step(), "Changeset is missing value: %hs", std::string{ name }.c_str());
+
+            return select.GetColumn<std::string>(0);
+        }
+    }
+
+    void SQLiteIndexChangeset::Create(const std::filesystem::path& baseIndexPath, const std::filesystem::path& targetIndexPath, const std::filesystem::path& changesetPath)
+    {
+        SQLite::Connection connection = SQLite::Connection::Create(changesetPath.u8string(), SQLite::Connection::OpenDisposition::Create);
+
+        Attach(connection, baseIndexPath, "base");
+        auto detachBase = wil::scope_exit([&]()
+            {
+                try
+                {
+                    Detach(connection, "base");
+                }
+                CATCH_LOG();
+            });
+
+        Attach(connection, targetIndexPath, "target");
+        auto detachTarget = wil::scope_exit([&]()
+            {
+                try
+                {
+                    Detach(connection, "target");
+                }
+                CATCH_LOG();
+            });
+
+        THROW_HR_IF_MSG(E_INVALIDARG, GetSchemaDefinition(connection, "base") != GetSchemaDefinition(connection, "target"),
+            "The base and target indices have different schemas; a changeset cannot be created");
+
+        {
+            SQLite::Savepoint savepoint = SQLite::Savepoint::Create(connection, "changeset_create");
+
+            SQLite::MetadataTable::Create(connection);
+            SQLite::MetadataTable::SetNamedValue(connection, s_ChangesetMetadata_BaseContentHash, Utility::SHA256::ConvertToString(ComputeContentHash(connection, "base")));
+            SQLite::MetadataTable::SetNamedValue(connection, s_ChangesetMetadata_TargetContentHash, Utility::SHA256::ConvertToString(ComputeContentHash(connection, "target")));
+
+            for (const auto& table : GetTables(connection, "target"))
+            {
+                std::string keyColumns = JoinColumns(table.KeyColumns);
+
+                std::ostringstream createUpsert;
+                createUpsert << "CREATE TABLE [main].[" << s_Changeset_UpsertTablePrefix << table.Name << "] AS SELECT * FROM [target].[" << table.Name << "] WHERE 0";
+                Execute(connection, createUpsert.str());
+
+                std::ostringstream insertUpsert;
+                insertUpsert << "INSERT INTO [main].[" << s_Changeset_UpsertTablePrefix << table.Name << "] SELECT * FROM [target].[" << table.Name <<
+                    "] EXCEPT SELECT * FROM [base].[" << table.Name << ']';
+                Execute(connection, insertUpsert.str());
+
+                std::ostringstream createDelete;
+                createDelete << "CREATE TABLE [main].[" << s_Changeset_DeleteTablePrefix << table.Name << "] AS SELECT " << keyColumns << " FROM [target].[" << table.Name << "] WHERE 0";
+                Execute(connection, createDelete.str());
+
+                std::ostringstream insertDelete;
+                insertDelete << "INSERT INTO [main].[" << s_Changeset_DeleteTablePrefix << table.Name << "] SELECT " << keyColumns << " FROM [base].[" << table.Name <<
+                    "] EXCEPT SELECT " << keyColumns << " FROM [target].[" << table.Name << ']';
+                Execute(connection, insertDelete.str());
+            }
+
+            savepoint.Commit();
+        }
+    }
+
+    void SQLiteIndexChangeset::Apply(const std::filesystem::path& indexPath, const std::filesystem::path& changesetPath, bool verify)
+    {
+        SQLite::Connection connection = SQLite::Connection::Create(indexPath.u8string(), SQLite::Connection::OpenDisposition::ReadWrite);
+
+        Attach(connection, changesetPath, "changeset");
+        auto detachChangeset = wil::scope_exit([&]()
+            {
+                try
+                {
+                    Detach(connection, "changeset");
+                }
+                CATCH_LOG();
+            });
+
+        SQLite::Savepoint savepoint = SQLite::Savepoint::Create(connection, "changeset_apply");
+
+        if (verify && Utility::SHA256::ConvertToString(ComputeContentHash(connection)) != GetChangesetValue(connection, s_ChangesetMetadata_BaseContentHash))
+        {
+            AICLI_LOG(Repo, Error, << "The index does not match the base of the changeset");
+            THROW_HR(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE);
+        }
+
+        for (const auto& table : GetTables(connection, "main"))
+        {
+            std::string deleteTable{ s_Changeset_DeleteTablePrefix };
+            deleteTable += table.Name;
+
+            std::string upsertTable{ s_Changeset_UpsertTablePrefix };
+            upsertTable += table.Name;
+
+            THROW_HR_IF_MSG(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE,
+                !TableExists(connection, "changeset", deleteTable) || !TableExists(connection, "changeset", upsertTable),
+                "Changeset does not contain table: %hs", table.Name.c_str());
+
+            std::string keyColumns = JoinColumns(table.KeyColumns);
+
+            std::ostringstream deleteRows;
+            deleteRows << "DELETE FROM [main].[" << table.Name << "] WHERE (" << keyColumns << ") IN (SELECT " << keyColumns << " FROM [changeset].[" << deleteTable << "])";
+            Execute(connection, deleteRows.str());
+
+            std::ostringstream upsertRows;
+            upsertRows << "INSERT OR REPLACE INTO [main].[" << table.Name << "] SELECT * FROM [changeset].[" << upsertTable << ']';
+            Execute(connection, upsertRows.str());
+        }
+
+        if (verify && Utility::SHA256::ConvertToString(ComputeContentHash(connection)) != GetChangesetValue(connection, s_ChangesetMetadata_TargetContentHash))
+        {
+            AICLI_LOG(Repo, Error, << "The index does not match the target of the changeset after applying it");
+            THROW_HR(APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE);
+        }
+
+        savepoint.Commit();
+    }
+
+    Utility::SHA256::HashBuffer SQLiteIndexChangeset::ComputeContentHash(const SQLite::Connection& connection, std::string_view schemaName)
+    {
+        Utility::SHA256 hash;
+
+        auto addString = [&](const std::string& value)
+            {
+                // Include the terminating null to separate the values
+                hash.Add(reinterpret_cast<const uint8_t*>(value.c_str()), value.size() + 1);
+            };
+
+        addString(GetSchemaDefinition(connection, schemaName));
+
+        std::string row;
+
+        for (const auto& table : GetTables(connection, schemaName))
+        {
+            addString(table.Name);
+
+            // quote() produces an unambiguous text form of every value, including its type
+            std::ostringstream stream;
+            stream << "SELECT ";
+
+            for (size_t i = 0; i < table.Columns.size(); ++i)
+            {
+                stream << (i ? ", " : "") << "quote([" << table.Columns[i] << "])";
+            }
+
+            stream << " FROM [" << schemaName << "].[" << table.Name << "] ORDER BY " << JoinColumns(table.KeyColumns);
+
+            SQLite::Statement select = SQLite::Statement::Create(connection, stream.str());
+            int columnCount = static_cast<int>(table.Columns.size());
+
+            while (select.Step())
+            {
+                row.clear();
+
+                for (int i = 0; i < columnCount; ++i)
+                {
+                    row += select.GetColumn<std::string>(i);
+                    row += '\0';
+                }
+
+                addString(row);
+            }
+        }
+
+        return hash.Get();
+    }
+}
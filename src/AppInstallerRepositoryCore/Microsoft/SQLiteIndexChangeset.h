@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <winget/SQLiteWrapper.h>
+#include <AppInstallerSHA256.h>
+
+#include <filesystem>
+#include <string_view>
+
+namespace AppInstaller::Repository::Microsoft
+{
+    // A row level changeset that transforms one packaged index into another.
+    // The changeset is itself a SQLite database; for every table in the index it contains
+    // the rows to insert or replace, and the primary keys of the rows to delete.
+    // It also records the content hashes of the base and target so that a broken chain is detected.
+    struct SQLiteIndexChangeset
+    {
+        // Creates a changeset at the given path that transforms the base index into the target index.
+        // Both indices must have the same schema, and every table must have a primary key.
+        static void Create(const std::filesystem::path& baseIndexPath, const std::filesystem::path& targetIndexPath, const std::filesystem::path& changesetPath);
+
+        // Applies the changeset to the index at the given path.
+        // When verify is true, the index must match the base content hash before the changes are applied,
+        // and the target content hash afterward; APPINSTALLER_CLI_ERROR_SOURCE_DATA_INTEGRITY_FAILURE is thrown if not.
+        static void Apply(const std::filesystem::path& indexPath, const std::filesystem::path& changesetPath, bool verify = true);
+
+        // Computes a hash of the logical content of the database in the given schema.
+        // Unlike a hash of the file, this does not depend on the page layout chosen by the SQLite version that wrote it.
+        static Utility::SHA256::HashBuffer ComputeContentHash(const SQLite::Connection& connection, std::string_view schemaName = "main");
+    };
+}
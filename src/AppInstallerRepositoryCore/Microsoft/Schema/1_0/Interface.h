@@ -46,6 +46,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
 
         // Version 2.0
         bool MigrateFrom(SQLite::Connection& connection, const ISQLiteIndex* current) override;
+        std::vector<std::string> GetAllValues(const SQLite::Connection& connection, PackageMatchField field) const override;
 
     protected:
         virtual bool NotNeeded(const SQLite::Connection& connection, std::string_view tableName, std::string_view valueName, SQLite::rowid_t id) const;
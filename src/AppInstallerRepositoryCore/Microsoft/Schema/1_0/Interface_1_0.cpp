@@ -578,6 +578,11 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         return false;
     }
 
+    std::vector<std::string> Interface::GetAllValues(const SQLite::Connection& connection, PackageMatchField field) const
+    {
+        return SearchResultsTable::GetAllValues(connection, field);
+    }
+
     std::vector<ISQLiteIndex::VersionKey> Interface::GetVersionKeysById(const SQLite::Connection& connection, SQLite::rowid_t id) const
     {
         auto versionsAndChannels = ManifestTable::GetAllValuesById<IdTable, VersionTable, ChannelTable>(connection, id);
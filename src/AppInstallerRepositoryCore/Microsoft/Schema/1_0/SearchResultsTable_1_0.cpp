@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "SearchResultsTable.h"
+#include "Microsoft/Schema/FuzzyMatcher.h"
+#include "Microsoft/Schema/SearchResultRanker.h"
 #include <winget/SQLiteStatementBuilder.h>
 
 #include "Microsoft/Schema/1_0/IdTable.h"
@@ -31,6 +33,23 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         constexpr std::string_view s_SearchResultsTable_SubSelect_TableAlias = "valueTable"sv;
         constexpr std::string_view s_SearchResultsTable_SubSelect_ManifestAlias = "m"sv;
         constexpr std::string_view s_SearchResultsTable_SubSelect_ValueAlias = "v"sv;
+
+        // Gets every value in the data table; rows are only removed once no manifest references them.
+        template <typename Table>
+        std::vector<std::string> GetAllTableValues(const SQLite::Connection& connection)
+        {
+            SQLite::Builder::StatementBuilder builder;
+            builder.Select(Table::ValueName()).From(Table::TableName());
+
+            SQLite::Statement select = builder.Prepare(connection);
+
+            std::vector<std::string> result;
+            while (select.Step())
+            {
+                result.emplace_back(select.GetColumn<std::string>(0));
+            }
+            return result;
+        }
     }
 
     SearchResultsTable::SearchResultsTable(const SQLite::Connection& connection) :
@@ -74,6 +93,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         using namespace SQLite::Builder;
 
         int sortOrdinal = m_sortOrdinalValue++;
+        m_searchValues.emplace_back(SearchResultRanker::PrepareSearchValue(filter.Value));
 
         // Create an insert statement to select values into the table as requested.
         // The goal is a statement like this:
@@ -91,8 +111,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
             Value(false).
         From().BeginParenthetical();
 
-        // Add the field specific portion
-        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, filter.Type);
+        // Add the field specific portion; fuzzy matches are found outside of the database, then each matched value is selected exactly.
+        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, MatchIsFuzzy(filter.Type) ? MatchType::Exact : filter.Type);
 
         if (bindIndex.empty())
         {
@@ -103,9 +123,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         builder.EndParenthetical().As(s_SearchResultsTable_SubSelect_TableAlias);
 
         SQLite::Statement statement = builder.Prepare(m_connection);
-        BindStatementForMatchType(statement, filter, bindIndex);
-        statement.Execute();
-        AICLI_LOG(SQL, Verbose, << "Search found " << m_connection.GetChanges() << " rows");
+        int changes = ExecuteStatementForFilter(statement, filter, bindIndex);
+        AICLI_LOG(SQL, Verbose, << "Search found " << changes << " rows");
     }
 
     void SearchResultsTable::RemoveDuplicateManifestRows()
@@ -157,7 +176,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
             Select(s_SearchResultsTable_SubSelect_ManifestAlias).From().BeginParenthetical();
 
         // Add the field specific portion
-        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, filter.Type);
+        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, MatchIsFuzzy(filter.Type) ? MatchType::Exact : filter.Type);
 
         if (bindIndex.empty())
         {
@@ -168,9 +187,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         builder.EndParenthetical().EndParenthetical();
 
         SQLite::Statement statement = builder.Prepare(m_connection);
-        BindStatementForMatchType(statement, filter, bindIndex);
-        statement.Execute();
-        AICLI_LOG(SQL, Verbose, << "Filter kept " << m_connection.GetChanges() << " rows");
+        int changes = ExecuteStatementForFilter(statement, filter, bindIndex);
+        AICLI_LOG(SQL, Verbose, << "Filter kept " << changes << " rows");
     }
 
     void SearchResultsTable::CompleteFilter()
@@ -208,21 +226,42 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
 
         SQLite::Statement select = builder.Prepare(m_connection);
 
-        ISQLiteIndex::SearchResult result;
+        // Rank the matches of each sort ordinal by how well they fit the searched value; the ordering of the rows
+        // allows the ranking to stop at the first ordinal after the limit is reached.
+        SearchResultRanker ranker{ m_searchValues, limit };
         while (select.Step())
         {
-            if (limit && result.Matches.size() >= limit)
+            int sortOrdinal = select.GetColumn<int>(4);
+            if (ranker.IsComplete(sortOrdinal))
             {
+                ranker.SetTruncated();
                 break;
             }
 
-            result.Matches.emplace_back(select.GetColumn<SQLite::rowid_t>(0), 
+            ranker.Add(sortOrdinal, select.GetColumn<SQLite::rowid_t>(0),
                 PackageMatchFilter(select.GetColumn<PackageMatchField>(1), select.GetColumn<MatchType>(2), select.GetColumn<std::string>(3)));
         }
 
-        result.Truncated = (select.GetState() != SQLite::Statement::State::Completed);
+        return ranker.GetResults();
+    }
 
-        return result;
+    std::vector<std::string> SearchResultsTable::GetAllValues(const SQLite::Connection& connection, PackageMatchField field)
+    {
+        switch (field)
+        {
+        case PackageMatchField::Id:
+            return GetAllTableValues<IdTable>(connection);
+        case PackageMatchField::Name:
+            return GetAllTableValues<NameTable>(connection);
+        case PackageMatchField::Moniker:
+            return GetAllTableValues<MonikerTable>(connection);
+        case PackageMatchField::Tag:
+            return GetAllTableValues<TagsTable>(connection);
+        case PackageMatchField::Command:
+            return GetAllTableValues<CommandsTable>(connection);
+        default:
+            THROW_WIN32(ERROR_NOT_SUPPORTED);
+        }
     }
 
     std::vector<int> SearchResultsTable::BuildSearchStatement(SQLite::Builder::StatementBuilder& builder, PackageMatchField field, MatchType match) const
@@ -259,6 +298,11 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
         return (match != MatchType::Exact);
     }
 
+    bool SearchResultsTable::MatchIsFuzzy(MatchType match)
+    {
+        return (match == MatchType::Fuzzy || match == MatchType::FuzzySubstring);
+    }
+
     void SearchResultsTable::BindStatementForMatchType(SQLite::Statement& statement, MatchType match, int bindIndex, std::string_view value)
     {
         std::string valueToUse;
@@ -290,8 +334,9 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
 
     void SearchResultsTable::BindStatementForMatchType(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex)
     {
-        // TODO: Implement these more complex match types
-        if (filter.Type == MatchType::Wildcard || filter.Type == MatchType::Fuzzy || filter.Type == MatchType::FuzzySubstring)
+        // TODO: Implement wildcard matching
+        // Fuzzy matches are bound to each matched value by ExecuteStatementForFilter.
+        if (filter.Type == MatchType::Wildcard || MatchIsFuzzy(filter.Type))
         {
             AICLI_LOG(Repo, Verbose, << "Specific match type not implemented, skipping: " << ToString(filter.Type));
             return;
@@ -299,4 +344,60 @@ namespace AppInstaller::Repository::Microsoft::Schema::V1_0
 
         BindStatementForMatchType(statement, filter.Type, bindIndex[0], filter.Value);
     }
+
+    std::vector<std::string> SearchResultsTable::GetFuzzyMatchValues(const PackageMatchFilter& filter)
+    {
+        FuzzyMatcher matcher{ filter.Value, filter.Type == MatchType::FuzzySubstring };
+
+        // Without any tolerance, a fuzzy match finds nothing more than the case insensitive or substring match that precedes it.
+        if (!matcher.GetMaximumDistance())
+        {
+            return {};
+        }
+
+        switch (filter.Field)
+        {
+        case PackageMatchField::Id:
+        case PackageMatchField::Name:
+        case PackageMatchField::Moniker:
+        case PackageMatchField::Tag:
+        case PackageMatchField::Command:
+            break;
+        default:
+            AICLI_LOG(Repo, Verbose, << "Fuzzy match not supported for field: " << ToString(filter.Field));
+            return {};
+        }
+
+        auto itr = m_fuzzyMatchCandidates.find(filter.Field);
+        if (itr == m_fuzzyMatchCandidates.end())
+        {
+            itr = m_fuzzyMatchCandidates.emplace(filter.Field, GetAllValues(m_connection, filter.Field)).first;
+        }
+
+        std::vector<std::string> result = matcher.GetMatches(itr->second);
+        AICLI_LOG(Repo, Verbose, << "Fuzzy match found " << result.size() << " of " << itr->second.size() << " values");
+        return result;
+    }
+
+    int SearchResultsTable::ExecuteStatementForFilter(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex)
+    {
+        if (!MatchIsFuzzy(filter.Type))
+        {
+            BindStatementForMatchType(statement, filter, bindIndex);
+            statement.Execute();
+            return m_connection.GetChanges();
+        }
+
+        int result = 0;
+
+        for (const auto& value : GetFuzzyMatchValues(filter))
+        {
+            statement.Reset();
+            BindStatementForMatchType(statement, MatchType::Exact, bindIndex[0], value);
+            statement.Execute();
+            result += m_connection.GetChanges();
+        }
+
+        return result;
+    }
 }
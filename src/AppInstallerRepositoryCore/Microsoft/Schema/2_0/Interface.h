@@ -14,6 +14,10 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
 {
     // Version 2.0
     static constexpr std::string_view s_MetadataValueName_PackageUpdateTrackingBaseTime = "updateTrackingBase"sv;
+    static constexpr std::string_view s_MetadataValueName_PackagingWriteTime = "packagingWriteTime"sv;
+
+    // The fraction of free pages at which PrepareForPackaging will vacuum the database.
+    static constexpr double s_PackagingVacuumFreePageRatioThreshold = 0.1;
 
     // Interface to this schema version exposed through ISQLiteIndex.
     struct Interface : public ISQLiteIndex
@@ -54,6 +58,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         // Version 2.0
         bool MigrateFrom(SQLite::Connection& connection, const ISQLiteIndex* current) override;
         void SetProperty(SQLite::Connection& connection, Property property, const std::string& value) override;
+        std::vector<std::string> GetAllValues(const SQLite::Connection& connection, PackageMatchField field) const override;
 
     protected:
         // Creates the search results table.
@@ -74,6 +79,12 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         // Prepares for packaging, optionally vacuuming the database.
         virtual void PrepareForPackaging(const SQLiteIndexContext& context, bool vacuum);
 
+        // Adds the package from the internal index, with all of its versions, to the 2.0 tables.
+        void AddPackageFromInternalIndex(SQLite::Connection& connection, SQLite::rowid_t internalPackageId);
+
+        // Updates the 2.0 tables copied from a previous packaged index with the packages changed since it was created.
+        void UpdatePackagesFromInternalIndex(SQLite::Connection& connection, int64_t previousPackagingWriteTime);
+
         // Force the database to shrink the file size.
         // This *must* be done outside of an active transaction.
         void Vacuum(const SQLite::Connection& connection);
@@ -24,6 +24,165 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
 {
     namespace anon
     {
+        // Logs the time spent in each stage of PrepareForPackaging.
+        struct PackagingTimer
+        {
+            using clock = std::chrono::steady_clock;
+
+            struct StageTimer
+            {
+                StageTimer(std::string_view stage) : m_stage(stage), m_start(clock::now()) {}
+
+                ~StageTimer()
+                {
+                    AICLI_LOG(Repo, Info, << "PrepareForPackaging stage [" << m_stage << "] took " <<
+                        std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - m_start).count() << " ms");
+                }
+
+            private:
+                std::string_view m_stage;
+                clock::time_point m_start;
+            };
+
+            PackagingTimer() : m_start(clock::now()) {}
+
+            ~PackagingTimer()
+            {
+                AICLI_LOG(Repo, Info, << "PrepareForPackaging took " << std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - m_start).count() << " ms");
+            }
+
+            StageTimer MeasureStage(std::string_view stage) { return StageTimer{ stage }; }
+
+        private:
+            clock::time_point m_start;
+        };
+
+        // Detaches the previous packaged index. This runs from a scope guard, so failures are logged rather than thrown;
+        // the attachment only lasts as long as the connection anyway.
+        void DetachPreviousPackagedIndex(SQLite::Connection& connection) noexcept try
+        {
+            SQLite::Statement detach = SQLite::Statement::Create(connection, "DETACH DATABASE [previous]"sv);
+            detach.Execute();
+        }
+        CATCH_LOG_MSG("Failed to detach previous packaged index")
+
+        // Attaches the previous packaged index if it can be used to incrementally package this index.
+        // Returns the write time that the previous packaged index was created from, or nullopt if it was not attached.
+        std::optional<int64_t> TryAttachPreviousPackagedIndex(SQLite::Connection& connection, const std::filesystem::path& path)
+        {
+            if (!std::filesystem::exists(path))
+            {
+                AICLI_LOG(Repo, Info, << "Previous packaged index not found, performing full packaging: " << path);
+                return std::nullopt;
+            }
+
+            try
+            {
+                SQLite::Statement attach = SQLite::Statement::Create(connection, "ATTACH DATABASE ? AS [previous]"sv);
+                attach.Bind(1, path.u8string());
+                attach.Execute();
+            }
+            catch (...)
+            {
+                LOG_CAUGHT_EXCEPTION_MSG("Failed to attach previous packaged index, performing full packaging");
+                return std::nullopt;
+            }
+
+            std::optional<int64_t> result;
+
+            try
+            {
+                // The previous packaged index must come from this same database at the same schema version
+                SQLite::Statement matchingMetadata = SQLite::Statement::Create(connection,
+                    "SELECT COUNT(*) FROM [main].[metadata] AS m JOIN [previous].[metadata] AS p ON m.[name] = p.[name] AND m.[value] = p.[value] WHERE m.[name] IN (?, ?, ?)"sv);
+                matchingMetadata.Bind(1, SQLite::s_MetadataValueName_DatabaseIdentifier);
+                matchingMetadata.Bind(2, SQLite::s_MetadataValueName_MajorVersion);
+                matchingMetadata.Bind(3, SQLite::s_MetadataValueName_MinorVersion);
+                THROW_HR_IF(E_UNEXPECTED, !matchingMetadata.Step());
+
+                SQLite::Statement packagingWriteTime = SQLite::Statement::Create(connection, "SELECT [value] FROM [previous].[metadata] WHERE [name] = ?"sv);
+                packagingWriteTime.Bind(1, s_MetadataValueName_PackagingWriteTime);
+
+                if (matchingMetadata.GetColumn<int>(0) != 3)
+                {
+                    AICLI_LOG(Repo, Info, << "Previous packaged index is not from this index, performing full packaging");
+                }
+                else if (!packagingWriteTime.Step())
+                {
+                    AICLI_LOG(Repo, Info, << "Previous packaged index does not contain a packaging write time, performing full packaging");
+                }
+                else
+                {
+                    result = std::stoll(packagingWriteTime.GetColumn<std::string>(0));
+                    AICLI_LOG(Repo, Info, << "Performing incremental packaging from updates since " << result.value());
+                }
+            }
+            CATCH_LOG();
+
+            if (!result)
+            {
+                DetachPreviousPackagedIndex(connection);
+            }
+
+            return result;
+        }
+
+        // Copies the rows of a table from the previous packaged index into the matching table of this one.
+        void CopyTableFromPreviousPackagedIndex(SQLite::Connection& connection, std::string_view tableName)
+        {
+            std::ostringstream stream;
+            stream << "INSERT INTO [main].[" << tableName << "] SELECT * FROM [previous].[" << tableName << "]";
+
+            SQLite::Statement copy = SQLite::Statement::Create(connection, stream.str());
+            copy.Execute();
+        }
+
+        // Copies all of the 2.0 tables from the previous packaged index.
+        // Explicit rowids are preserved, so the references between tables remain valid.
+        void CopyTablesFromPreviousPackagedIndex(SQLite::Connection& connection)
+        {
+            CopyTableFromPreviousPackagedIndex(connection, PackagesTable::TableName());
+
+            CopyTableFromPreviousPackagedIndex(connection, TagsTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, details::OneToManyTableGetMapTableName(TagsTable::TableName()));
+            CopyTableFromPreviousPackagedIndex(connection, CommandsTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, details::OneToManyTableGetMapTableName(CommandsTable::TableName()));
+
+            CopyTableFromPreviousPackagedIndex(connection, PackageFamilyNameTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, ProductCodeTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, NormalizedPackageNameTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, NormalizedPackagePublisherTable::TableName());
+            CopyTableFromPreviousPackagedIndex(connection, UpgradeCodeTable::TableName());
+        }
+
+        // Removes the package and all of the data that refers to it.
+        void RemovePackage(SQLite::Connection& connection, SQLite::rowid_t packageId)
+        {
+            TagsTable::DeleteIfNotNeededByPrimaryId(connection, packageId);
+            CommandsTable::DeleteIfNotNeededByPrimaryId(connection, packageId);
+
+            PackageFamilyNameTable::DeleteByPrimaryId(connection, packageId);
+            ProductCodeTable::DeleteByPrimaryId(connection, packageId);
+            NormalizedPackageNameTable::DeleteByPrimaryId(connection, packageId);
+            NormalizedPackagePublisherTable::DeleteByPrimaryId(connection, packageId);
+            UpgradeCodeTable::DeleteByPrimaryId(connection, packageId);
+
+            PackagesTable::DeleteById(connection, packageId);
+        }
+
+        // Gets the fraction of the database pages that are unused.
+        double GetFreePageRatio(const SQLite::Connection& connection)
+        {
+            SQLite::Statement pageCount = SQLite::Statement::Create(connection, "PRAGMA page_count"sv);
+            THROW_HR_IF(E_UNEXPECTED, !pageCount.Step());
+
+            SQLite::Statement freePageCount = SQLite::Statement::Create(connection, "PRAGMA freelist_count"sv);
+            THROW_HR_IF(E_UNEXPECTED, !freePageCount.Step());
+
+            int64_t pages = pageCount.GetColumn<int64_t>(0);
+            return pages ? static_cast<double>(freePageCount.GetColumn<int64_t>(0)) / static_cast<double>(pages) : 0;
+        }
+
         // Folds the values of the fields that are stored folded.
         void FoldPackageMatchFilters(std::vector<PackageMatchFilter>& filters)
         {
@@ -434,6 +593,18 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         }
     }
 
+    std::vector<std::string> Interface::GetAllValues(const SQLite::Connection& connection, PackageMatchField field) const
+    {
+        EnsureInternalInterface(connection);
+
+        if (m_internalInterface)
+        {
+            return m_internalInterface->GetAllValues(connection, field);
+        }
+
+        return SearchResultsTable::GetAllValues(connection, field);
+    }
+
     std::unique_ptr<SearchResultsTable> Interface::CreateSearchResultsTable(const SQLite::Connection& connection) const
     {
         return std::make_unique<SearchResultsTable>(connection);
@@ -620,6 +791,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
     {
         SQLite::Connection& connection = context.Connection;
 
+        anon::PackagingTimer timer;
+
         // Get the base time from metadata
         int64_t updateBaseTime = 0;
         std::optional<std::string> updateBaseTimeString = SQLite::MetadataTable::TryGetNamedValue<std::string>(connection, s_MetadataValueName_PackageUpdateTrackingBaseTime);
@@ -643,25 +816,47 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
 
         THROW_WIN32_IF(ERROR_INVALID_STATE, baseOutputDirectory.empty() || baseOutputDirectory.is_relative());
 
-        // Output all of the changed package version manifests since the base time to the target location
-        for (const auto& packageData : PackageUpdateTrackingTable::GetUpdatesSince(connection, updateBaseTime))
         {
-            std::filesystem::path packageDirectory = baseOutputDirectory /
-                Manifest::PackageVersionDataManifest::GetRelativeDirectoryPath(packageData.PackageIdentifier, Utility::SHA256::ConvertToString(packageData.Hash));
+            auto stageTimer = timer.MeasureStage("writeVersionData");
 
-            std::filesystem::create_directories(packageDirectory);
+            // Output all of the changed package version manifests since the base time to the target location
+            for (const auto& packageData : PackageUpdateTrackingTable::GetUpdatesSince(connection, updateBaseTime))
+            {
+                std::filesystem::path packageDirectory = baseOutputDirectory /
+                    Manifest::PackageVersionDataManifest::GetRelativeDirectoryPath(packageData.PackageIdentifier, Utility::SHA256::ConvertToString(packageData.Hash));
 
-            std::filesystem::path manifestPath = packageDirectory / Manifest::PackageVersionDataManifest::VersionManifestCompressedFileName();
+                std::filesystem::create_directories(packageDirectory);
 
-            AICLI_LOG(Repo, Info, << "Writing PackageVersionDataManifest for [" << packageData.PackageIdentifier << "] to [" << manifestPath << "]");
+                std::filesystem::path manifestPath = packageDirectory / Manifest::PackageVersionDataManifest::VersionManifestCompressedFileName();
 
-            std::ofstream stream(manifestPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-            THROW_LAST_ERROR_IF(stream.fail());
-            stream.write(reinterpret_cast<const char*>(packageData.Manifest.data()), packageData.Manifest.size());
-            THROW_LAST_ERROR_IF(stream.fail());
-            stream.flush();
+                AICLI_LOG(Repo, Info, << "Writing PackageVersionDataManifest for [" << packageData.PackageIdentifier << "] to [" << manifestPath << "]");
+
+                std::ofstream stream(manifestPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+                THROW_LAST_ERROR_IF(stream.fail());
+                stream.write(reinterpret_cast<const char*>(packageData.Manifest.data()), packageData.Manifest.size());
+                THROW_LAST_ERROR_IF(stream.fail());
+                stream.flush();
+            }
         }
 
+        // Record the latest tracked write so that the next packaging knows which packages it must regenerate
+        int64_t packagingWriteTime = PackageUpdateTrackingTable::GetLatestWriteTime(connection);
+
+        // The previous packaged index must be attached outside of any transaction
+        std::optional<int64_t> previousPackagingWriteTime;
+        if (context.Data.Contains(Property::PreviousPackagedIndexPath))
+        {
+            previousPackagingWriteTime = anon::TryAttachPreviousPackagedIndex(connection, context.Data.Get<Property::PreviousPackagedIndexPath>());
+        }
+
+        auto detachPrevious = wil::scope_exit([&]()
+            {
+                if (previousPackagingWriteTime)
+                {
+                    anon::DetachPreviousPackagedIndex(connection);
+                }
+            });
+
         SQLite::Savepoint savepoint = SQLite::Savepoint::Create(connection, "prepareforpackaging_v2_0");
 
         // Create the 2.0 data tables
@@ -684,81 +879,166 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         NormalizedPackagePublisherTable::Create(connection);
         UpgradeCodeTable::Create(connection);
 
-        // Copy data from 1.7 tables to 2.0 tables
-        SearchResult allPackages = m_internalInterface->Search(connection, {});
+        if (previousPackagingWriteTime)
+        {
+            {
+                auto stageTimer = timer.MeasureStage("copyPrevious");
+                anon::CopyTablesFromPreviousPackagedIndex(connection);
+            }
 
-        for (const auto& packageMatch : allPackages.Matches)
+            auto stageTimer = timer.MeasureStage("updatePackages");
+            UpdatePackagesFromInternalIndex(connection, previousPackagingWriteTime.value());
+        }
+        else
         {
-            std::vector<ISQLiteIndex::VersionKey> versionKeys = m_internalInterface->GetVersionKeysById(connection, packageMatch.first);
-            ISQLiteIndex::VersionKey& latestVersionKey = versionKeys[0];
+            auto stageTimer = timer.MeasureStage("addPackages");
 
-            std::string packageIdentifier = m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Id).value();
+            // Copy data from 1.7 tables to 2.0 tables
+            SearchResult allPackages = m_internalInterface->Search(connection, {});
 
-            std::vector<PackagesTable::NameValuePair> packageData{
-                { PackagesTable::IdColumn::Name, packageIdentifier },
-                { PackagesTable::NameColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Name).value() },
-                { PackagesTable::LatestVersionColumn::Name, latestVersionKey.VersionAndChannel.GetVersion().ToString() },
-            };
+            for (const auto& packageMatch : allPackages.Matches)
+            {
+                AddPackageFromInternalIndex(connection, packageMatch.first);
+            }
+        }
 
-            auto addIfPresent = [&](std::string_view name, std::optional<std::string>&& value)
-                {
-                    if (value && !value->empty())
-                    {
-                        packageData.emplace_back(PackagesTable::NameValuePair{ name, std::move(value).value() });
-                    }
-                };
+        {
+            auto stageTimer = timer.MeasureStage("finalizeTables");
+
+            PackagesTable::PrepareForPackaging<
+                PackagesTable::IdColumn,
+                PackagesTable::NameColumn,
+                PackagesTable::MonikerColumn,
+                PackagesTable::LatestVersionColumn,
+                PackagesTable::ARPMinVersionColumn,
+                PackagesTable::ARPMaxVersionColumn,
+                PackagesTable::HashColumn
+            >(connection);
+
+            TagsTable::PrepareForPackaging(connection);
+            CommandsTable::PrepareForPackaging(connection);
+
+            PackageUpdateTrackingTable::Drop(connection);
+
+            // The tables based on SystemReferenceStringTable don't need a prepare currently
+
+            // Drop 1.7 tables
+            m_internalInterface->DropTables(connection);
+
+            SQLite::MetadataTable::SetNamedValue(connection, s_MetadataValueName_PackagingWriteTime, std::to_string(packagingWriteTime));
+
+            savepoint.Commit();
+        }
 
-            addIfPresent(PackagesTable::MonikerColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Moniker).value());
-            addIfPresent(PackagesTable::ARPMinVersionColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::ArpMinVersion).value());
-            addIfPresent(PackagesTable::ARPMaxVersionColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::ArpMaxVersion).value());
+        detachPrevious.reset();
 
-            SQLite::rowid_t packageId = PackagesTable::Insert(connection, packageData);
+        m_internalInterface.reset();
 
-            PackagesTable::UpdateValueIdById<PackagesTable::HashColumn>(connection, packageId, PackageUpdateTrackingTable::GetDataHash(connection, packageIdentifier));
+        if (vacuum)
+        {
+            double freePageRatio = anon::GetFreePageRatio(connection);
 
-            for (const auto& versionKey : versionKeys)
+            if (freePageRatio >= s_PackagingVacuumFreePageRatioThreshold)
             {
-                TagsTable::EnsureExistsAndInsert(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Tag), packageId);
-                CommandsTable::EnsureExistsAndInsert(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Command), packageId);
-
-                PackageFamilyNameTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::PackageFamilyName), packageId);
-                ProductCodeTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::ProductCode), packageId);
-                NormalizedPackageNameTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Name), packageId);
-                NormalizedPackagePublisherTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Publisher), packageId);
-                UpgradeCodeTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::UpgradeCode), packageId);
+                auto stageTimer = timer.MeasureStage("vacuum");
+                Vacuum(connection);
+            }
+            else
+            {
+                AICLI_LOG(Repo, Info, << "Skipping vacuum as only " << static_cast<int>(freePageRatio * 100) << "% of pages are free");
             }
         }
+    }
 
-        PackagesTable::PrepareForPackaging<
-            PackagesTable::IdColumn,
-            PackagesTable::NameColumn,
-            PackagesTable::MonikerColumn,
-            PackagesTable::LatestVersionColumn,
-            PackagesTable::ARPMinVersionColumn,
-            PackagesTable::ARPMaxVersionColumn,
-            PackagesTable::HashColumn
-        >(connection);
+    void Interface::AddPackageFromInternalIndex(SQLite::Connection& connection, SQLite::rowid_t internalPackageId)
+    {
+        std::vector<ISQLiteIndex::VersionKey> versionKeys = m_internalInterface->GetVersionKeysById(connection, internalPackageId);
+        ISQLiteIndex::VersionKey& latestVersionKey = versionKeys[0];
 
-        TagsTable::PrepareForPackaging(connection);
-        CommandsTable::PrepareForPackaging(connection);
+        std::string packageIdentifier = m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Id).value();
 
-        PackageUpdateTrackingTable::Drop(connection);
+        std::vector<PackagesTable::NameValuePair> packageData{
+            { PackagesTable::IdColumn::Name, packageIdentifier },
+            { PackagesTable::NameColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Name).value() },
+            { PackagesTable::LatestVersionColumn::Name, latestVersionKey.VersionAndChannel.GetVersion().ToString() },
+        };
 
-        // The tables based on SystemReferenceStringTable don't need a prepare currently
+        auto addIfPresent = [&](std::string_view name, std::optional<std::string>&& value)
+            {
+                if (value && !value->empty())
+                {
+                    packageData.emplace_back(PackagesTable::NameValuePair{ name, std::move(value).value() });
+                }
+            };
 
-        // Drop 1.7 tables
-        m_internalInterface->DropTables(connection);
+        addIfPresent(PackagesTable::MonikerColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::Moniker).value());
+        addIfPresent(PackagesTable::ARPMinVersionColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::ArpMinVersion).value());
+        addIfPresent(PackagesTable::ARPMaxVersionColumn::Name, m_internalInterface->GetPropertyByPrimaryId(connection, latestVersionKey.ManifestId, PackageVersionProperty::ArpMaxVersion).value());
 
-        savepoint.Commit();
+        SQLite::rowid_t packageId = PackagesTable::Insert(connection, packageData);
 
-        m_internalInterface.reset();
+        PackagesTable::UpdateValueIdById<PackagesTable::HashColumn>(connection, packageId, PackageUpdateTrackingTable::GetDataHash(connection, packageIdentifier));
 
-        if (vacuum)
+        for (const auto& versionKey : versionKeys)
         {
-            Vacuum(connection);
+            TagsTable::EnsureExistsAndInsert(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Tag), packageId);
+            CommandsTable::EnsureExistsAndInsert(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Command), packageId);
+
+            PackageFamilyNameTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::PackageFamilyName), packageId);
+            ProductCodeTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::ProductCode), packageId);
+            NormalizedPackageNameTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Name), packageId);
+            NormalizedPackagePublisherTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::Publisher), packageId);
+            UpgradeCodeTable::EnsureExists(connection, m_internalInterface->GetMultiPropertyByPrimaryId(connection, versionKey.ManifestId, PackageVersionMultiProperty::UpgradeCode), packageId);
         }
     }
 
+    void Interface::UpdatePackagesFromInternalIndex(SQLite::Connection& connection, int64_t previousPackagingWriteTime)
+    {
+        std::set<std::string> trackedPackages;
+        for (const std::string& packageIdentifier : PackageUpdateTrackingTable::GetPackageIdentifiersUpdatedSince(connection, 0))
+        {
+            trackedPackages.emplace(Utility::FoldCase(std::string_view{ packageIdentifier }));
+        }
+
+        std::vector<std::string> updatedPackages = PackageUpdateTrackingTable::GetPackageIdentifiersUpdatedSince(connection, previousPackagingWriteTime);
+
+        std::set<std::string> updatedPackagesFolded;
+        for (const std::string& packageIdentifier : updatedPackages)
+        {
+            updatedPackagesFolded.emplace(Utility::FoldCase(std::string_view{ packageIdentifier }));
+        }
+
+        // Remove the copied packages that were either removed or changed since the previous packaging
+        size_t removedCount = 0;
+        for (SQLite::rowid_t packageId : PackagesTable::GetAllRowIds(connection, SQLite::RowIDName))
+        {
+            std::string foldedIdentifier = Utility::FoldCase(std::string_view{ PackagesTable::GetValueById<PackagesTable::IdColumn>(connection, packageId).value() });
+
+            if (trackedPackages.count(foldedIdentifier) == 0 || updatedPackagesFolded.count(foldedIdentifier) != 0)
+            {
+                anon::RemovePackage(connection, packageId);
+                ++removedCount;
+            }
+        }
+
+        // Regenerate the changed packages from the internal index
+        size_t addedCount = 0;
+        for (const std::string& packageIdentifier : updatedPackages)
+        {
+            SearchRequest request;
+            request.Inclusions.emplace_back(PackageMatchField::Id, MatchType::CaseInsensitive, packageIdentifier);
+            SearchResult result = m_internalInterface->Search(connection, request);
+
+            if (!result.Matches.empty())
+            {
+                AddPackageFromInternalIndex(connection, result.Matches[0].first);
+                ++addedCount;
+            }
+        }
+
+        AICLI_LOG(Repo, Info, << "Incremental packaging removed " << removedCount << " packages and added " << addedCount << " packages");
+    }
+
     void Interface::Vacuum(const SQLite::Connection& connection)
     {
         SQLite::Builder::StatementBuilder builder;
@@ -299,6 +299,46 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             savepoint.Commit();
         }
 
+        void OneToManyTableWithMapDeleteIfNotNeededByPrimaryId(SQLite::Connection& connection,
+            std::string_view tableName, std::string_view valueName, SQLite::rowid_t primaryId)
+        {
+            SQLite::Savepoint savepoint = SQLite::Savepoint::Create(connection, std::string{ tableName } + "_deleteifnotneeded_v2_0");
+
+            std::vector<SQLite::rowid_t> valueIds = anon::GetValueIdsByPrimaryId(connection, tableName, valueName, primaryId);
+
+            SQLite::Builder::StatementBuilder deleteMappingBuilder;
+            deleteMappingBuilder.DeleteFrom({ tableName, s_OneToManyTableWithMap_MapTable_Suffix }).Where(s_OneToManyTableWithMap_MapTable_PrimaryName).Equals(primaryId);
+
+            deleteMappingBuilder.Execute(connection);
+
+            // Remove the values that are no longer referenced by any mapping
+            SQLite::Builder::StatementBuilder countBuilder;
+            countBuilder.Select(SQLite::Builder::RowCount).From({ tableName, s_OneToManyTableWithMap_MapTable_Suffix }).Where(valueName).Equals(SQLite::Builder::Unbound);
+
+            SQLite::Statement countStatement = countBuilder.Prepare(connection);
+
+            SQLite::Builder::StatementBuilder deleteValueBuilder;
+            deleteValueBuilder.DeleteFrom(tableName).Where(SQLite::RowIDName).Equals(SQLite::Builder::Unbound);
+
+            SQLite::Statement deleteValueStatement = deleteValueBuilder.Prepare(connection);
+
+            for (SQLite::rowid_t valueId : valueIds)
+            {
+                countStatement.Reset();
+                countStatement.Bind(1, valueId);
+                THROW_HR_IF(E_UNEXPECTED, !countStatement.Step());
+
+                if (countStatement.GetColumn<int64_t>(0) == 0)
+                {
+                    deleteValueStatement.Reset();
+                    deleteValueStatement.Bind(1, valueId);
+                    deleteValueStatement.Execute();
+                }
+            }
+
+            savepoint.Commit();
+        }
+
         void OneToManyTableWithMapPrepareForPackaging(SQLite::Connection& connection, std::string_view tableName)
         {
             SQLite::Builder::StatementBuilder dropMapTableIndexBuilder;
@@ -45,6 +45,10 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             std::string_view tableName, std::string_view valueName, 
             const std::vector<std::string>& values, SQLite::rowid_t primaryId);
 
+        // Removes the mapping entries for the given primary id, and any values that are no longer referenced.
+        void OneToManyTableWithMapDeleteIfNotNeededByPrimaryId(SQLite::Connection& connection,
+            std::string_view tableName, std::string_view valueName, SQLite::rowid_t primaryId);
+
         // Removes data that is no longer needed for an index that is to be published.
         void OneToManyTableWithMapPrepareForPackaging(SQLite::Connection& connection, std::string_view tableName);
 
@@ -106,6 +110,12 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             details::OneToManyTableWithMapEnsureExistsAndInsert(connection, TableInfo::TableName(), TableInfo::ValueName(), values, primaryId);
         }
 
+        // Removes the mapping entries for the given primary id, and any values that are no longer referenced.
+        static void DeleteIfNotNeededByPrimaryId(SQLite::Connection& connection, SQLite::rowid_t primaryId)
+        {
+            details::OneToManyTableWithMapDeleteIfNotNeededByPrimaryId(connection, TableInfo::TableName(), TableInfo::ValueName(), primaryId);
+        }
+
         // Removes data that is no longer needed for an index that is to be published.
         // Preserving the primary index will improve the efficiency of finding the values associated with a primary.
         // Preserving the values index will improve searching when it is primarily done by equality.
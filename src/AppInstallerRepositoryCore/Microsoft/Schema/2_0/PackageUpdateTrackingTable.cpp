@@ -117,7 +117,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             auto compressor = Manifest::PackageVersionDataManifest::CreateCompressor();
             std::vector<uint8_t> compressedManifest = compressor.Compress(manifestString);
 
-            Utility::SHA256::HashBuffer manifestHash = Utility::SHA256::ComputeHash(compressedManifest);
+            Utility::SHA256::HashBuffer manifestHash = Utility::SHA256::ComputeHash(compressedManifest, Utility::SHA256::GetBulkBackend());
             int64_t currentTime = Utility::GetCurrentUnixEpoch();
 
             // First attempt to update the row and then insert it if no modification occurred.
@@ -235,6 +235,34 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         return result;
     }
 
+    std::vector<std::string> PackageUpdateTrackingTable::GetPackageIdentifiersUpdatedSince(const SQLite::Connection& connection, int64_t updateBaseTime)
+    {
+        Builder::StatementBuilder builder;
+        builder.Select(s_PUTT_Package).From(s_PUTT_Table_Name).Where(s_PUTT_WriteTime).IsGreaterThanOrEqualTo(updateBaseTime);
+
+        Statement select = builder.Prepare(connection);
+
+        std::vector<std::string> result;
+
+        while (select.Step())
+        {
+            result.emplace_back(select.GetColumn<std::string>(0));
+        }
+
+        return result;
+    }
+
+    int64_t PackageUpdateTrackingTable::GetLatestWriteTime(const SQLite::Connection& connection)
+    {
+        Builder::StatementBuilder builder;
+        builder.Select().Column(Builder::Aggregate::Max, s_PUTT_WriteTime).From(s_PUTT_Table_Name);
+
+        Statement select = builder.Prepare(connection);
+        THROW_HR_IF(E_UNEXPECTED, !select.Step());
+
+        return select.GetColumnIsNull(0) ? 0 : select.GetColumn<int64_t>(0);
+    }
+
     SQLite::blob_t PackageUpdateTrackingTable::GetDataHash(const SQLite::Connection& connection, const std::string& packageIdentifier)
     {
         Builder::StatementBuilder builder;
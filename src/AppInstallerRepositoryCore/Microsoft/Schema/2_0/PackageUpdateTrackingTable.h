@@ -46,6 +46,13 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         // Gets the data on updates that have been written since the given base time.
         static std::vector<PackageData> GetUpdatesSince(const SQLite::Connection& connection, int64_t updateBaseTime);
 
+        // Gets the identifiers of the packages that have been written since the given base time.
+        // This avoids reading the manifest data when only the identifiers are needed.
+        static std::vector<std::string> GetPackageIdentifiersUpdatedSince(const SQLite::Connection& connection, int64_t updateBaseTime);
+
+        // Gets the latest write time in the table, or 0 if the table is empty.
+        static int64_t GetLatestWriteTime(const SQLite::Connection& connection);
+
         // Gets the data hash for the given package identifier.
         static SQLite::blob_t GetDataHash(const SQLite::Connection& connection, const std::string& packageIdentifier);
     };
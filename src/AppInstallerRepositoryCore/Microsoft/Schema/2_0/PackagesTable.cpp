@@ -237,6 +237,14 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         return connection.GetLastInsertRowID();
     }
 
+    void PackagesTable::DeleteById(SQLite::Connection& connection, SQLite::rowid_t id)
+    {
+        SQLite::Builder::StatementBuilder builder;
+        builder.DeleteFrom(s_PackagesTable_Table_Name).Where(SQLite::RowIDName).Equals(id);
+
+        builder.Execute(connection);
+    }
+
     bool PackagesTable::ExistsById(const SQLite::Connection& connection, SQLite::rowid_t id)
     {
         SQLite::Builder::StatementBuilder builder;
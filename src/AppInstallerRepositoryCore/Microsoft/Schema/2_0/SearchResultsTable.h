@@ -6,7 +6,9 @@
 #include "Microsoft/Schema/ISQLiteIndex.h"
 #include "Public/winget/RepositorySearch.h"
 
+#include <map>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,6 +44,10 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         // Gets the results from the table.
         ISQLiteIndex::SearchResult GetSearchResults(size_t limit = 0);
 
+        // Gets all of the values of the field, for those fields that have a table of values.
+        // The values are in no particular order and may contain duplicates.
+        static std::vector<std::string> GetAllValues(const SQLite::Connection& connection, PackageMatchField field);
+
     protected:
         // Builds the search statement for the specified field and match type.
         std::vector<int> BuildSearchStatement(SQLite::Builder::StatementBuilder& builder, PackageMatchField field, MatchType match) const;
@@ -54,12 +60,23 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             bool useLike) const;
 
         static bool MatchUsesLike(MatchType match);
+        static bool MatchIsFuzzy(MatchType match);
         void BindStatementForMatchType(SQLite::Statement& statement, MatchType match, int bindIndex, std::string_view value);
 
         virtual void BindStatementForMatchType(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex);
 
     private:
+        // Gets the values of the field that are a fuzzy match for the filter, closest first.
+        std::vector<std::string> GetFuzzyMatchValues(const PackageMatchFilter& filter);
+
+        // Prepares the statement for the filter and executes it, returning the number of rows changed.
+        int ExecuteStatementForFilter(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex);
+
         const SQLite::Connection& m_connection;
         int m_sortOrdinalValue = 0;
+        // The case folded value of each search, indexed by its sort ordinal.
+        std::vector<std::string> m_searchValues;
+        // The values of each field that has been fuzzy matched, as consecutive searches often match the same field.
+        std::map<PackageMatchField, std::vector<std::string>> m_fuzzyMatchCandidates;
     };
 }
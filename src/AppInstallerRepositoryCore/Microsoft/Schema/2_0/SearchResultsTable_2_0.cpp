@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "SearchResultsTable.h"
+#include "Microsoft/Schema/FuzzyMatcher.h"
+#include "Microsoft/Schema/SearchResultRanker.h"
 #include <winget/SQLiteStatementBuilder.h>
 
 #include "Microsoft/Schema/2_0/PackagesTable.h"
@@ -33,6 +35,22 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         constexpr std::string_view s_SearchResultsTable_SubSelect_TableAlias = "valueTable"sv;
         constexpr std::string_view s_SearchResultsTable_SubSelect_PackageAlias = "p"sv;
         constexpr std::string_view s_SearchResultsTable_SubSelect_ValueAlias = "v"sv;
+
+        // Gets every non-null value in the column of the table.
+        std::vector<std::string> GetAllColumnValues(const SQLite::Connection& connection, std::string_view tableName, std::string_view columnName)
+        {
+            SQLite::Builder::StatementBuilder builder;
+            builder.Select(columnName).From(tableName).Where(columnName).IsNotNull();
+
+            SQLite::Statement select = builder.Prepare(connection);
+
+            std::vector<std::string> result;
+            while (select.Step())
+            {
+                result.emplace_back(select.GetColumn<std::string>(0));
+            }
+            return result;
+        }
     }
 
     SearchResultsTable::SearchResultsTable(const SQLite::Connection& connection) :
@@ -76,6 +94,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         using namespace SQLite::Builder;
 
         int sortOrdinal = m_sortOrdinalValue++;
+        m_searchValues.emplace_back(SearchResultRanker::PrepareSearchValue(filter.Value));
 
         // Create an insert statement to select values into the table as requested.
         // The goal is a statement like this:
@@ -93,8 +112,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             Value(false).
         From().BeginParenthetical();
 
-        // Add the field specific portion
-        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, filter.Type);
+        // Add the field specific portion; fuzzy matches are found outside of the database, then each matched value is selected exactly.
+        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, MatchIsFuzzy(filter.Type) ? MatchType::Exact : filter.Type);
 
         if (bindIndex.empty())
         {
@@ -105,9 +124,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         builder.EndParenthetical().As(s_SearchResultsTable_SubSelect_TableAlias);
 
         SQLite::Statement statement = builder.Prepare(m_connection);
-        BindStatementForMatchType(statement, filter, bindIndex);
-        statement.Execute();
-        AICLI_LOG(SQL, Verbose, << "Search found " << m_connection.GetChanges() << " rows");
+        int changes = ExecuteStatementForFilter(statement, filter, bindIndex);
+        AICLI_LOG(SQL, Verbose, << "Search found " << changes << " rows");
     }
 
     void SearchResultsTable::RemoveDuplicatePackageRows()
@@ -159,7 +177,7 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             Select(s_SearchResultsTable_SubSelect_PackageAlias).From().BeginParenthetical();
 
         // Add the field specific portion
-        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, filter.Type);
+        std::vector<int> bindIndex = BuildSearchStatement(builder, filter.Field, MatchIsFuzzy(filter.Type) ? MatchType::Exact : filter.Type);
 
         if (bindIndex.empty())
         {
@@ -170,9 +188,8 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         builder.EndParenthetical().EndParenthetical();
 
         SQLite::Statement statement = builder.Prepare(m_connection);
-        BindStatementForMatchType(statement, filter, bindIndex);
-        statement.Execute();
-        AICLI_LOG(SQL, Verbose, << "Filter kept " << m_connection.GetChanges() << " rows");
+        int changes = ExecuteStatementForFilter(statement, filter, bindIndex);
+        AICLI_LOG(SQL, Verbose, << "Filter kept " << changes << " rows");
     }
 
     void SearchResultsTable::CompleteFilter()
@@ -197,26 +214,48 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             s_SearchResultsTable_MatchField,
             s_SearchResultsTable_MatchType,
             s_SearchResultsTable_MatchValue,
+            s_SearchResultsTable_SortValue,
         }).
         From(GetQualifiedName()).OrderBy(s_SearchResultsTable_SortValue);
 
         SQLite::Statement select = builder.Prepare(m_connection);
 
-        ISQLiteIndex::SearchResult result;
+        // Rank the matches of each sort ordinal by how well they fit the searched value; the ordering of the rows
+        // allows the ranking to stop at the first ordinal after the limit is reached.
+        SearchResultRanker ranker{ m_searchValues, limit };
         while (select.Step())
         {
-            if (limit && result.Matches.size() >= limit)
+            int sortOrdinal = select.GetColumn<int>(4);
+            if (ranker.IsComplete(sortOrdinal))
             {
+                ranker.SetTruncated();
                 break;
             }
 
-            result.Matches.emplace_back(select.GetColumn<SQLite::rowid_t>(0), 
+            ranker.Add(sortOrdinal, select.GetColumn<SQLite::rowid_t>(0),
                 PackageMatchFilter(select.GetColumn<PackageMatchField>(1), select.GetColumn<MatchType>(2), select.GetColumn<std::string>(3)));
         }
 
-        result.Truncated = (select.GetState() != SQLite::Statement::State::Completed);
+        return ranker.GetResults();
+    }
 
-        return result;
+    std::vector<std::string> SearchResultsTable::GetAllValues(const SQLite::Connection& connection, PackageMatchField field)
+    {
+        switch (field)
+        {
+        case PackageMatchField::Id:
+            return GetAllColumnValues(connection, PackagesTable::TableName(), PackagesTable::IdColumn::Name);
+        case PackageMatchField::Name:
+            return GetAllColumnValues(connection, PackagesTable::TableName(), PackagesTable::NameColumn::Name);
+        case PackageMatchField::Moniker:
+            return GetAllColumnValues(connection, PackagesTable::TableName(), PackagesTable::MonikerColumn::Name);
+        case PackageMatchField::Tag:
+            return GetAllColumnValues(connection, TagsTable::TableName(), TagsTable::ValueName());
+        case PackageMatchField::Command:
+            return GetAllColumnValues(connection, CommandsTable::TableName(), CommandsTable::ValueName());
+        default:
+            THROW_WIN32(ERROR_NOT_SUPPORTED);
+        }
     }
 
     std::vector<int> SearchResultsTable::BuildSearchStatement(SQLite::Builder::StatementBuilder& builder, PackageMatchField field, MatchType match) const
@@ -272,6 +311,11 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
         return (match != MatchType::Exact);
     }
 
+    bool SearchResultsTable::MatchIsFuzzy(MatchType match)
+    {
+        return (match == MatchType::Fuzzy || match == MatchType::FuzzySubstring);
+    }
+
     void SearchResultsTable::BindStatementForMatchType(SQLite::Statement& statement, MatchType match, int bindIndex, std::string_view value)
     {
         std::string valueToUse;
@@ -303,8 +347,9 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
 
     void SearchResultsTable::BindStatementForMatchType(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex)
     {
-        // TODO: Implement these more complex match types
-        if (filter.Type == MatchType::Wildcard || filter.Type == MatchType::Fuzzy || filter.Type == MatchType::FuzzySubstring)
+        // TODO: Implement wildcard matching
+        // Fuzzy matches are bound to each matched value by ExecuteStatementForFilter.
+        if (filter.Type == MatchType::Wildcard || MatchIsFuzzy(filter.Type))
         {
             AICLI_LOG(Repo, Verbose, << "Specific match type not implemented, skipping: " << ToString(filter.Type));
             return;
@@ -317,4 +362,60 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             BindStatementForMatchType(statement, filter.Type, bindIndex[1], filter.Additional.value());
         }
     }
+
+    std::vector<std::string> SearchResultsTable::GetFuzzyMatchValues(const PackageMatchFilter& filter)
+    {
+        FuzzyMatcher matcher{ filter.Value, filter.Type == MatchType::FuzzySubstring };
+
+        // Without any tolerance, a fuzzy match finds nothing more than the case insensitive or substring match that precedes it.
+        if (!matcher.GetMaximumDistance())
+        {
+            return {};
+        }
+
+        switch (filter.Field)
+        {
+        case PackageMatchField::Id:
+        case PackageMatchField::Name:
+        case PackageMatchField::Moniker:
+        case PackageMatchField::Tag:
+        case PackageMatchField::Command:
+            break;
+        default:
+            AICLI_LOG(Repo, Verbose, << "Fuzzy match not supported for field: " << ToString(filter.Field));
+            return {};
+        }
+
+        auto itr = m_fuzzyMatchCandidates.find(filter.Field);
+        if (itr == m_fuzzyMatchCandidates.end())
+        {
+            itr = m_fuzzyMatchCandidates.emplace(filter.Field, GetAllValues(m_connection, filter.Field)).first;
+        }
+
+        std::vector<std::string> result = matcher.GetMatches(itr->second);
+        AICLI_LOG(Repo, Verbose, << "Fuzzy match found " << result.size() << " of " << itr->second.size() << " values");
+        return result;
+    }
+
+    int SearchResultsTable::ExecuteStatementForFilter(SQLite::Statement& statement, const PackageMatchFilter& filter, const std::vector<int>& bindIndex)
+    {
+        if (!MatchIsFuzzy(filter.Type))
+        {
+            BindStatementForMatchType(statement, filter, bindIndex);
+            statement.Execute();
+            return m_connection.GetChanges();
+        }
+
+        int result = 0;
+
+        for (const auto& value : GetFuzzyMatchValues(filter))
+        {
+            statement.Reset();
+            BindStatementForMatchType(statement, MatchType::Exact, bindIndex[0], value);
+            statement.Execute();
+            result += m_connection.GetChanges();
+        }
+
+        return result;
+    }
 }
@@ -96,6 +96,14 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             savepoint.Commit();
         }
 
+        void SystemReferenceStringTableDeleteByPrimaryId(SQLite::Connection& connection, std::string_view tableName, SQLite::rowid_t primaryId)
+        {
+            SQLite::Builder::StatementBuilder builder;
+            builder.DeleteFrom(tableName).Where(s_SystemReferenceStringTable_PrimaryName).Equals(primaryId);
+
+            builder.Execute(connection);
+        }
+
         bool SystemReferenceStringTableCheckConsistency(const SQLite::Connection& connection, std::string_view tableName, std::string_view valueName, bool log)
         {
             using QCol = SQLite::Builder::QualifiedColumn;
@@ -37,6 +37,9 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             const std::vector<std::string>& values,
             SQLite::rowid_t primaryId);
 
+        // Removes all values associated with the given primary id.
+        void SystemReferenceStringTableDeleteByPrimaryId(SQLite::Connection& connection, std::string_view tableName, SQLite::rowid_t primaryId);
+
         // Checks the consistency of the index to ensure that every referenced row exists.
         // Returns true if index is consistent; false if it is not.
          bool SystemReferenceStringTableCheckConsistency(const SQLite::Connection& connection, std::string_view tableName, std::string_view valueName, bool log);
@@ -107,6 +110,12 @@ namespace AppInstaller::Repository::Microsoft::Schema::V2_0
             details::SystemReferenceStringTableEnsureExists(connection, TableInfo::TableName(), TableInfo::ValueName(), values, primaryId);
         }
 
+        // Removes all values associated with the given primary id.
+        static void DeleteByPrimaryId(SQLite::Connection& connection, SQLite::rowid_t primaryId)
+        {
+            details::SystemReferenceStringTableDeleteByPrimaryId(connection, TableInfo::TableName(), primaryId);
+        }
+
         // Checks the consistency of the index to ensure that every referenced row exists.
         // Returns true if index is consistent; false if it is not.
         static bool CheckConsistency(const SQLite::Connection& connection, bool log)
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Microsoft/Schema/FuzzyMatcher.h"
+#include <AppInstallerStrings.h>
+
+
+namespace AppInstaller::Repository::Microsoft::Schema
+{
+    namespace
+    {
+        // Folds the value into code points; most values are ASCII, which can be folded without ICU.
+        std::u32string FoldToCodePoints(std::string_view value)
+        {
+            if (std::all_of(value.begin(), value.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; }))
+            {
+                std::u32string result;
+                result.reserve(value.size());
+
+                for (char c : value)
+                {
+                    result.push_back(static_cast<char32_t>(std::tolower(static_cast<unsigned char>(c))));
+                }
+
+                return result;
+            }
+
+            return Utility::ConvertToUTF32(Utility::FoldCase(value));
+        }
+
+        // The number of differences allowed, by the length of the search value.
+        // Shorter values allow fewer, as a single difference in them would match too many unrelated values.
+        size_t GetMaximumDistanceForLength(size_t length)
+        {
+            if (length < 3)
+            {
+                return 0;
+            }
+            else if (length < 6)
+            {
+                return 1;
+            }
+            else
+            {
+                return 2;
+            }
+        }
+
+        // Computes the optimal string alignment distance, stopping as soon as it must be greater than the maximum.
+        // For a substring, the search value may start and end anywhere in the target, so skipping target characters at either end is free.
+        std::optional<size_t> GetBoundedDistance(const std::u32string& search, const std::u32string& target, bool substring, size_t maximum)
+        {
+            const size_t m = search.size();
+            const size_t n = target.size();
+
+            if (substring ? (n + maximum < m) : ((m > n ? m - n : n - m) > maximum))
+            {
+                return {};
+            }
+
+            std::vector<size_t> beforePrevious(n + 1);
+            std::vector<size_t> previous(n + 1);
+            std::vector<size_t> current(n + 1);
+
+            for (size_t j = 0; j <= n; ++j)
+            {
+                previous[j] = (substring ? 0 : j);
+            }
+
+            for (size_t i = 1; i <= m; ++i)
+            {
+                current[0] = i;
+                size_t rowMinimum = current[0];
+
+                for (size_t j = 1; j <= n; ++j)
+                {
+                    size_t cost = (search[i - 1] == target[j - 1] ? 0 : 1);
+                    size_t value = std::min({ previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost });
+
+                    if (i > 1 && j > 1 && search[i - 1] == target[j - 2] && search[i - 2] == target[j - 1])
+                    {
+                        value = std::min(value, beforePrevious[j - 2] + 1);
+                    }
+
+                    current[j] = value;
+                    rowMinimum = std::min(rowMinimum, value);
+                }
+
+                if (rowMinimum > maximum)
+                {
+                    return {};
+                }
+
+                std::swap(beforePrevious, previous);
+                std::swap(previous, current);
+            }
+
+            size_t result = (substring ? *std::min_element(previous.begin(), previous.end()) : previous[n]);
+            if (result > maximum)
+            {
+                return {};
+            }
+
+            return result;
+        }
+    }
+
+    FuzzyMatcher::FuzzyMatcher(std::string_view value, bool substring) :
+        m_value(FoldToCodePoints(value)), m_substring(substring)
+    {
+        m_maximumDistance = GetMaximumDistanceForLength(m_value.size());
+    }
+
+    std::optional<size_t> FuzzyMatcher::GetDistance(std::string_view value) const
+    {
+        return GetBoundedDistance(m_value, FoldToCodePoints(value), m_substring, m_maximumDistance);
+    }
+
+    std::vector<std::string> FuzzyMatcher::GetMatches(const std::vector<std::string>& values) const
+    {
+        std::vector<std::pair<size_t, std::string_view>> matches;
+
+        for (const auto& value : values)
+        {
+            std::optional<size_t> distance = GetDistance(value);
+            if (distance)
+            {
+                matches.emplace_back(distance.value(), value);
+            }
+        }
+
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        std::vector<std::string> result;
+        result.reserve(matches.size());
+
+        for (const auto& match : matches)
+        {
+            result.emplace_back(match.second);
+        }
+
+        return result;
+    }
+}
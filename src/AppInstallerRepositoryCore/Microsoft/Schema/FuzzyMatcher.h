@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace AppInstaller::Repository::Microsoft::Schema
+{
+    // Matches values that are within a small edit distance of a search value, so that a search tolerates typing mistakes.
+    // The distance counts the insertions, deletions, substitutions and transpositions of adjacent characters between the case folded values.
+    // For a substring match, it is the distance to the closest part of the value instead of to the whole value.
+    struct FuzzyMatcher
+    {
+        FuzzyMatcher(std::string_view value, bool substring);
+
+        // Gets the largest distance that is a match; it grows with the length of the search value, and is 0 for a short one.
+        size_t GetMaximumDistance() const { return m_maximumDistance; }
+
+        // Gets the distance to the value, or an empty value if it is beyond the maximum.
+        std::optional<size_t> GetDistance(std::string_view value) const;
+
+        // Gets the distinct values that match, closest first.
+        std::vector<std::string> GetMatches(const std::vector<std::string>& values) const;
+
+    private:
+        std::u32string m_value;
+        bool m_substring = false;
+        size_t m_maximumDistance = 0;
+    };
+}
@@ -25,6 +25,11 @@ namespace AppInstaller::Repository::Microsoft::Schema
         THROW_WIN32(ERROR_NOT_SUPPORTED);
     }
 
+    std::vector<std::string> ISQLiteIndex::GetAllValues(const SQLite::Connection&, PackageMatchField) const
+    {
+        THROW_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
     std::unique_ptr<ISQLiteIndex> CreateISQLiteIndex(const SQLite::Version& version)
     {
         if (version.MajorVersion == 1 ||
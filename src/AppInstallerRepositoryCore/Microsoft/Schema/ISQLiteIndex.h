@@ -151,6 +151,10 @@ namespace AppInstaller::Repository::Microsoft::Schema
 
         // Set the property value.
         virtual void SetProperty(SQLite::Connection& connection, Property property, const std::string& value);
+
+        // Gets all of the values of the given field, such as for building an index of them outside of the database.
+        // The values are in no particular order and may contain duplicates.
+        virtual std::vector<std::string> GetAllValues(const SQLite::Connection& connection, PackageMatchField field) const;
     };
 
     DEFINE_ENUM_FLAG_OPERATORS(ISQLiteIndex::CreateOptions);
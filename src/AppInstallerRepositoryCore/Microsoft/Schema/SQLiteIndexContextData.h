@@ -13,6 +13,7 @@ namespace AppInstaller::Repository::Microsoft::Schema
         PackageUpdateTrackingBaseTime,
         IntermediateFileOutputPath,
         DatabaseFilePath,
+        PreviousPackagedIndexPath,
         Max
     };
 
@@ -44,6 +45,13 @@ namespace AppInstaller::Repository::Microsoft::Schema
             using value_t = std::filesystem::path;
             static constexpr bool SetThroughInterface = false;
         };
+
+        template <>
+        struct PropertyMapping<Property::PreviousPackagedIndexPath>
+        {
+            using value_t = std::filesystem::path;
+            static constexpr bool SetThroughInterface = false;
+        };
     }
 
     using SQLiteIndexContextData = EnumBasedVariantMap<Property, details::PropertyMapping>;
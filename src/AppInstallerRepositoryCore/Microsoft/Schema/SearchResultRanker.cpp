@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Microsoft/Schema/SearchResultRanker.h"
+#include <AppInstallerStrings.h>
+
+
+namespace AppInstaller::Repository::Microsoft::Schema
+{
+    namespace
+    {
+        // The quality of a match, from best to worst.
+        enum MatchQuality : int
+        {
+            Equal,
+            Prefix,
+            WordStart,
+            Contains,
+            Other,
+        };
+
+        // Only ASCII punctuation and whitespace separate words; any other byte may be part of a multibyte character.
+        bool IsWordSeparator(char c)
+        {
+            unsigned char value = static_cast<unsigned char>(c);
+            return value < 0x80 && !std::isalnum(value);
+        }
+
+        // Gets the number of words that start before the given position.
+        size_t GetWordIndex(std::string_view value, size_t position)
+        {
+            size_t result = 0;
+            for (size_t i = 0; i < position; ++i)
+            {
+                if (!IsWordSeparator(value[i]) && (i == 0 || IsWordSeparator(value[i - 1])))
+                {
+                    ++result;
+                }
+            }
+            return result;
+        }
+    }
+
+    bool SearchResultRanker::Score::operator<(const Score& other) const
+    {
+        return std::tie(SortOrdinal, Quality, Distance, WordIndex, Length, Sequence) <
+            std::tie(other.SortOrdinal, other.Quality, other.Distance, other.WordIndex, other.Length, other.Sequence);
+    }
+
+    SearchResultRanker::SearchResultRanker(const std::vector<std::string>& searchValues, size_t limit) :
+        m_searchValues(searchValues), m_limit(limit)
+    {
+        if (m_limit)
+        {
+            m_entries.reserve(m_limit);
+        }
+    }
+
+    std::string SearchResultRanker::PrepareSearchValue(std::string_view value)
+    {
+        return Utility::FoldCase(value);
+    }
+
+    bool SearchResultRanker::IsComplete(int sortOrdinal) const
+    {
+        return m_limit && m_entries.size() >= m_limit && sortOrdinal > m_entries.front().Rank.SortOrdinal;
+    }
+
+    void SearchResultRanker::Add(int sortOrdinal, SQLite::rowid_t id, PackageMatchFilter&& match)
+    {
+        Entry entry{ GetScore(sortOrdinal, match), id, std::move(match) };
+        entry.Rank.Sequence = m_sequence++;
+
+        if (!m_limit)
+        {
+            m_entries.emplace_back(std::move(entry));
+            return;
+        }
+
+        if (m_entries.size() < m_limit)
+        {
+            m_entries.emplace_back(std::move(entry));
+            std::push_heap(m_entries.begin(), m_entries.end());
+            return;
+        }
+
+        m_truncated = true;
+
+        // Replace the worst kept result if this one is better.
+        if (entry < m_entries.front())
+        {
+            std::pop_heap(m_entries.begin(), m_entries.end());
+            m_entries.back() = std::move(entry);
+            std::push_heap(m_entries.begin(), m_entries.end());
+        }
+    }
+
+    void SearchResultRanker::SetTruncated()
+    {
+        m_truncated = true;
+    }
+
+    ISQLiteIndex::SearchResult SearchResultRanker::GetResults()
+    {
+        std::sort(m_entries.begin(), m_entries.end());
+
+        ISQLiteIndex::SearchResult result;
+        result.Matches.reserve(m_entries.size());
+
+        for (auto& entry : m_entries)
+        {
+            result.Matches.emplace_back(entry.Id, std::move(entry.Match));
+        }
+
+        m_entries.clear();
+        result.Truncated = m_truncated;
+
+        return result;
+    }
+
+    SearchResultRanker::Score SearchResultRanker::GetScore(int sortOrdinal, const PackageMatchFilter& match)
+    {
+        std::string_view value = match.Value;
+
+        Score result;
+        result.SortOrdinal = sortOrdinal;
+        result.Quality = MatchQuality::Other;
+        result.Length = value.size();
+
+        if (sortOrdinal < 0 || static_cast<size_t>(sortOrdinal) >= m_searchValues.size() || m_searchValues[sortOrdinal].empty() || value.empty())
+        {
+            return result;
+        }
+
+        const std::string& searchValue = m_searchValues[sortOrdinal];
+
+        if (match.Type == MatchType::Fuzzy || match.Type == MatchType::FuzzySubstring)
+        {
+            auto itr = m_fuzzyMatchers.find(sortOrdinal);
+            if (itr == m_fuzzyMatchers.end())
+            {
+                itr = m_fuzzyMatchers.emplace(sortOrdinal, FuzzyMatcher{ searchValue, match.Type == MatchType::FuzzySubstring }).first;
+            }
+
+            result.Distance = itr->second.GetDistance(value).value_or(itr->second.GetMaximumDistance() + 1);
+        }
+
+        std::string foldedValue = Utility::FoldCase(value);
+
+        if (foldedValue == searchValue)
+        {
+            result.Quality = MatchQuality::Equal;
+        }
+        else if (foldedValue.compare(0, searchValue.size(), searchValue) == 0)
+        {
+            result.Quality = MatchQuality::Prefix;
+        }
+        else
+        {
+            // Prefer the first match that starts a word, but take any other if there is none.
+            for (size_t position = foldedValue.find(searchValue); position != std::string::npos; position = foldedValue.find(searchValue, position + 1))
+            {
+                if (IsWordSeparator(foldedValue[position - 1]))
+                {
+                    result.Quality = MatchQuality::WordStart;
+                    result.WordIndex = GetWordIndex(foldedValue, position);
+                    break;
+                }
+
+                if (result.Quality == MatchQuality::Other)
+                {
+                    result.Quality = MatchQuality::Contains;
+                    result.WordIndex = GetWordIndex(foldedValue, position);
+                }
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include "Microsoft/Schema/ISQLiteIndex.h"
+#include "Microsoft/Schema/FuzzyMatcher.h"
+#include "Public/winget/RepositorySearch.h"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace AppInstaller::Repository::Microsoft::Schema
+{
+    // Ranks the rows of a search results table by relevance, keeping only the best of them when the search is limited.
+    // Results are ranked first by the sort ordinal of the search that found them, which orders them by match type and then field.
+    // Within an ordinal, the matched value is scored against the searched value: an equal value, then a prefix, then a match at
+    // the start of a word (earlier words first), then any other match; shorter values rank higher when all else is equal.
+    // Fuzzy matches are ranked by their distance from the searched value.
+    struct SearchResultRanker
+    {
+        // The search values are indexed by sort ordinal; a limit of 0 keeps every result.
+        SearchResultRanker(const std::vector<std::string>& searchValues, size_t limit);
+
+        SearchResultRanker(const SearchResultRanker&) = delete;
+        SearchResultRanker& operator=(const SearchResultRanker&) = delete;
+
+        // Folds the searched value into the form used by the ranker.
+        static std::string PrepareSearchValue(std::string_view value);
+
+        // Determines whether a result with the given sort ordinal can no longer be kept.
+        // When results are added in sort ordinal order, the first for which this is true ends the ranking.
+        bool IsComplete(int sortOrdinal) const;
+
+        // Adds a result to the ranking.
+        void Add(int sortOrdinal, SQLite::rowid_t id, PackageMatchFilter&& match);
+
+        // Marks the results as truncated, as there were more than were added.
+        void SetTruncated();
+
+        // Gets the kept results, in rank order.
+        ISQLiteIndex::SearchResult GetResults();
+
+    private:
+        struct Score
+        {
+            int SortOrdinal = 0;
+            int Quality = 0;
+            size_t Distance = 0;
+            size_t WordIndex = 0;
+            size_t Length = 0;
+            size_t Sequence = 0;
+
+            bool operator<(const Score& other) const;
+        };
+
+        struct Entry
+        {
+            Score Rank;
+            SQLite::rowid_t Id;
+            PackageMatchFilter Match;
+
+            bool operator<(const Entry& other) const { return Rank < other.Rank; }
+        };
+
+        Score GetScore(int sortOrdinal, const PackageMatchFilter& match);
+
+        const std::vector<std::string>& m_searchValues;
+        size_t m_limit = 0;
+        size_t m_sequence = 0;
+        bool m_truncated = false;
+        std::map<int, FuzzyMatcher> m_fuzzyMatchers;
+        // When limited, a max heap on score so that the worst kept result is at the front.
+        std::vector<Entry> m_entries;
+    };
+}
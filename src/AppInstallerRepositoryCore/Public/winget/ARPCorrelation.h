@@ -5,7 +5,9 @@
 #include <winget/LocIndependent.h>
 #include <winget/RepositorySource.h>
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -27,8 +29,37 @@ namespace AppInstaller
 
 namespace AppInstaller::Repository::Correlation
 {
-    // Contains the { Id, Version, Channel }
-    using ARPEntrySnapshot = std::tuple<Utility::LocIndString, Utility::LocIndString, Utility::LocIndString>;
+    // A lightweight record of an ARP entry, used to find the entries that change during an installation
+    // without reading all of the data of every entry.
+    struct ARPEntrySnapshot
+    {
+        // The identifier of the entry in the ARP source; made up of the scope, architecture and key name.
+        std::string Id;
+
+        // The last write time of the entry's registry key.
+        uint64_t LastWriteTime = 0;
+
+        // The DisplayVersion value of the entry.
+        std::string DisplayVersion;
+
+        bool operator==(const ARPEntrySnapshot& other) const;
+        bool operator!=(const ARPEntrySnapshot& other) const { return !(*this == other); }
+    };
+
+    // Enumerates the snapshots of all of the ARP entries on the system.
+    struct IARPEntrySnapshotEnumerator
+    {
+        virtual ~IARPEntrySnapshotEnumerator() = default;
+        virtual std::vector<ARPEntrySnapshot> Enumerate() const = 0;
+
+        // Returns the enumerator to use; by default this reads the registry.
+        static IARPEntrySnapshotEnumerator& Instance();
+
+#ifndef AICLI_DISABLE_TEST_HOOKS
+        static void OverrideInstance(IARPEntrySnapshotEnumerator* enumeratorOverride);
+        static void ResetInstance();
+#endif
+    };
 
     // Struct holding all the data from an ARP entry we use for the correlation
     struct ARPEntry
@@ -138,6 +169,7 @@ namespace AppInstaller::Repository::Correlation
         void CapturePreInstallSnapshot();
 
         // Captures the ARP state differences after the package installation.
+        // Entries whose snapshot differs from the pre-install one are considered new or updated.
         void CapturePostInstallSnapshot();
 
         // Correlates the given manifest against the data previously collected with capture calls.
@@ -8,6 +8,11 @@
 #include <winget/RepositorySearch.h>
 #include <winget/RepositorySource.h>
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace AppInstaller::Repository::Correlation
 {
     struct EmptyMatchConfidenceAlgorithm : public IARPMatchConfidenceAlgorithm
@@ -38,12 +43,29 @@ namespace AppInstaller::Repository::Correlation
         double ComputeConfidence(const ARPEntry& arpEntry) const override;
 
     private:
+        // Words are compared by an id assigned to them when preparing the manifest data.
+        using WordIdSequence = std::vector<uint32_t>;
+
+        struct InternedNameAndPublisher
+        {
+            WordIdSequence Name;
+            WordIdSequence Publisher;
+            WordIdSequence NamePublisher;
+        };
+
         WordSequence PrepareString(std::string_view s) const;
         WordSequence NormalizeAndPrepareName(std::string_view name) const;
         WordSequence NormalizeAndPreparePublisher(std::string_view publisher) const;
 
+        // Adds the name and publisher from the manifest, assigning ids to any new words.
+        void AddManifestNameAndPublisher(const NameAndPublisher& nameAndPublisher);
+
+        // Gets the ids of the words; words that are not in the manifest all get the same id, which matches nothing.
+        WordIdSequence GetWordIds(const WordSequence& words) const;
+
         AppInstaller::Utility::NameNormalizer m_normalizer{ AppInstaller::Utility::NormalizationVersion::InitialPreserveWhiteSpace };
-        std::vector<NameAndPublisher> m_namesAndPublishers;
+        std::vector<InternedNameAndPublisher> m_namesAndPublishers;
+        std::unordered_map<std::string, uint32_t> m_wordIds;
 
         // Parameters for the algorithm
 
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <winget/RepositorySearch.h>
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AppInstaller::Repository
+{
+    // A compact, read only index of the values that command line completion offers from a source.
+    // It holds a sorted array of the case folded values of each field, which is binary searched through a file mapping
+    // so that completing a value does not require opening the source.
+    struct CompletionIndex
+    {
+        // The fields that are written to the index.
+        static constexpr std::array<PackageMatchField, 5> Fields =
+        {
+            PackageMatchField::Id,
+            PackageMatchField::Name,
+            PackageMatchField::Moniker,
+            PackageMatchField::Tag,
+            PackageMatchField::Command,
+        };
+
+        CompletionIndex(const CompletionIndex&) = delete;
+        CompletionIndex& operator=(const CompletionIndex&) = delete;
+
+        CompletionIndex(CompletionIndex&&) noexcept;
+        CompletionIndex& operator=(CompletionIndex&&) noexcept;
+
+        ~CompletionIndex();
+
+        // Writes an index of the given values of each field, replacing any existing file at the path.
+        // Empty and duplicate values are not written.
+        static void Write(const std::filesystem::path& path, const std::map<PackageMatchField, std::vector<std::string>>& values);
+
+        // Opens the index at the given path.
+        // Returns an empty value if there is no file, or it is not a valid index.
+        static std::optional<CompletionIndex> Open(const std::filesystem::path& path);
+
+        // Gets the values of the field that start with the given prefix, ignoring case, in case folded order.
+        // When maximum is not 0, no more than that many values are returned.
+        std::vector<std::string> GetValues(PackageMatchField field, std::string_view prefix, size_t maximum = 0) const;
+
+    private:
+        struct implementation;
+        CompletionIndex(std::unique_ptr<implementation>&& value);
+        std::unique_ptr<implementation> m_implementation;
+    };
+}
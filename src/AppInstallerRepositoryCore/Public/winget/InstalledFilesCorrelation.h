@@ -3,6 +3,8 @@
 #pragma once
 #include <winget/Manifest.h>
 #include <winget/FolderFileWatcher.h>
+#include <AppInstallerSHA256.h>
+#include <cstdint>
 #include <optional>
 
 namespace AppInstaller::Repository::Correlation
@@ -24,8 +26,38 @@ namespace AppInstaller::Repository::Correlation
         AppInstaller::Manifest::InstallationMetadataInfo InstalledFiles;
         // Startup links metadata.
         std::vector<InstalledStartupLinkFile> StartupLinkFiles;
+        // The number and total size of the installed files that were not hashed because they did not fit in the hashing budget.
+        size_t FilesNotHashed = 0;
+        uint64_t BytesNotHashed = 0;
     };
 
+    // Limits the work done hashing the installed files.
+    struct InstalledFilesHashingBudget
+    {
+        // The maximum number of files to hash.
+        size_t MaximumFileCount = 1000;
+        // The maximum total size of the files to hash.
+        uint64_t MaximumTotalSize = 4ull * 1024 * 1024 * 1024;
+    };
+
+    // The hashes of installed files, computed within a budget.
+    struct InstalledFileHashes
+    {
+        // The hashes, in the same order as the files; empty for files that were not hashed.
+        std::vector<Utility::SHA256::HashBuffer> Hashes;
+        // The number and total size of the files that did not fit in the budget.
+        size_t SkippedFileCount = 0;
+        uint64_t SkippedSize = 0;
+    };
+
+    // Hashes the files on a bounded number of threads. Files are taken in order until the budget is used up.
+    // Files that cannot be read are logged and get an empty hash.
+    InstalledFileHashes HashInstalledFiles(const std::vector<std::filesystem::path>& files, const InstalledFilesHashingBudget& budget);
+
+    // Sets the hash of each installed file in the metadata from the file it targets, given in the same order.
+    // A file targeted by more than one entry is only hashed, and counted against the budget, once.
+    void HashInstalledFileTargets(InstallationMetadata& metadata, const std::vector<std::filesystem::path>& targets, const InstalledFilesHashingBudget& budget);
+
     struct InstalledFilesCorrelation
     {
         // Constructor initializes the file watchers.
@@ -43,6 +75,9 @@ namespace AppInstaller::Repository::Correlation
             const Manifest::Manifest& manifest,
             const std::string& arpInstallLocation);
 
+        // Sets the limits on hashing the installed files.
+        virtual void SetHashingBudget(InstalledFilesHashingBudget budget);
+
     private:
         struct FileWatcherFiles
         {
@@ -54,5 +89,6 @@ namespace AppInstaller::Repository::Correlation
 
         std::vector<AppInstaller::Utility::FolderFileWatcher> m_fileWatchers;
         std::vector<FileWatcherFiles> m_files;
+        InstalledFilesHashingBudget m_hashingBudget;
     };
 }
@@ -215,6 +215,19 @@ namespace AppInstaller::Repository
         std::optional<int32_t> Priority;
     };
 
+    // The values found in the completion indexes of sources.
+    struct CompletionValuesResult
+    {
+        // The values from the sources that have a completion index, in order and without duplicates.
+        std::vector<std::string> Values;
+
+        // The sources that do not have a completion index, which must be searched for their values instead.
+        std::vector<SourceDetails> UnindexedSources;
+
+        // The number of sources whose completion index was read.
+        size_t IndexedSourceCount = 0;
+    };
+
     // Allows calling code to inquire about specific features of an ISource implementation.
     // The default state of any new flag is false.
     enum class SourceFeatureFlag
@@ -314,6 +327,11 @@ namespace AppInstaller::Repository
         // Execute a search on the source.
         SearchResult Search(const SearchRequest& request) const;
 
+        // Gets the values of the field that start with the given prefix from the completion indexes of the sources, without opening them.
+        // When maximum is not 0, no more than that many values are returned.
+        // Must be called before Open, as the sources are not updated first.
+        CompletionValuesResult GetCompletionValues(PackageMatchField field, std::string_view prefix, size_t maximum = 0) const;
+
         /* Source agreements */
 
         // Get required agreement fields info.
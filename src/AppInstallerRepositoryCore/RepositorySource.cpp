@@ -17,6 +17,7 @@
 #include "Microsoft/ConfigurableTestSourceFactory.h"
 #endif
 
+#include <winget/CompletionIndex.h>
 #include <winget/GroupPolicy.h>
 
 using namespace AppInstaller::Settings;
@@ -726,6 +727,63 @@ namespace AppInstaller::Repository
         return m_source->Search(request);
     }
 
+    CompletionValuesResult Source::GetCompletionValues(PackageMatchField field, std::string_view prefix, size_t maximum) const
+    {
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), m_isSourceToBeAdded || m_source || m_sourceReferences.empty());
+
+        CompletionValuesResult result;
+
+        for (const auto& sourceReference : m_sourceReferences)
+        {
+            const SourceDetails& details = sourceReference->GetDetails();
+
+            std::optional<CompletionIndex> completionIndex;
+            if (details.Type == Microsoft::PreIndexedPackageSourceFactory::Type())
+            {
+                completionIndex = CompletionIndex::Open(Microsoft::PreIndexedPackageSourceFactory::GetCompletionIndexPath(details));
+            }
+
+            if (completionIndex)
+            {
+                std::vector<std::string> values = completionIndex->GetValues(field, prefix, maximum);
+                result.Values.insert(result.Values.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+                ++result.IndexedSourceCount;
+            }
+            else
+            {
+                AICLI_LOG(Repo, Verbose, << "No completion index for source: " << details.Name);
+                result.UnindexedSources.emplace_back(details);
+            }
+        }
+
+        // Each index returns its values in order, but those of multiple sources must be merged.
+        if (m_sourceReferences.size() > 1)
+        {
+            std::vector<std::pair<std::string, std::string>> keyedValues;
+            keyedValues.reserve(result.Values.size());
+            for (auto& value : result.Values)
+            {
+                keyedValues.emplace_back(Utility::FoldCase(std::string_view{ value }), std::move(value));
+            }
+
+            std::sort(keyedValues.begin(), keyedValues.end());
+            keyedValues.erase(std::unique(keyedValues.begin(), keyedValues.end()), keyedValues.end());
+
+            if (maximum && keyedValues.size() > maximum)
+            {
+                keyedValues.resize(maximum);
+            }
+
+            result.Values.clear();
+            for (auto& keyedValue : keyedValues)
+            {
+                result.Values.emplace_back(std::move(keyedValue.second));
+            }
+        }
+
+        return result;
+    }
+
     ImplicitAgreementFieldEnum Source::GetAgreementFieldsFromSourceInformation() const
     {
         ImplicitAgreementFieldEnum result = ImplicitAgreementFieldEnum::None;
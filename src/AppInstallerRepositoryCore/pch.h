@@ -33,12 +33,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bitset>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <initializer_list>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
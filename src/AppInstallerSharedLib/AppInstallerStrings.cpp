@@ -6,6 +6,14 @@
 #include "Public/AppInstallerLogging.h"
 #include "Public/AppInstallerSHA256.h"
 
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define AICLI_STRINGS_USE_SSE2
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define AICLI_STRINGS_USE_NEON
+#endif
+
 namespace AppInstaller::Utility
 {
     // Same as std::isspace(char)
@@ -158,11 +166,168 @@ namespace AppInstaller::Utility
             result.emplace_back(trim ? Utility::Trim(input.substr(startIndex)) : input.substr(startIndex));
             return result;
         }
+
+        // The ASCII helpers below process 16 bytes at a time where the platform allows it.
+        // Folding only changes bytes in ['A', 'Z'], so they are safe to use on any UTF8 input; for pure ASCII input
+        // the result is identical to ICU case folding.
+        constexpr size_t s_ASCIIBlockSize = 16;
+
+        char FoldASCII(char c)
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+#if defined(AICLI_STRINGS_USE_SSE2)
+        __m128i FoldASCII(__m128i block)
+        {
+            // Signed comparisons are fine here; every byte outside of ASCII is negative and so left alone.
+            __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+            return _mm_or_si128(block, _mm_and_si128(isUpper, _mm_set1_epi8('a' - 'A')));
+        }
+#elif defined(AICLI_STRINGS_USE_NEON)
+        uint8x16_t FoldASCII(uint8x16_t block)
+        {
+            uint8x16_t isUpper = vandq_u8(vcgeq_u8(block, vdupq_n_u8('A')), vcleq_u8(block, vdupq_n_u8('Z')));
+            return vorrq_u8(block, vandq_u8(isUpper, vdupq_n_u8('a' - 'A')));
+        }
+#endif
+
+        // Determines if the input contains only ASCII characters.
+        bool IsASCII(std::string_view input)
+        {
+            const char* data = input.data();
+            size_t size = input.size();
+            size_t i = 0;
+
+#if defined(AICLI_STRINGS_USE_SSE2)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))) != 0)
+                {
+                    return false;
+                }
+            }
+#elif defined(AICLI_STRINGS_USE_NEON)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data + i))) >= 0x80)
+                {
+                    return false;
+                }
+            }
+#endif
+
+            for (; i < size; ++i)
+            {
+                if (static_cast<unsigned char>(data[i]) >= 0x80)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Folds the ASCII upper case characters in the string to lower case.
+        void FoldASCIIInPlace(std::string& input)
+        {
+            char* data = input.data();
+            size_t size = input.size();
+            size_t i = 0;
+
+#if defined(AICLI_STRINGS_USE_SSE2)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                __m128i* block = reinterpret_cast<__m128i*>(data + i);
+                _mm_storeu_si128(block, FoldASCII(_mm_loadu_si128(block)));
+            }
+#elif defined(AICLI_STRINGS_USE_NEON)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                uint8_t* block = reinterpret_cast<uint8_t*>(data + i);
+                vst1q_u8(block, FoldASCII(vld1q_u8(block)));
+            }
+#endif
+
+            for (; i < size; ++i)
+            {
+                data[i] = FoldASCII(data[i]);
+            }
+        }
+
+        // Compares the strings, treating ASCII upper and lower case characters as equal.
+        // All other bytes must match exactly.
+        bool ASCIICaseInsensitiveEquals(std::string_view a, std::string_view b)
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+
+            const char* dataA = a.data();
+            const char* dataB = b.data();
+            size_t size = a.size();
+            size_t i = 0;
+
+#if defined(AICLI_STRINGS_USE_SSE2)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                __m128i blockA = FoldASCII(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dataA + i)));
+                __m128i blockB = FoldASCII(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dataB + i)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) != 0xFFFF)
+                {
+                    return false;
+                }
+            }
+#elif defined(AICLI_STRINGS_USE_NEON)
+            for (; i + s_ASCIIBlockSize <= size; i += s_ASCIIBlockSize)
+            {
+                uint8x16_t blockA = FoldASCII(vld1q_u8(reinterpret_cast<const uint8_t*>(dataA + i)));
+                uint8x16_t blockB = FoldASCII(vld1q_u8(reinterpret_cast<const uint8_t*>(dataB + i)));
+                if (vminvq_u8(vceqq_u8(blockA, blockB)) != 0xFF)
+                {
+                    return false;
+                }
+            }
+#endif
+
+            for (; i < size; ++i)
+            {
+                if (FoldASCII(dataA[i]) != FoldASCII(dataB[i]))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Opening a case map is comparatively expensive, so each thread keeps the one it needs for folding.
+        UCaseMap* GetFoldCaseMap()
+        {
+            thread_local wil::unique_any<UCaseMap*, decltype(ucasemap_close), &ucasemap_close> caseMap;
+
+            if (!caseMap)
+            {
+                UErrorCode errorCode = UErrorCode::U_ZERO_ERROR;
+                caseMap.reset(ucasemap_open(nullptr, U_FOLD_CASE_DEFAULT, &errorCode));
+
+                if (U_FAILURE(errorCode))
+                {
+                    caseMap.reset();
+                    AICLI_LOG(Core, Error, << "ucasemap_open returned " << errorCode);
+                    THROW_HR(APPINSTALLER_CLI_ERROR_ICU_CASEMAP_ERROR);
+                }
+            }
+
+            return caseMap.get();
+        }
     }
 
     bool CaseInsensitiveEquals(std::string_view a, std::string_view b)
     {
-        return ToLower(a) == ToLower(b);
+        // ToLower only changes ASCII characters, so this is equivalent to comparing the lowered strings.
+        return ASCIICaseInsensitiveEquals(a, b);
     }
 
     bool CaseInsensitiveEquals(std::wstring_view a, std::wstring_view b)
@@ -172,8 +337,7 @@ namespace AppInstaller::Utility
 
     bool CaseInsensitiveContains(const std::vector<std::string_view>& a, std::string_view b)
     {
-        auto B = ToLower(b);
-        return std::any_of(a.begin(), a.end(), [&](const std::string_view& s) { return ToLower(s) == B; });
+        return std::any_of(a.begin(), a.end(), [&](const std::string_view& s) { return ASCIICaseInsensitiveEquals(s, b); });
     }
 
     bool StartsWith(std::wstring_view a, std::wstring_view b)
@@ -196,7 +360,7 @@ namespace AppInstaller::Utility
         auto it = std::search(
             a.begin(), a.end(),
             b.begin(), b.end(),
-            [](char ch1, char ch2) { return std::tolower(ch1) == std::tolower(ch2); }
+            [](char ch1, char ch2) { return FoldASCII(ch1) == FoldASCII(ch2); }
         );
         return (it != a.end());
     }
@@ -212,6 +376,11 @@ namespace AppInstaller::Utility
 
     bool ICUCaseInsensitiveEquals(std::string_view a, std::string_view b)
     {
+        if (IsASCII(a) && IsASCII(b))
+        {
+            return ASCIICaseInsensitiveEquals(a, b);
+        }
+
         return FoldCase(a) == FoldCase(b);
     }
 
@@ -493,34 +662,35 @@ namespace AppInstaller::Utility
             return {};
         }
 
-        wil::unique_any<UCaseMap*, decltype(ucasemap_close), &ucasemap_close> caseMap;
-        UErrorCode errorCode = UErrorCode::U_ZERO_ERROR;
-        caseMap.reset(ucasemap_open(nullptr, U_FOLD_CASE_DEFAULT, &errorCode));
-
-        if (U_FAILURE(errorCode))
+        if (IsASCII(input))
         {
-            AICLI_LOG(Core, Error, << "ucasemap_open returned " << errorCode);
-            THROW_HR(APPINSTALLER_CLI_ERROR_ICU_CASEMAP_ERROR);
+            std::string result{ input };
+            FoldASCIIInPlace(result);
+            return result;
         }
 
-        int32_t cch = ucasemap_utf8FoldCase(caseMap.get(), nullptr, 0, input.data(), static_cast<int32_t>(input.size()), &errorCode);
-        if (errorCode != U_BUFFER_OVERFLOW_ERROR)
+        UCaseMap* caseMap = GetFoldCaseMap();
+        UErrorCode errorCode = UErrorCode::U_ZERO_ERROR;
+
+        // Folding rarely changes the length, so start with a buffer the size of the input and only retry if it was too small.
+        std::string result(input.size(), '\0');
+        int32_t cch = ucasemap_utf8FoldCase(caseMap, &result[0], static_cast<int32_t>(result.size()), input.data(), static_cast<int32_t>(input.size()), &errorCode);
+        if (errorCode == U_BUFFER_OVERFLOW_ERROR)
         {
-            AICLI_LOG(Core, Error, << "ucasemap_utf8FoldCase returned " << errorCode);
-            THROW_HR(APPINSTALLER_CLI_ERROR_ICU_CASEMAP_ERROR);
+            errorCode = UErrorCode::U_ZERO_ERROR;
+            result.assign(cch, '\0');
+            cch = ucasemap_utf8FoldCase(caseMap, &result[0], cch, input.data(), static_cast<int32_t>(input.size()), &errorCode);
         }
 
-        errorCode = UErrorCode::U_ZERO_ERROR;
-
-        std::string result(cch, '\0');
-        cch = ucasemap_utf8FoldCase(caseMap.get(), &result[0], cch, input.data(), static_cast<int32_t>(input.size()), &errorCode);
         if (U_FAILURE(errorCode))
         {
             AICLI_LOG(Core, Error, << "ucasemap_utf8FoldCase returned " << errorCode);
             THROW_HR(APPINSTALLER_CLI_ERROR_ICU_CASEMAP_ERROR);
         }
 
-        while (result.back() == '\0')
+        result.resize(cch);
+
+        while (!result.empty() && result.back() == '\0')
         {
             result.pop_back();
         }
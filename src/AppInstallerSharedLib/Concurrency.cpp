@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/winget/Concurrency.h"
+#include "Public/winget/SharedThreadGlobals.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace AppInstaller::Utility
+{
+    namespace
+    {
+        // A set of threads running the same worker; they are joined when it is destroyed, so that an exception
+        // while starting them never destroys a joinable thread.
+        struct WorkerThreads
+        {
+            WorkerThreads(const std::function<void()>& worker) :
+                m_worker(worker), m_globals(ThreadLocalStorage::ThreadGlobals::GetForCurrentThread()) {}
+
+            WorkerThreads(const WorkerThreads&) = delete;
+            WorkerThreads& operator=(const WorkerThreads&) = delete;
+
+            ~WorkerThreads()
+            {
+                Join();
+            }
+
+            void Start(size_t threadCount)
+            {
+                m_threads.reserve(threadCount);
+
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    m_threads.emplace_back([this]()
+                        {
+                            Run([this]()
+                                {
+                                    std::unique_ptr<ThreadLocalStorage::PreviousThreadGlobals> previousGlobals;
+                                    if (m_globals)
+                                    {
+                                        previousGlobals = m_globals->SetForCurrentThread();
+                                    }
+
+                                    m_worker();
+                                });
+                        });
+                }
+            }
+
+            // Runs the operation, keeping the first exception thrown on any thread.
+            void Run(const std::function<void()>& operation)
+            {
+                try
+                {
+                    operation();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock{ m_errorMutex };
+                    if (!m_error)
+                    {
+                        m_error = std::current_exception();
+                    }
+                }
+            }
+
+            void Join()
+            {
+                for (auto& thread : m_threads)
+                {
+                    if (thread.joinable())
+                    {
+                        thread.join();
+                    }
+                }
+
+                m_threads.clear();
+            }
+
+            void RethrowIfFailed()
+            {
+                if (m_error)
+                {
+                    std::rethrow_exception(m_error);
+                }
+            }
+
+        private:
+            const std::function<void()>& m_worker;
+            ThreadLocalStorage::ThreadGlobals* m_globals = nullptr;
+            std::vector<std::thread> m_threads;
+            std::mutex m_errorMutex;
+            std::exception_ptr m_error;
+        };
+    }
+
+    size_t GetConcurrentThreadCount(size_t count, size_t maximum)
+    {
+        size_t result = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        if (maximum)
+        {
+            result = std::min(result, maximum);
+        }
+
+        return std::min(result, count);
+    }
+
+    void RunConcurrently(size_t threadCount, const std::function<void()>& worker)
+    {
+        if (threadCount == 0)
+        {
+            return;
+        }
+
+        WorkerThreads threads{ worker };
+        threads.Start(threadCount - 1);
+        threads.Run(worker);
+        threads.Join();
+        threads.RethrowIfFailed();
+    }
+
+    void RunConcurrently(size_t threadCount, const std::function<void()>& worker, const std::function<void()>& monitor)
+    {
+        WorkerThreads threads{ worker };
+        threads.Start(threadCount);
+        threads.Run(monitor);
+        threads.Join();
+        threads.RethrowIfFailed();
+    }
+
+    void ForEachConcurrently(size_t count, const std::function<void(size_t)>& operation, size_t maximumThreads)
+    {
+        std::vector<std::exception_ptr> errors(count);
+        std::atomic<size_t> next = 0;
+
+        RunConcurrently(GetConcurrentThreadCount(count, maximumThreads), [&]()
+            {
+                for (size_t i = next++; i < count; i = next++)
+                {
+                    try
+                    {
+                        operation(i);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            });
+
+        for (const auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
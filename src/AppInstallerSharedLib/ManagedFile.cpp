@@ -17,12 +17,13 @@ namespace AppInstaller::Utility
         return file;
     }
 
-    ManagedFile ManagedFile::OpenWriteLockedFile(const std::filesystem::path& path, DWORD desiredAccess)
+    ManagedFile ManagedFile::OpenWriteLockedFile(const std::filesystem::path& path, DWORD desiredAccess, bool deleteOnExit)
     {
         ManagedFile file;
         file.m_fileHandle.reset(CreateFileW(path.c_str(), desiredAccess, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
         THROW_LAST_ERROR_IF(!file.m_fileHandle);
         file.m_filePath = path;
+        file.m_deleteFileOnExit = deleteOnExit;
 
         return file;
     }
@@ -29,7 +29,16 @@ namespace AppInstaller::Utility {
             uint64_t SizeInBytes = 0;
         };
 
-        SHA256();
+        // The implementation that computes the hash.
+        enum class Backend
+        {
+            // The OS crypto provider; the default, and the one to use for anything checked against an expected hash.
+            BCrypt,
+            // The built in implementation; it uses the processor's SHA extensions when available.
+            Portable,
+        };
+
+        SHA256(Backend backend = Backend::BCrypt);
 
         // Adds the next chunk of data to the hash.
         void Add(const uint8_t* buffer, size_t cbBuffer);
@@ -51,27 +60,37 @@ namespace AppInstaller::Utility {
         }
 
         // Computes the hash of the given buffer immediately.
-        static HashBuffer ComputeHash(const uint8_t* buffer, std::uint32_t cbBuffer);
+        static HashBuffer ComputeHash(const uint8_t* buffer, std::uint32_t cbBuffer, Backend backend = Backend::BCrypt);
 
         // Computes the hash of the given buffer immediately.
-        static HashBuffer ComputeHash(const std::vector<uint8_t>& buffer);
+        static HashBuffer ComputeHash(const std::vector<uint8_t>& buffer, Backend backend = Backend::BCrypt);
 
         // Computes the hash of the given string immediately.
-        static HashBuffer ComputeHash(std::string_view buffer);
+        static HashBuffer ComputeHash(std::string_view buffer, Backend backend = Backend::BCrypt);
 
         // Computes the hash from a given stream.
-        static HashBuffer ComputeHash(std::istream& in);
+        static HashBuffer ComputeHash(std::istream& in, Backend backend = Backend::BCrypt);
 
         // Computes the hash from a given stream.
-        static HashDetails ComputeHashDetails(std::istream& in);
+        static HashDetails ComputeHashDetails(std::istream& in, Backend backend = Backend::BCrypt);
 
         // Computes the hash from a given file path.
-        static HashBuffer ComputeHashFromFile(const std::filesystem::path& path);
+        static HashBuffer ComputeHashFromFile(const std::filesystem::path& path, Backend backend = Backend::BCrypt);
 
         // Computes the hash from an open file HANDLE by reading sequentially from the current position.
         // The caller retains ownership of the handle.
         static HashBuffer ComputeHashFromHandle(HANDLE fileHandle);
 
+        // Computes the hashes of many buffers, spreading them across threads and using the bulk backend; the results are in the same order as the input.
+        static std::vector<HashBuffer> ComputeHashes(const std::vector<std::string_view>& buffers);
+
+        // Computes the hashes of many files, spreading them across threads and using the bulk backend; the results are in the same order as the input.
+        static std::vector<HashBuffer> ComputeHashesFromFiles(const std::vector<std::filesystem::path>& paths);
+
+        // Gets the backend for hashing large amounts of data whose hash is produced rather than verified, such as when packaging.
+        // This is the portable backend when it can use the processor's SHA extensions, and BCrypt otherwise.
+        static Backend GetBulkBackend();
+
         static std::string ConvertToString(const HashBuffer& hashBuffer);
 
         static std::wstring ConvertToWideString(const HashBuffer& hashBuffer);
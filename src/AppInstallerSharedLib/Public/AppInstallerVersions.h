@@ -83,7 +83,7 @@ namespace AppInstaller::Utility
         {
             Part() = default;
             Part(uint64_t integer) : Integer(integer) {}
-            Part(const std::string& part);
+            Part(std::string_view part);
             Part(uint64_t integer, std::string other);
 
             bool operator<(const Part& other) const;
@@ -121,8 +121,15 @@ namespace AppInstaller::Utility
         bool m_trimPrefix = true;
         ApproximateComparator m_approximateComparator = ApproximateComparator::None;
 
-      // Remove trailing empty parts (0 or empty)
+        // Whether the base version is Latest or Unknown; these are checked by every comparison.
+        bool m_isBaseVersionLatest = false;
+        bool m_isBaseVersionUnknown = false;
+
+        // Remove trailing empty parts (0 or empty), then update the values derived from the parts.
         void Trim();
+
+        // Update the values derived from the parts; must be called whenever the parts are set.
+        void UpdateBaseVersionFlags();
     };
 
     // Version that does not have leading non-digit characters trimmed
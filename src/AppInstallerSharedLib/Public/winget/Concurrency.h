@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <functional>
+
+namespace AppInstaller::Utility
+{
+    // Gets the number of threads to use for `count` items of concurrent work; the number of processors,
+    // limited by the maximum (when not 0) and by the count.
+    size_t GetConcurrentThreadCount(size_t count, size_t maximum = 0);
+
+    // Runs the worker on the given number of threads, one of which is the calling thread, and returns once all of them have finished.
+    // The new threads run with the thread globals of the calling thread. The threads that were started are always joined,
+    // even when starting another one fails; that failure, or the first exception thrown by a worker, is then rethrown.
+    void RunConcurrently(size_t threadCount, const std::function<void()>& worker);
+
+    // Runs the worker on the given number of new threads while the calling thread runs the monitor, such as to report progress.
+    // The monitor must return once the workers have finished. It is not run if a thread cannot be started.
+    void RunConcurrently(size_t threadCount, const std::function<void()>& worker, const std::function<void()>& monitor);
+
+    // Runs the operation for each index in [0, count) on up to `maximumThreads` threads (0 for the number of processors),
+    // the calling thread among them. Every index is run even when some fail; the first exception, in index order,
+    // is rethrown once all are done.
+    void ForEachConcurrently(size_t count, const std::function<void(size_t)>& operation, size_t maximumThreads = 0);
+}
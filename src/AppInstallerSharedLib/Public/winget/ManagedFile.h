@@ -24,7 +24,7 @@ namespace AppInstaller::Utility
         static ManagedFile CreateWriteLockedFile(const std::filesystem::path& path, DWORD desiredAccess, bool deleteOnExit);
 
         // Always opens an existing file at the path given with write locked. desiredAccess is passed to CreateFile call.
-        static ManagedFile OpenWriteLockedFile(const std::filesystem::path& path, DWORD desiredAccess);
+        static ManagedFile OpenWriteLockedFile(const std::filesystem::path& path, DWORD desiredAccess, bool deleteOnExit = false);
 
         ~ManagedFile();
 
@@ -221,6 +221,9 @@ namespace AppInstaller::Registry
             // Gets the name of the subkey.
             std::string Name() const;
 
+            // Gets the last write time of the subkey, as reported by the enumeration.
+            const FILETIME& LastWriteTime() const { return m_lastWriteTime; }
+
             // Opens the subkey.
             Key Open() const;
 
@@ -239,6 +242,7 @@ namespace AppInstaller::Registry
             wil::shared_hkey m_parentKey;
             REGSAM m_access = KEY_READ;
             std::wstring m_subKeyName;
+            FILETIME m_lastWriteTime{};
         };
 
         struct const_iterator
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <winsqlite/winsqlite3.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AppInstaller::SQLite
+{
+    // Aggregates the cost of the statements run on the connections opened while it is enabled, using the SQLite trace hooks.
+    // Statements are grouped by their text with the literal values replaced, so that a query is counted together
+    // regardless of the values it was built with. The query plan of a statement that runs longer than the threshold is logged.
+    struct Profiler
+    {
+        // The aggregated cost of a normalized statement.
+        struct StatementStatistics
+        {
+            std::string SQL;
+            size_t Count = 0;
+            std::chrono::nanoseconds TotalTime{};
+            std::chrono::nanoseconds MaximumTime{};
+            uint64_t Rows = 0;
+            // The rows visited by full table scans; a large value suggests a missing index.
+            uint64_t FullScanSteps = 0;
+            // The indexes that SQLite built on the fly to run the statement, which also suggest a missing index.
+            uint64_t AutomaticIndexes = 0;
+            uint64_t Sorts = 0;
+        };
+
+        Profiler() = default;
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        Profiler(Profiler&&) = delete;
+        Profiler& operator=(Profiler&&) = delete;
+
+        // Gets the profiler for the process.
+        static Profiler& Instance();
+
+        // Enables profiling of the connections opened from now on.
+        void Enable(std::chrono::milliseconds slowStatementThreshold);
+
+        bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        // Installs the trace hooks on the connection if profiling is enabled.
+        void Attach(sqlite3* connection);
+
+        // Logs the query plans of the slow statements that have completed on the connection.
+        // SQLite does not allow statements to be run from within the trace hook, so this is called after stepping.
+        void LogPendingQueryPlans(sqlite3* connection);
+
+        // Gets the statistics of every statement, in descending order of total time.
+        std::vector<StatementStatistics> GetStatistics() const;
+
+        // Writes the statistics of the most expensive statements to the log.
+        void LogSummary(size_t maximumStatements = 25) const;
+
+        // Replaces the literal values and generated names in the statement, and collapses whitespace.
+        static std::string NormalizeSQL(std::string_view sql);
+
+    private:
+        static int TraceCallback(unsigned int type, void* context, void* p, void* x);
+
+        void OnRow(sqlite3_stmt* statement);
+        void OnProfile(sqlite3_stmt* statement, std::chrono::nanoseconds time);
+        void OnClose(sqlite3* connection);
+
+        struct Entry
+        {
+            StatementStatistics Statistics;
+            bool QueryPlanLogged = false;
+        };
+
+        std::atomic_bool m_enabled = false;
+        std::chrono::nanoseconds m_slowStatementThreshold{};
+        mutable std::mutex m_lock;
+        // Kept by connection, so that everything for a connection is dropped when it closes and its handles can be reused.
+        std::unordered_map<sqlite3*, std::unordered_map<sqlite3_stmt*, uint64_t>> m_rowsInProgress;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::unordered_map<sqlite3*, std::vector<std::string>> m_pendingQueryPlans;
+    };
+
+    // Writes the query plan of the statement to the log.
+    void LogQueryPlan(sqlite3* connection, std::string_view sql);
+}
@@ -363,6 +363,9 @@ namespace AppInstaller::SQLite
     private:
         Statement(const Connection& connection, std::string_view sql);
 
+        // Logs the query plans that the profiler has queued for the connection, if it is enabled.
+        void LogPendingQueryPlans();
+
         // Helper to receive the integer sequence from the public function.
         // This is equivalent to calling:
         //  for (i = 0 .. count of Values types)
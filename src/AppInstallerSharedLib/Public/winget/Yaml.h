@@ -63,6 +63,33 @@ namespace AppInstaller::YAML
         YAML::Mark m_mark;
     };
 
+    // Contiguous storage for the scalar values of a node tree.
+    // Nodes reference their scalar by view and share ownership of the arena, so copying
+    // a node (or a subtree) never copies the underlying strings.
+    struct NodeArena
+    {
+        // Creates an arena that can hold exactly `capacity` bytes of scalar data.
+        NodeArena(size_t capacity);
+
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+
+        NodeArena(NodeArena&&) = delete;
+        NodeArena& operator=(NodeArena&&) = delete;
+
+        // Copies the value into the arena, returning a view of the stored copy.
+        // The arena never reallocates; storing beyond the capacity throws.
+        std::string_view Store(std::string_view value);
+
+        // Gets the number of bytes that are still available.
+        size_t Available() const { return m_capacity - m_used; }
+
+    private:
+        std::unique_ptr<char[]> m_buffer;
+        size_t m_capacity = 0;
+        size_t m_used = 0;
+    };
+
     // A YAML node.
     struct Node
     {
@@ -90,19 +117,25 @@ namespace AppInstaller::YAML
             Map,
         };
 
+        // The storage for the children of a mapping; kept sorted by key, with duplicate keys in insertion order.
+        using MappingStorage = std::vector<std::pair<Node, Node>>;
+
         Node() : m_type(Type::Invalid), m_tagType(TagType::Unknown) {}
-        Node(Type type, std::string tag, const Mark& mark);
+        Node(Type type, std::string_view tag, const Mark& mark);
 
         // Sets the scalar value of the node.
-        void SetScalar(std::string value);
-        void SetScalar(std::string value, bool isQuoted);
+        void SetScalar(std::string_view value);
+        void SetScalar(std::string_view value, bool isQuoted);
+
+        // Sets the scalar value of the node to a value already stored in the given arena, which is shared by the whole tree.
+        void SetScalar(std::string_view storedValue, bool isQuoted, const std::shared_ptr<NodeArena>& arena);
 
         // Adds a child node to the sequence.
         template <typename... Args>
         Node& AddSequenceNode(Args&&... args)
         {
             Require(Type::Sequence);
-            return m_sequence->emplace_back(std::forward<Args>(args)...);
+            return m_sequence.emplace_back(std::forward<Args>(args)...);
         }
 
         // Merges sequence nodes. If both sequence have the specified key with the same value
@@ -113,8 +146,7 @@ namespace AppInstaller::YAML
         template <typename... Args>
         Node& AddMappingNode(Node&& key, Args&&... args)
         {
-            Require(Type::Mapping);
-            return m_mapping->emplace(std::move(key), Node(std::forward<Args>(args)...))->second;
+            return InsertMappingPair(std::move(key), Node(std::forward<Args>(args)...));
         }
 
         // Merge mapping node. If both contain a node with the same key preserve this.
@@ -174,15 +206,22 @@ namespace AppInstaller::YAML
         // Gets the nodes in the sequence.
         const std::vector<Node>& Sequence() const;
 
-        // Gets the nodes in the mapping.
-        const std::multimap<Node, Node>& Mapping() const;
+        // Gets the nodes in the mapping, ordered by key.
+        const MappingStorage& Mapping() const;
 
     private:
-        Node(std::string_view key) : m_type(Type::Scalar), m_scalar(key), m_tagType(TagType::Str) {}
-
         // Require certain node types to; throwing if the requirement is not met.
         void Require(Type type) const;
 
+        // Infers the tag type of an untagged scalar from its value.
+        void InferScalarTagType(bool isQuoted);
+
+        // Inserts the pair after any existing pairs with an equal key.
+        Node& InsertMappingPair(Node&& key, Node&& value);
+
+        // Finds the index range of pairs whose key is equal to the given value, without creating a temporary node.
+        std::pair<size_t, size_t> EqualRange(std::string_view key) const;
+
         // The workers for the as function.
         std::string as_dispatch(std::string*) const;
         std::optional<std::string> try_as_dispatch(std::string*) const;
@@ -200,12 +239,13 @@ namespace AppInstaller::YAML
         std::optional<bool> try_as_dispatch(bool*) const;
 
         Type m_type;
-        std::string m_tag;
         TagType m_tagType;
         YAML::Mark m_mark;
-        std::string m_scalar;
-        std::optional<std::vector<Node>> m_sequence;
-        std::optional<std::multimap<Node, Node>> m_mapping;
+        // The scalar value is a view into the arena, which is shared by all nodes created from the same document.
+        std::shared_ptr<NodeArena> m_arena;
+        std::string_view m_scalar;
+        std::vector<Node> m_sequence;
+        MappingStorage m_mapping;
     };
 
     // Loads from the input; returns the root node of the first document.
@@ -327,7 +327,7 @@ namespace AppInstaller::Registry
         while (m_subKeyName.size() < 4096)
         {
             charCount = wil::safe_cast<DWORD>(m_subKeyName.size());
-            status = RegEnumKeyExW(m_parentKey.get(), index, &m_subKeyName[0], &charCount, nullptr, nullptr, nullptr, nullptr);
+            status = RegEnumKeyExW(m_parentKey.get(), index, &m_subKeyName[0], &charCount, nullptr, nullptr, nullptr, &m_lastWriteTime);
 
             if (status == ERROR_MORE_DATA)
             {
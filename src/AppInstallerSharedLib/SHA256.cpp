@@ -6,49 +6,51 @@
 #include "Public/AppInstallerSHA256.h"
 #include "Public/AppInstallerErrors.h"
 #include "Public/AppInstallerStrings.h"
+#include "Public/winget/Concurrency.h"
+#include "SHA256Portable.h"
 
 namespace AppInstaller::Utility {
 
+    namespace
+    {
+        // The algorithm provider is expensive to open and safe to share across threads, so it is opened once.
+        BCRYPT_ALG_HANDLE GetAlgorithmProvider()
+        {
+            static wil::unique_bcrypt_algorithm s_algorithm = []()
+            {
+                wil::unique_bcrypt_algorithm result;
+                THROW_IF_NTSTATUS_FAILED_MSG(BCryptOpenAlgorithmProvider(
+                    &result,                    // Alg Handle pointer
+                    BCRYPT_SHA256_ALGORITHM,    // Cryptographic Algorithm name (null terminated unicode string)
+                    nullptr,                    // Provider name; if null, the default provider is loaded
+                    0),                         // Flags
+                    "failed opening SHA256 algorithm provider");
+                return result;
+            }();
+
+            return s_algorithm.get();
+        }
+    }
+
     struct SHA256Context
     {
-        wil::unique_bcrypt_algorithm algHandle;
+        // Only one of these is used, depending on the backend.
         wil::unique_bcrypt_hash hashHandle;
-        DWORD hashLength = 0;
+        std::optional<SHA256Portable> portable;
     };
 
-    SHA256::SHA256() : context(new SHA256Context{})
+    SHA256::SHA256(Backend backend) : context(new SHA256Context{})
     {
-        BCRYPT_ALG_HANDLE algHandleT{};
-        BCRYPT_HASH_HANDLE hashHandleT;
-        DWORD resultLength = 0;
-
-        // Open an algorithm handle
-        THROW_IF_NTSTATUS_FAILED_MSG(BCryptOpenAlgorithmProvider(
-            &algHandleT,                // Alg Handle pointer
-            BCRYPT_SHA256_ALGORITHM,    // Cryptographic Algorithm name (null terminated unicode string)
-            nullptr,                    // Provider name; if null, the default provider is loaded
-            0),                         // Flags
-            "failed opening SHA256 algorithm provider");
-        context->algHandle.reset(algHandleT);
-
-        // Obtain the length of the hash
-        THROW_IF_NTSTATUS_FAILED_MSG(BCryptGetProperty(
-            context->algHandle.get(),       // Handle to a CNG object
-            BCRYPT_HASH_LENGTH,             // Property name (null terminated unicode string)
-            (PBYTE) & (context->hashLength),  // Address of the output buffer which receives the property value
-            sizeof(context->hashLength),    // Size of the buffer in bytes
-            &resultLength,                  // Number of bytes that were copied into the buffer
-            0),                             // Flags
-            "failed getting SHA256 hash length");
-        
-        if (resultLength != sizeof(context->hashLength))
+        if (backend == Backend::Portable)
         {
-            THROW_HR_MSG(E_UNEXPECTED, "failed getting SHA256 hash length");
+            context->portable.emplace();
+            return;
         }
 
         // Create a hash handle
+        BCRYPT_HASH_HANDLE hashHandleT{};
         THROW_IF_NTSTATUS_FAILED_MSG(BCryptCreateHash(
-            context->algHandle.get(),   // Handle to an algorithm provider
+            GetAlgorithmProvider(),     // Handle to an algorithm provider
             &hashHandleT,               // A pointer to a hash handle - can be a hash or hmac object
             nullptr,                    // Pointer to the buffer that receives the hash/hmac object
             0,                          // Size of the buffer in bytes
@@ -63,10 +65,22 @@ namespace AppInstaller::Utility {
     {
         EnsureNotFinished();
 
-        // Add the data
-        THROW_IF_NTSTATUS_FAILED_MSG(
-            BCryptHashData(context->hashHandle.get(), const_cast<PUCHAR>(buffer), static_cast<ULONG>(cbBuffer), 0),
-            "failed adding SHA256 data");
+        if (context->portable)
+        {
+            context->portable->Add(buffer, cbBuffer);
+            return;
+        }
+
+        // Add the data; BCrypt takes at most a ULONG at a time.
+        while (cbBuffer > 0)
+        {
+            ULONG count = static_cast<ULONG>(std::min<size_t>(cbBuffer, std::numeric_limits<ULONG>::max()));
+            THROW_IF_NTSTATUS_FAILED_MSG(
+                BCryptHashData(context->hashHandle.get(), const_cast<PUCHAR>(buffer), count, 0),
+                "failed adding SHA256 data");
+            buffer += count;
+            cbBuffer -= count;
+        }
     }
 
     void SHA256::Get(HashBuffer& hash)
@@ -74,15 +88,22 @@ namespace AppInstaller::Utility {
         EnsureNotFinished();
 
         // Size the hash buffer appropriately
-        hash.resize(context->hashLength);
+        hash.resize(HashBufferSizeInBytes);
 
-        // Obtain the hash of the message(s) into the hash buffer
-        THROW_IF_NTSTATUS_FAILED_MSG(BCryptFinishHash(
-            context->hashHandle.get(),  // Handle to the hash or MAC object
-            hash.data(),                // A pointer to a buffer that receives the hash or MAC value
-            context->hashLength,        // Size of the buffer in bytes
-            0),                         // Flags
-            "failed getting SHA256 hash");
+        if (context->portable)
+        {
+            context->portable->Get(hash.data());
+        }
+        else
+        {
+            // Obtain the hash of the message(s) into the hash buffer
+            THROW_IF_NTSTATUS_FAILED_MSG(BCryptFinishHash(
+                context->hashHandle.get(),  // Handle to the hash or MAC object
+                hash.data(),                // A pointer to a buffer that receives the hash or MAC value
+                static_cast<ULONG>(hash.size()), // Size of the buffer in bytes
+                0),                         // Flags
+                "failed getting SHA256 hash");
+        }
 
         context.reset();
     }
@@ -107,30 +128,30 @@ namespace AppInstaller::Utility {
         return Utility::ParseFromHexString(Utility::ConvertToUTF8(hashStr), HashBufferSizeInBytes);
     }
 
-    SHA256::HashBuffer SHA256::ComputeHash(const std::uint8_t* buffer, std::uint32_t cbBuffer)
+    SHA256::HashBuffer SHA256::ComputeHash(const std::uint8_t* buffer, std::uint32_t cbBuffer, Backend backend)
     {
-        SHA256 hasher;
+        SHA256 hasher{ backend };
         hasher.Add(buffer, cbBuffer);
         return hasher.Get();
     }
 
-    SHA256::HashBuffer SHA256::ComputeHash(const std::vector<uint8_t>& buffer)
+    SHA256::HashBuffer SHA256::ComputeHash(const std::vector<uint8_t>& buffer, Backend backend)
     {
         THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER), buffer.size() > std::numeric_limits<uint32_t>::max());
-        return ComputeHash(buffer.data(), static_cast<uint32_t>(buffer.size()));
+        return ComputeHash(buffer.data(), static_cast<uint32_t>(buffer.size()), backend);
     }
 
-    SHA256::HashBuffer SHA256::ComputeHash(std::string_view buffer)
+    SHA256::HashBuffer SHA256::ComputeHash(std::string_view buffer, Backend backend)
     {
-        return ComputeHash(reinterpret_cast<const std::uint8_t*>(buffer.data()), static_cast<std::uint32_t>(buffer.size()));
+        return ComputeHash(reinterpret_cast<const std::uint8_t*>(buffer.data()), static_cast<std::uint32_t>(buffer.size()), backend);
     }
 
-    SHA256::HashBuffer SHA256::ComputeHash(std::istream& in)
+    SHA256::HashBuffer SHA256::ComputeHash(std::istream& in, Backend backend)
     {
-        return ComputeHashDetails(in).Hash;
+        return ComputeHashDetails(in, backend).Hash;
     }
 
-    SHA256::HashDetails SHA256::ComputeHashDetails(std::istream& in)
+    SHA256::HashDetails SHA256::ComputeHashDetails(std::istream& in, Backend backend)
     {
         // Throw exceptions on badbit
         auto excState = in.exceptions();
@@ -140,7 +161,7 @@ namespace AppInstaller::Utility {
         const int bufferSize = 1024 * 1024; // 1MB
         auto buffer = std::make_unique<uint8_t[]>(bufferSize);
 
-        SHA256 hasher;
+        SHA256 hasher{ backend };
         uint64_t totalSize = 0;
 
         while (in.good())
@@ -167,10 +188,10 @@ namespace AppInstaller::Utility {
         }
     }
 
-    SHA256::HashBuffer SHA256::ComputeHashFromFile(const std::filesystem::path& path)
+    SHA256::HashBuffer SHA256::ComputeHashFromFile(const std::filesystem::path& path, Backend backend)
     {
         std::ifstream inStream{ path, std::ifstream::binary };
-        const Utility::SHA256::HashBuffer& targetFileHash = Utility::SHA256::ComputeHash(inStream);
+        const Utility::SHA256::HashBuffer& targetFileHash = Utility::SHA256::ComputeHash(inStream, backend);
         inStream.close();
         return targetFileHash;
     }
@@ -190,6 +211,33 @@ namespace AppInstaller::Utility {
         return hasher.Get();
     }
 
+    std::vector<SHA256::HashBuffer> SHA256::ComputeHashes(const std::vector<std::string_view>& buffers)
+    {
+        std::vector<HashBuffer> result(buffers.size());
+        Backend backend = GetBulkBackend();
+        ForEachConcurrently(buffers.size(), [&](size_t i)
+            {
+                result[i] = ComputeHash(buffers[i], backend);
+            });
+        return result;
+    }
+
+    std::vector<SHA256::HashBuffer> SHA256::ComputeHashesFromFiles(const std::vector<std::filesystem::path>& paths)
+    {
+        std::vector<HashBuffer> result(paths.size());
+        Backend backend = GetBulkBackend();
+        ForEachConcurrently(paths.size(), [&](size_t i)
+            {
+                result[i] = ComputeHashFromFile(paths[i], backend);
+            });
+        return result;
+    }
+
+    SHA256::Backend SHA256::GetBulkBackend()
+    {
+        return SHA256Portable::IsHardwareAccelerated() ? Backend::Portable : Backend::BCrypt;
+    }
+
     void SHA256::SHA256ContextDeleter::operator()(SHA256Context* context)
     {
         delete context;
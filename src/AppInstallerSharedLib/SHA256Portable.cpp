@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "SHA256Portable.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#include <immintrin.h>
+#define WINGET_SHA256_X86
+#elif defined(_M_ARM64)
+#include <arm_neon.h>
+#define WINGET_SHA256_ARM64
+#endif
+
+namespace AppInstaller::Utility
+{
+    namespace
+    {
+        constexpr uint32_t s_InitialState[8] =
+        {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+        };
+
+        alignas(16) constexpr uint32_t s_RoundConstants[64] =
+        {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        inline uint32_t RotateRight(uint32_t value, int count)
+        {
+            return (value >> count) | (value << (32 - count));
+        }
+
+        inline uint32_t LoadBigEndian(const uint8_t* data)
+        {
+            return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+        }
+
+        inline void StoreBigEndian(uint8_t* data, uint32_t value)
+        {
+            data[0] = static_cast<uint8_t>(value >> 24);
+            data[1] = static_cast<uint8_t>(value >> 16);
+            data[2] = static_cast<uint8_t>(value >> 8);
+            data[3] = static_cast<uint8_t>(value);
+        }
+
+        // Processes whole blocks of data into the state.
+        using TransformFunction = void(*)(uint32_t* state, const uint8_t* data, size_t blockCount);
+
+        void TransformScalar(uint32_t* state, const uint8_t* data, size_t blockCount)
+        {
+            for (; blockCount > 0; --blockCount, data += SHA256Portable::BlockSizeInBytes)
+            {
+                uint32_t w[64];
+                for (int i = 0; i < 16; ++i)
+                {
+                    w[i] = LoadBigEndian(data + 4 * i);
+                }
+
+                for (int i = 16; i < 64; ++i)
+                {
+                    uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                    uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+                }
+
+                uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+
+                for (int i = 0; i < 64; ++i)
+                {
+                    uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+                    uint32_t ch = (e & f) ^ (~e & g);
+                    uint32_t t1 = h + s1 + ch + s_RoundConstants[i] + w[i];
+                    uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+                    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+                    uint32_t t2 = s0 + maj;
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = d + t1;
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = t1 + t2;
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+                state[4] += e;
+                state[5] += f;
+                state[6] += g;
+                state[7] += h;
+            }
+        }
+
+#if defined(WINGET_SHA256_X86)
+        bool IsShaExtensionSupported()
+        {
+            int info[4]{};
+            __cpuid(info, 0);
+            if (info[0] < 7)
+            {
+                return false;
+            }
+
+            // SSSE3 and SSE4.1 are needed for the byte shuffle and blend around the SHA instructions.
+            __cpuid(info, 1);
+            bool ssse3 = (info[2] & (1 << 9)) != 0;
+            bool sse41 = (info[2] & (1 << 19)) != 0;
+
+            __cpuidex(info, 7, 0);
+            bool sha = (info[1] & (1 << 29)) != 0;
+
+            return ssse3 && sse41 && sha;
+        }
+
+        // The SHA-NI instructions operate on the state as { A, B, E, F } and { C, D, G, H }.
+        void TransformShaExtension(uint32_t* state, const uint8_t* data, size_t blockCount)
+        {
+            const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+            __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+            __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+            __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+            __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+            __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+            __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+            for (; blockCount > 0; --blockCount, data += SHA256Portable::BlockSizeInBytes)
+            {
+                __m128i abefSave = abef;
+                __m128i cdghSave = cdgh;
+
+                // Each message register holds four consecutive words of the schedule, reused in rotation.
+                __m128i message[4];
+                for (int i = 0; i < 4; ++i)
+                {
+                    message[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteSwap);
+                }
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    __m128i& current = message[i & 3];
+                    if (i >= 4)
+                    {
+                        current = _mm_sha256msg1_epu32(current, message[(i - 3) & 3]);
+                        current = _mm_add_epi32(current, _mm_alignr_epi8(message[(i - 1) & 3], message[(i - 2) & 3], 4));
+                        current = _mm_sha256msg2_epu32(current, message[(i - 1) & 3]);
+                    }
+
+                    __m128i roundInput = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(&s_RoundConstants[4 * i])));
+                    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, roundInput);
+                    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(roundInput, 0x0E));
+                }
+
+                abef = _mm_add_epi32(abef, abefSave);
+                cdgh = _mm_add_epi32(cdgh, cdghSave);
+            }
+
+            __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+            __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+        }
+#elif defined(WINGET_SHA256_ARM64)
+        bool IsShaExtensionSupported()
+        {
+            return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != FALSE;
+        }
+
+        void TransformShaExtension(uint32_t* state, const uint8_t* data, size_t blockCount)
+        {
+            uint32x4_t abcd = vld1q_u32(&state[0]);
+            uint32x4_t efgh = vld1q_u32(&state[4]);
+
+            for (; blockCount > 0; --blockCount, data += SHA256Portable::BlockSizeInBytes)
+            {
+                uint32x4_t abcdSave = abcd;
+                uint32x4_t efghSave = efgh;
+
+                // Each message register holds four consecutive words of the schedule, reused in rotation.
+                uint32x4_t message[4];
+                for (int i = 0; i < 4; ++i)
+                {
+                    message[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+                }
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    uint32x4_t& current = message[i & 3];
+                    if (i >= 4)
+                    {
+                        current = vsha256su0q_u32(current, message[(i - 3) & 3]);
+                        current = vsha256su1q_u32(current, message[(i - 2) & 3], message[(i - 1) & 3]);
+                    }
+
+                    uint32x4_t roundInput = vaddq_u32(current, vld1q_u32(&s_RoundConstants[4 * i]));
+                    uint32x4_t abcdPrevious = abcd;
+                    abcd = vsha256hq_u32(abcd, efgh, roundInput);
+                    efgh = vsha256h2q_u32(efgh, abcdPrevious, roundInput);
+                }
+
+                abcd = vaddq_u32(abcd, abcdSave);
+                efgh = vaddq_u32(efgh, efghSave);
+            }
+
+            vst1q_u32(&state[0], abcd);
+            vst1q_u32(&state[4], efgh);
+        }
+#else
+        bool IsShaExtensionSupported()
+        {
+            return false;
+        }
+
+        void TransformShaExtension(uint32_t* state, const uint8_t* data, size_t blockCount)
+        {
+            TransformScalar(state, data, blockCount);
+        }
+#endif
+
+        TransformFunction GetTransform()
+        {
+            static const TransformFunction s_transform = IsShaExtensionSupported() ? TransformShaExtension : TransformScalar;
+            return s_transform;
+        }
+    }
+
+    SHA256Portable::SHA256Portable()
+    {
+        std::copy(std::begin(s_InitialState), std::end(s_InitialState), m_state);
+    }
+
+    void SHA256Portable::Add(const uint8_t* buffer, size_t cbBuffer)
+    {
+        TransformFunction transform = GetTransform();
+        m_totalSize += cbBuffer;
+
+        // Complete a partial block left by the previous call first.
+        if (m_blockSize > 0)
+        {
+            size_t count = std::min(cbBuffer, BlockSizeInBytes - m_blockSize);
+            std::memcpy(m_block + m_blockSize, buffer, count);
+            m_blockSize += count;
+            buffer += count;
+            cbBuffer -= count;
+
+            if (m_blockSize < BlockSizeInBytes)
+            {
+                return;
+            }
+
+            transform(m_state, m_block, 1);
+            m_blockSize = 0;
+        }
+
+        // Whole blocks are processed directly from the input.
+        size_t blockCount = cbBuffer / BlockSizeInBytes;
+        if (blockCount > 0)
+        {
+            transform(m_state, buffer, blockCount);
+            buffer += blockCount * BlockSizeInBytes;
+            cbBuffer -= blockCount * BlockSizeInBytes;
+        }
+
+        if (cbBuffer > 0)
+        {
+            std::memcpy(m_block, buffer, cbBuffer);
+            m_blockSize = cbBuffer;
+        }
+    }
+
+    void SHA256Portable::Get(uint8_t* hash)
+    {
+        TransformFunction transform = GetTransform();
+        uint64_t totalBits = m_totalSize * 8;
+
+        // Pad with a single 1 bit, then zeros up to the final 8 bytes, which hold the length in bits.
+        m_block[m_blockSize++] = 0x80;
+        if (m_blockSize > BlockSizeInBytes - 8)
+        {
+            std::memset(m_block + m_blockSize, 0, BlockSizeInBytes - m_blockSize);
+            transform(m_state, m_block, 1);
+            m_blockSize = 0;
+        }
+
+        std::memset(m_block + m_blockSize, 0, BlockSizeInBytes - 8 - m_blockSize);
+        StoreBigEndian(m_block + BlockSizeInBytes - 8, static_cast<uint32_t>(totalBits >> 32));
+        StoreBigEndian(m_block + BlockSizeInBytes - 4, static_cast<uint32_t>(totalBits));
+        transform(m_state, m_block, 1);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            StoreBigEndian(hash + 4 * i, m_state[i]);
+        }
+    }
+
+    bool SHA256Portable::IsHardwareAccelerated()
+    {
+        return GetTransform() == TransformShaExtension;
+    }
+}
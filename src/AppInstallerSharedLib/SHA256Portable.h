@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace AppInstaller::Utility
+{
+    // A SHA256 implementation that does not depend on the OS crypto providers.
+    // It uses the processor's SHA extensions (SHA-NI on x86/x64, the ARMv8 crypto extensions on ARM64)
+    // when they are available, and a scalar implementation otherwise.
+    struct SHA256Portable
+    {
+        constexpr static size_t BlockSizeInBytes = 64;
+        constexpr static size_t HashSizeInBytes = 32;
+
+        SHA256Portable();
+
+        // Adds the next chunk of data to the hash.
+        void Add(const uint8_t* buffer, size_t cbBuffer);
+
+        // Finishes the hash; the object can no longer be used.
+        void Get(uint8_t* hash);
+
+        // Returns a value indicating whether the processor's SHA extensions are used.
+        static bool IsHardwareAccelerated();
+
+    private:
+        uint32_t m_state[8];
+        uint8_t m_block[BlockSizeInBytes];
+        size_t m_blockSize = 0;
+        uint64_t m_totalSize = 0;
+    };
+}
@@ -0,0 +1,363 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/winget/SQLiteProfiler.h"
+#include "Public/AppInstallerLogging.h"
+#include "Public/AppInstallerStrings.h"
+
+#include <stack>
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::SQLite
+{
+    namespace
+    {
+        constexpr std::string_view s_ExplainPrefix = "EXPLAIN";
+
+        bool IsIdentifierChar(char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+        }
+
+        // Temporary tables are named with a new GUID, which would make each use look like a different statement.
+        bool IsGuidName(std::string_view name)
+        {
+            return name.size() == 38 && name.front() == '{' && name.back() == '}';
+        }
+
+        double ToMilliseconds(std::chrono::nanoseconds time)
+        {
+            return std::chrono::duration<double, std::milli>(time).count();
+        }
+    }
+
+    Profiler& Profiler::Instance()
+    {
+        static Profiler s_instance;
+        return s_instance;
+    }
+
+    void Profiler::Enable(std::chrono::milliseconds slowStatementThreshold)
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_lock };
+            m_slowStatementThreshold = slowStatementThreshold;
+        }
+
+        m_enabled = true;
+    }
+
+    void Profiler::Attach(sqlite3* connection)
+    {
+        if (IsEnabled())
+        {
+            LOG_HR_IF(E_UNEXPECTED, sqlite3_trace_v2(connection, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW | SQLITE_TRACE_CLOSE, TraceCallback, this) != SQLITE_OK);
+        }
+    }
+
+    void Profiler::LogPendingQueryPlans(sqlite3* connection)
+    {
+        std::vector<std::string> pending;
+
+        {
+            std::lock_guard<std::mutex> lock{ m_lock };
+
+            auto itr = m_pendingQueryPlans.find(connection);
+            if (itr == m_pendingQueryPlans.end())
+            {
+                return;
+            }
+
+            pending = std::move(itr->second);
+            m_pendingQueryPlans.erase(itr);
+        }
+
+        for (const auto& sql : pending)
+        {
+            LogQueryPlan(connection, sql);
+        }
+    }
+
+    std::vector<Profiler::StatementStatistics> Profiler::GetStatistics() const
+    {
+        std::vector<StatementStatistics> result;
+
+        {
+            std::lock_guard<std::mutex> lock{ m_lock };
+
+            result.reserve(m_entries.size());
+            for (const auto& entry : m_entries)
+            {
+                result.emplace_back(entry.second.Statistics);
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](const StatementStatistics& a, const StatementStatistics& b) { return a.TotalTime > b.TotalTime; });
+        return result;
+    }
+
+    void Profiler::LogSummary(size_t maximumStatements) const
+    {
+        auto statistics = GetStatistics();
+        if (statistics.empty())
+        {
+            return;
+        }
+
+        size_t count = 0;
+        std::chrono::nanoseconds totalTime{};
+        for (const auto& statement : statistics)
+        {
+            count += statement.Count;
+            totalTime += statement.TotalTime;
+        }
+
+        AICLI_LOG(SQL, Info, << "SQL profile: " << statistics.size() << " distinct statements run " << count << " times in " <<
+            ToMilliseconds(totalTime) << " ms; the most expensive are:");
+
+        for (size_t i = 0; i < std::min(maximumStatements, statistics.size()); ++i)
+        {
+            const auto& statement = statistics[i];
+            AICLI_LOG(SQL, Info, << "  [total " << ToMilliseconds(statement.TotalTime) << " ms, max " << ToMilliseconds(statement.MaximumTime) << " ms, " <<
+                statement.Count << " runs, " << statement.Rows << " rows, " << statement.FullScanSteps << " full scan steps, " <<
+                statement.AutomaticIndexes << " automatic indexes, " << statement.Sorts << " sorts] " << statement.SQL);
+        }
+    }
+
+    std::string Profiler::NormalizeSQL(std::string_view sql)
+    {
+        std::string result;
+        result.reserve(sql.size());
+
+        size_t i = 0;
+        while (i < sql.size())
+        {
+            char c = sql[i];
+
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i])))
+                {
+                    ++i;
+                }
+
+                if (!result.empty())
+                {
+                    result += ' ';
+                }
+            }
+            else if (c == '\'')
+            {
+                // A string literal, in which a doubled quote is an escaped quote.
+                for (++i; i < sql.size(); ++i)
+                {
+                    if (sql[i] == '\'')
+                    {
+                        if (i + 1 < sql.size() && sql[i + 1] == '\'')
+                        {
+                            ++i;
+                        }
+                        else
+                        {
+                            ++i;
+                            break;
+                        }
+                    }
+                }
+
+                result += '?';
+            }
+            else if (c == '[' || c == '"' || c == '`')
+            {
+                // A quoted identifier, which is kept unless it is a generated name.
+                char close = (c == '[' ? ']' : c);
+                size_t end = std::min(sql.find(close, i + 1), sql.size());
+                std::string_view name = sql.substr(i + 1, end - i - 1);
+
+                result += c;
+                result += (IsGuidName(name) ? "{guid}"sv : name);
+                result += close;
+
+                i = end + 1;
+            }
+            else if (c == '?' || c == ':' || c == '@')
+            {
+                // A parameter, which is kept with its name or number.
+                size_t start = i++;
+                while (i < sql.size() && IsIdentifierChar(sql[i]))
+                {
+                    ++i;
+                }
+
+                result.append(sql.substr(start, i - start));
+            }
+            else if (IsIdentifierChar(c))
+            {
+                size_t start = i;
+                while (i < sql.size() && (IsIdentifierChar(sql[i]) || (std::isdigit(static_cast<unsigned char>(sql[start])) && sql[i] == '.')))
+                {
+                    ++i;
+                }
+
+                if (std::isdigit(static_cast<unsigned char>(sql[start])))
+                {
+                    // A numeric literal.
+                    result += '?';
+                }
+                else
+                {
+                    result.append(sql.substr(start, i - start));
+                }
+            }
+            else
+            {
+                result += c;
+                ++i;
+            }
+        }
+
+        if (!result.empty() && result.back() == ' ')
+        {
+            result.pop_back();
+        }
+
+        return result;
+    }
+
+    int Profiler::TraceCallback(unsigned int type, void* context, void* p, void* x)
+    {
+        try
+        {
+            Profiler* profiler = reinterpret_cast<Profiler*>(context);
+
+            if (type == SQLITE_TRACE_ROW)
+            {
+                profiler->OnRow(reinterpret_cast<sqlite3_stmt*>(p));
+            }
+            else if (type == SQLITE_TRACE_PROFILE)
+            {
+                profiler->OnProfile(reinterpret_cast<sqlite3_stmt*>(p), std::chrono::nanoseconds{ *reinterpret_cast<sqlite3_int64*>(x) });
+            }
+            else if (type == SQLITE_TRACE_CLOSE)
+            {
+                profiler->OnClose(reinterpret_cast<sqlite3*>(p));
+            }
+        }
+        CATCH_LOG();
+
+        return 0;
+    }
+
+    void Profiler::OnRow(sqlite3_stmt* statement)
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        ++m_rowsInProgress[sqlite3_db_handle(statement)][statement];
+    }
+
+    void Profiler::OnClose(sqlite3* connection)
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_rowsInProgress.erase(connection);
+        m_pendingQueryPlans.erase(connection);
+    }
+
+    void Profiler::OnProfile(sqlite3_stmt* statement, std::chrono::nanoseconds time)
+    {
+        std::string_view sql = sqlite3_sql(statement);
+
+        // The counters are reset so that the next run of the statement only reports its own work.
+        uint64_t fullScanSteps = static_cast<uint64_t>(sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1));
+        uint64_t automaticIndexes = static_cast<uint64_t>(sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_AUTOINDEX, 1));
+        uint64_t sorts = static_cast<uint64_t>(sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_SORT, 1));
+
+        bool isQueryPlan = Utility::CaseInsensitiveStartsWith(sql, s_ExplainPrefix);
+        std::string normalized = (isQueryPlan ? std::string{} : NormalizeSQL(sql));
+
+        std::lock_guard<std::mutex> lock{ m_lock };
+
+        uint64_t rows = 0;
+        auto connectionRowsItr = m_rowsInProgress.find(sqlite3_db_handle(statement));
+        if (connectionRowsItr != m_rowsInProgress.end())
+        {
+            auto& connectionRows = connectionRowsItr->second;
+            auto rowsItr = connectionRows.find(statement);
+            if (rowsItr != connectionRows.end())
+            {
+                rows = rowsItr->second;
+                connectionRows.erase(rowsItr);
+            }
+        }
+
+        // Do not count the query plans that the profiler itself runs.
+        if (isQueryPlan)
+        {
+            return;
+        }
+
+        Entry& entry = m_entries[normalized];
+        StatementStatistics& statistics = entry.Statistics;
+        if (statistics.SQL.empty())
+        {
+            statistics.SQL = std::move(normalized);
+        }
+
+        statistics.Count += 1;
+        statistics.TotalTime += time;
+        statistics.MaximumTime = std::max(statistics.MaximumTime, time);
+        statistics.Rows += rows;
+        statistics.FullScanSteps += fullScanSteps;
+        statistics.AutomaticIndexes += automaticIndexes;
+        statistics.Sorts += sorts;
+
+        if (time > m_slowStatementThreshold)
+        {
+            AICLI_LOG(SQL, Info, << "Slow statement [" << ToMilliseconds(time) << " ms, " << rows << " rows, " << fullScanSteps << " full scan steps]: " << sql);
+
+            if (!entry.QueryPlanLogged)
+            {
+                entry.QueryPlanLogged = true;
+                m_pendingQueryPlans[sqlite3_db_handle(statement)].emplace_back(sql);
+            }
+        }
+    }
+
+    void LogQueryPlan(sqlite3* connection, std::string_view sql)
+    {
+        std::string explainSQL{ s_ExplainPrefix };
+        explainSQL.append(" QUERY PLAN ");
+        explainSQL.append(sql);
+
+        wil::unique_any<sqlite3_stmt*, decltype(sqlite3_finalize), sqlite3_finalize> plan;
+        if (sqlite3_prepare_v2(connection, explainSQL.c_str(), static_cast<int>(explainSQL.size() + 1), &plan, nullptr) != SQLITE_OK)
+        {
+            AICLI_LOG(SQL, Info, << "Unable to get the query plan for: " << sql << " [" << sqlite3_errmsg(connection) << "]");
+            return;
+        }
+
+        bool outputHeader = true;
+        std::stack<int> parents;
+
+        while (sqlite3_step(plan.get()) == SQLITE_ROW)
+        {
+            if (outputHeader)
+            {
+                AICLI_LOG(SQL, Info, << "Query plan for: " << sql);
+                outputHeader = false;
+            }
+
+            int id = sqlite3_column_int(plan.get(), 0);
+            int parent = sqlite3_column_int(plan.get(), 1);
+            const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(plan.get(), 3));
+
+            while (!parents.empty() && parents.top() != parent)
+            {
+                parents.pop();
+            }
+
+            AICLI_LOG(SQL, Info, << "|-" << std::string(parents.size() * 2, '-') << ' ' << (detail ? detail : ""));
+
+            parents.push(id);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "Public/winget/SQLiteWrapper.h"
+#include "Public/winget/SQLiteProfiler.h"
 #include "Public/AppInstallerErrors.h"
 #include "Public/AppInstallerStrings.h"
 #include "ICU/SQLiteICU.h"
@@ -14,10 +15,6 @@ using namespace std::string_view_literals;
 // Enable this to have all Statement constructions output the associated query plan.
 #define WINGET_SQLITE_EXPLAIN_QUERY_PLAN_ENABLED 0
 
-#if WINGET_SQLITE_EXPLAIN_QUERY_PLAN_ENABLED
-#include <stack>
-#endif
-
 // Connection is used twice
 #define SQLITE_ERROR_MSG(_error_,_connection_) (_connection_ ? sqlite3_errmsg(_connection_) : sqlite3_errstr(_error_))
 
@@ -201,6 +198,7 @@ namespace AppInstaller::SQLite
         // Always force connection serialization until we determine that there are situations where it is not needed
         int resultingFlags = static_cast<int>(disposition) | static_cast<int>(flags) | SQLITE_OPEN_FULLMUTEX;
         THROW_IF_SQLITE_FAILED(sqlite3_open_v2(target.c_str(), m_dbconn->GetPtr(), resultingFlags, nullptr), nullptr);
+        Profiler::Instance().Attach(m_dbconn->Get());
     }
 
     Connection Connection::Create(const std::string& target, OpenDisposition disposition, OpenFlags flags)
@@ -278,39 +276,7 @@ namespace AppInstaller::SQLite
 
 #if WINGET_SQLITE_EXPLAIN_QUERY_PLAN_ENABLED
 #define WINGET_SQLITE_EXPLAIN_QUERY_PLAN(_connection_,_sql_) \
-    std::string _explainStatementSQL_ = "EXPLAIN QUERY PLAN "; \
-    _explainStatementSQL_.append(_sql_); \
-    try { \
-        Statement _explainStatement_(_connection_,_explainStatementSQL_); \
-        LogExplainQueryPlanResult(_sql_, _explainStatement_); \
-    } catch(...) {}
-
-    void LogExplainQueryPlanResult(std::string_view sql, Statement& plan)
-    {
-        bool outputHeader = true;
-        std::stack<int> parents;
-
-        while (plan.Step())
-        {
-            if (outputHeader)
-            {
-                AICLI_LOG(SQL, Info, << "Query plan for: " << sql);
-                outputHeader = false;
-            }
-
-            int id = plan.GetColumn<int>(0);
-            int parent = plan.GetColumn<int>(1);
-
-            while (!parents.empty() && parents.top() != parent)
-            {
-                parents.pop();
-            }
-
-            AICLI_LOG(SQL, Info, << "|-" << std::string(parents.size() * 2, '-') << ' ' << plan.GetColumn<std::string>(3));
-
-            parents.push(id);
-        }
-    }
+    try { LogQueryPlan(_connection_, _sql_); } catch(...) {}
 #else
 #define WINGET_SQLITE_EXPLAIN_QUERY_PLAN(_connection_,_sql_)
 #endif
@@ -343,12 +309,14 @@ namespace AppInstaller::SQLite
         {
             AICLI_LOG(SQL, Verbose, << "Statement #" << m_connectionId << '-' << m_id << " has data");
             m_state = State::HasRow;
+            LogPendingQueryPlans();
             return true;
         }
         else if (result == SQLITE_DONE)
         {
             AICLI_LOG(SQL, Verbose, << "Statement #" << m_connectionId << '-' << m_id << " has completed");
             m_state = State::Completed;
+            LogPendingQueryPlans();
             return false;
         }
         else
@@ -381,6 +349,16 @@ namespace AppInstaller::SQLite
         // Ignore return value from reset, as if it is an error, it was the error from the last call to step.
         sqlite3_reset(m_stmt.get());
         m_state = State::Prepared;
+        LogPendingQueryPlans();
+    }
+
+    void Statement::LogPendingQueryPlans()
+    {
+        // Running the query plans replaces the error of the connection, so this is only done after a successful step.
+        if (Profiler::Instance().IsEnabled())
+        {
+            Profiler::Instance().LogPendingQueryPlans(sqlite3_db_handle(m_stmt.get()));
+        }
     }
 
     Transaction::Transaction() : m_inProgress(false)
@@ -51,16 +51,17 @@ namespace AppInstaller::Utility
         m_version = std::move(Utility::Trim(version));
 
         // Process approximate comparator if applicable
-        std::string baseVersion = m_version;
+        // The base version and its parts are views into m_version, so that parsing only allocates the parts themselves.
+        std::string_view baseVersion = m_version;
         if (CaseInsensitiveStartsWith(m_version, s_Approximate_Less_Than))
         {
             m_approximateComparator = ApproximateComparator::LessThan;
-            baseVersion = m_version.substr(s_Approximate_Less_Than.length(), m_version.length() - s_Approximate_Less_Than.length());
+            baseVersion.remove_prefix(s_Approximate_Less_Than.length());
         }
         else if (CaseInsensitiveStartsWith(m_version, s_Approximate_Greater_Than))
         {
             m_approximateComparator = ApproximateComparator::GreaterThan;
-            baseVersion = m_version.substr(s_Approximate_Greater_Than.length(), m_version.length() - s_Approximate_Greater_Than.length());
+            baseVersion.remove_prefix(s_Approximate_Greater_Than.length());
         }
 
         // If there is a digit before the split character, or no split characters exist, trim off all leading non-digit characters
@@ -68,10 +69,12 @@ namespace AppInstaller::Utility
         size_t splitPos = baseVersion.find_first_of(splitChars);
         if (m_trimPrefix && digitPos != std::string::npos && (splitPos == std::string::npos || digitPos < splitPos))
         {
-            baseVersion.erase(0, digitPos);
+            baseVersion.remove_prefix(digitPos);
         }
 
         // Then parse the base version
+        m_parts.reserve(m_parts.size() + 1 + static_cast<size_t>(std::count_if(baseVersion.begin(), baseVersion.end(), [&](char c) { return splitChars.find(c) != std::string_view::npos; })));
+
         size_t pos = 0;
 
         while (pos < baseVersion.length())
@@ -101,9 +104,17 @@ namespace AppInstaller::Utility
             }
             else
             {
-                return;
+                break;
             }
         }
+
+        UpdateBaseVersionFlags();
+    }
+
+    void Version::UpdateBaseVersionFlags()
+    {
+        m_isBaseVersionLatest = (m_parts.size() == 1 && m_parts[0].Integer == 0 && Utility::CaseInsensitiveEquals(m_parts[0].Other, s_Version_Part_Latest));
+        m_isBaseVersionUnknown = (m_parts.size() == 1 && m_parts[0].Integer == 0 && Utility::CaseInsensitiveEquals(m_parts[0].Other, s_Version_Part_Unknown));
     }
 
     bool Version::operator<(const Version& other) const
@@ -137,7 +148,7 @@ namespace AppInstaller::Utility
             return (thisIsUnknown && !otherIsUnknown);
         }
 
-        const Part emptyPart{};
+        static const Part emptyPart{};
         for (size_t i = 0; i < std::max(m_parts.size(), other.m_parts.size()); ++i)
         {
             // Whichever version is shorter, we need to pad it with empty parts
@@ -218,6 +229,7 @@ namespace AppInstaller::Utility
         Version result;
         result.m_version = s_Version_Part_Latest;
         result.m_parts.emplace_back(0, std::string{ s_Version_Part_Latest });
+        result.UpdateBaseVersionFlags();
         return result;
     }
 
@@ -231,6 +243,7 @@ namespace AppInstaller::Utility
         Version result;
         result.m_version = s_Version_Part_Unknown;
         result.m_parts.emplace_back(0, std::string{ s_Version_Part_Unknown });
+        result.UpdateBaseVersionFlags();
         return result;
     }
 
@@ -266,12 +279,12 @@ namespace AppInstaller::Utility
     
     bool Version::IsBaseVersionLatest() const
     {
-        return (m_parts.size() == 1 && m_parts[0].Integer == 0 && Utility::CaseInsensitiveEquals(m_parts[0].Other, s_Version_Part_Latest));
+        return m_isBaseVersionLatest;
     }
 
     bool Version::IsBaseVersionUnknown() const
     {
-        return (m_parts.size() == 1 && m_parts[0].Integer == 0 && Utility::CaseInsensitiveEquals(m_parts[0].Other, s_Version_Part_Unknown));
+        return m_isBaseVersionUnknown;
     }
 
     bool Version::ApproximateCompareLessThan(const Version& other) const
@@ -281,22 +294,47 @@ namespace AppInstaller::Utility
             (m_approximateComparator == ApproximateComparator::None && other.m_approximateComparator == ApproximateComparator::GreaterThan);
     }
 
-    Version::Part::Part(const std::string& part)
+    Version::Part::Part(std::string_view part)
     {
-        std::string interimPart = Utility::Trim(part);
-        const char* begin = interimPart.c_str();
-        char* end = nullptr;
-        errno = 0;
-        Integer = strtoull(begin, &end, 10);
+        Utility::Trim(part);
+
+        // Parse the leading integer the same way as strtoull on a null terminated copy of the part,
+        // including the optional sign, without needing to make that copy.
+        size_t pos = 0;
+        bool negative = false;
+        if (pos < part.length() && (part[pos] == '+' || part[pos] == '-'))
+        {
+            negative = (part[pos] == '-');
+            ++pos;
+        }
 
-        if (errno == ERANGE)
+        size_t digitsStart = pos;
+        bool overflow = false;
+        uint64_t value = 0;
+        for (; pos < part.length() && part[pos] >= '0' && part[pos] <= '9'; ++pos)
+        {
+            uint64_t digit = static_cast<uint64_t>(part[pos] - '0');
+            if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+            {
+                overflow = true;
+            }
+            else
+            {
+                value = value * 10 + digit;
+            }
+        }
+
+        if (overflow)
         {
             Integer = 0;
-            Other = interimPart;
+            Other = part;
         }
-        else if (static_cast<size_t>(end - begin) != interimPart.length())
+        else
         {
-            Other = end;
+            // As with strtoull, the string value ends at an embedded null
+            std::string_view remaining = part.substr(pos == digitsStart ? 0 : pos);
+            Integer = (pos == digitsStart ? 0 : (negative ? 0 - value : value));
+            Other = remaining.substr(0, remaining.find('\0'));
         }
 
         m_foldedOther = Utility::FoldCase(static_cast<std::string_view>(Other));
@@ -507,6 +545,7 @@ namespace AppInstaller::Utility
                 m_parts.emplace_back();
             }
             m_parts[2].Other = version.substr(otherSplit);
+            UpdateBaseVersionFlags();
         }
 
         // Overwrite the whole version string with our whole version string
@@ -713,6 +752,7 @@ namespace AppInstaller::Utility
         {
             m_version = s_Version_Part_Unknown;
             m_parts.emplace_back(0, std::string{ s_Version_Part_Unknown });
+            UpdateBaseVersionFlags();
         }
     }
 }
@@ -62,7 +62,7 @@ namespace AppInstaller::YAML
             out << "[line " << mark.line << "; col " << mark.column << ']';
         }
 
-        Node::TagType ConvertToTagType(const std::string& tag)
+        Node::TagType ConvertToTagType(std::string_view tag)
         {
             if (tag == s_strTag)
             {
@@ -210,31 +210,69 @@ namespace AppInstaller::YAML
         return m_mark;
     }
 
-    Node::Node(Type type, std::string tag, const YAML::Mark& mark) :
-        m_type(type), m_tag(std::move(tag)), m_mark(mark)
+    NodeArena::NodeArena(size_t capacity) :
+        m_capacity(capacity)
     {
-        if (m_type == Type::Sequence)
+        if (m_capacity)
         {
-            m_sequence = decltype(m_sequence)::value_type{};
+            m_buffer = std::make_unique<char[]>(m_capacity);
         }
-        else if (m_type == Type::Mapping)
+    }
+
+    std::string_view NodeArena::Store(std::string_view value)
+    {
+        if (value.empty())
         {
-            m_mapping = decltype(m_mapping)::value_type{};
+            return {};
         }
 
-        m_tagType = ConvertToTagType(m_tag);
+        THROW_HR_IF(E_NOT_SUFFICIENT_BUFFER, value.size() > Available());
+
+        char* destination = m_buffer.get() + m_used;
+        std::memcpy(destination, value.data(), value.size());
+        m_used += value.size();
+
+        return { destination, value.size() };
     }
 
-    void Node::SetScalar(std::string value)
+    Node::Node(Type type, std::string_view tag, const YAML::Mark& mark) :
+        m_type(type), m_tagType(ConvertToTagType(tag)), m_mark(mark)
+    {
+    }
+
+    void Node::SetScalar(std::string_view value)
     {
         Require(Type::Scalar);
-        m_scalar = std::move(value);
+
+        if (value.empty())
+        {
+            m_arena.reset();
+            m_scalar = {};
+            return;
+        }
+
+        // Store before releasing the current arena, as the value may be a view into it.
+        auto arena = std::make_shared<NodeArena>(value.size());
+        m_scalar = arena->Store(value);
+        m_arena = std::move(arena);
     }
 
-    void Node::SetScalar(std::string value, bool isQuoted)
+    void Node::SetScalar(std::string_view value, bool isQuoted)
     {
         this->SetScalar(value);
+        InferScalarTagType(isQuoted);
+    }
+
+    void Node::SetScalar(std::string_view storedValue, bool isQuoted, const std::shared_ptr<NodeArena>& arena)
+    {
+        Require(Type::Scalar);
+        m_scalar = storedValue;
+        m_arena = arena;
+        InferScalarTagType(isQuoted);
+    }
 
+    void Node::InferScalarTagType(bool isQuoted)
+    {
         // For untagged scalar nodes, libyaml always assigns the generic string
         // tag. Here we just try our best and assume that if the value is unquoted
         // then is not necessarily a string.
@@ -266,79 +304,70 @@ namespace AppInstaller::YAML
         return this->m_scalar < other.m_scalar;
     }
 
-    Node& Node::operator[](std::string_view key)
+    Node& Node::InsertMappingPair(Node&& key, Node&& value)
     {
         Require(Type::Mapping);
-        auto itrs = m_mapping->equal_range(key);
+        key.Require(Type::Scalar);
 
-        if (itrs.first == itrs.second)
-        {
-            return s_globalInvalidNode;
-        }
+        // Insert after all equal keys to match the ordering that a multimap would produce.
+        auto position = std::upper_bound(m_mapping.begin(), m_mapping.end(), key.m_scalar,
+            [](std::string_view k, const std::pair<Node, Node>& pair) { return k < pair.first.m_scalar; });
 
-        Node& result = itrs.first->second;
+        return m_mapping.emplace(position, std::move(key), std::move(value))->second;
+    }
 
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, ++itrs.first != itrs.second);
+    std::pair<size_t, size_t> Node::EqualRange(std::string_view key) const
+    {
+        Require(Type::Mapping);
 
-        return result;
+        auto first = std::lower_bound(m_mapping.begin(), m_mapping.end(), key,
+            [](const std::pair<Node, Node>& pair, std::string_view k) { return pair.first.m_scalar < k; });
+        auto last = std::upper_bound(first, m_mapping.end(), key,
+            [](std::string_view k, const std::pair<Node, Node>& pair) { return k < pair.first.m_scalar; });
+
+        return { static_cast<size_t>(first - m_mapping.begin()), static_cast<size_t>(last - m_mapping.begin()) };
     }
 
-    const Node& Node::operator[](std::string_view key) const
+    Node& Node::operator[](std::string_view key)
     {
-        Require(Type::Mapping);
-        auto itrs = m_mapping->equal_range(key);
+        auto range = EqualRange(key);
 
-        if (itrs.first == itrs.second)
+        if (range.first == range.second)
         {
             return s_globalInvalidNode;
         }
 
-        const Node& result = itrs.first->second;
-
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, ++itrs.first != itrs.second);
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, range.first + 1 != range.second);
 
-        return result;
+        return m_mapping[range.first].second;
     }
 
-    // Gets a child node from the mapping by its name.
-    Node& Node::GetChildNode(std::string_view key)
+    const Node& Node::operator[](std::string_view key) const
     {
-        Require(Type::Mapping);
+        auto range = EqualRange(key);
 
-        auto itr = m_mapping->begin();
-        for (; itr != m_mapping->end(); itr++)
-        {
-            if (Utility::CaseInsensitiveEquals(itr->first.m_scalar, key))
-            {
-                break;
-            }
-        }
-
-        if (itr == m_mapping->end())
+        if (range.first == range.second)
         {
             return s_globalInvalidNode;
         }
 
-        auto firstFound = itr;
-        for (++itr; itr != m_mapping->end(); itr++)
-        {
-            if (Utility::CaseInsensitiveEquals(itr->first.m_scalar, key))
-            {
-                break;
-            }
-        }
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, range.first + 1 != range.second);
 
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, itr != m_mapping->end());
-        Node& result = firstFound->second;
-        return result;
+        return m_mapping[range.first].second;
+    }
+
+    // Gets a child node from the mapping by its name.
+    Node& Node::GetChildNode(std::string_view key)
+    {
+        return const_cast<Node&>(static_cast<const Node*>(this)->GetChildNode(key));
     }
 
     const Node& Node::GetChildNode(std::string_view key) const
     {
         Require(Type::Mapping);
 
-        auto itr = m_mapping->begin();
-        for (; itr != m_mapping->end(); itr++)
+        auto itr = m_mapping.begin();
+        for (; itr != m_mapping.end(); itr++)
         {
             if (Utility::CaseInsensitiveEquals(itr->first.m_scalar, key))
             {
@@ -346,13 +375,13 @@ namespace AppInstaller::YAML
             }
         }
 
-        if (itr == m_mapping->end())
+        if (itr == m_mapping.end())
         {
             return s_globalInvalidNode;
         }
 
         auto firstFound = itr;
-        for (++itr; itr != m_mapping->end(); itr++)
+        for (++itr; itr != m_mapping.end(); itr++)
         {
             if (Utility::CaseInsensitiveEquals(itr->first.m_scalar, key))
             {
@@ -360,7 +389,7 @@ namespace AppInstaller::YAML
             }
         }
 
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, itr != m_mapping->end());
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, itr != m_mapping.end());
         const Node& result = firstFound->second;
         return result;
     }
@@ -368,13 +397,13 @@ namespace AppInstaller::YAML
     Node& Node::operator[](size_t index)
     {
         Require(Type::Sequence);
-        return m_sequence.value()[index];
+        return m_sequence[index];
     }
 
     const Node& Node::operator[](size_t index) const
     {
         Require(Type::Sequence);
-        return m_sequence.value()[index];
+        return m_sequence[index];
     }
 
     size_t Node::size() const
@@ -386,9 +415,9 @@ namespace AppInstaller::YAML
         case Type::Scalar:
             return 0;
         case Type::Sequence:
-            return m_sequence->size();
+            return m_sequence.size();
         case Type::Mapping:
-            return m_mapping->size();
+            return m_mapping.size();
         }
 
         THROW_HR(E_UNEXPECTED);
@@ -397,13 +426,13 @@ namespace AppInstaller::YAML
     const std::vector<Node>& Node::Sequence() const
     {
         Require(Type::Sequence);
-        return m_sequence.value();
+        return m_sequence;
     }
 
-    const std::multimap<Node, Node>& Node::Mapping() const
+    const Node::MappingStorage& Node::Mapping() const
     {
         Require(Type::Mapping);
-        return m_mapping.value();
+        return m_mapping;
     }
 
     void Node::Require(Type type) const
@@ -413,12 +442,12 @@ namespace AppInstaller::YAML
 
     std::string Node::as_dispatch(std::string*) const
     {
-        return m_scalar;
+        return std::string{ m_scalar };
     }
 
     std::optional<std::string> Node::try_as_dispatch(std::string*) const
     {
-        return std::optional{ m_scalar };
+        return std::optional{ std::string{ m_scalar } };
     }
 
     std::wstring Node::as_dispatch(std::wstring*) const
@@ -433,7 +462,7 @@ namespace AppInstaller::YAML
 
     int64_t Node::as_dispatch(int64_t*) const
     {
-        return std::stoll(m_scalar);
+        return std::stoll(std::string{ m_scalar });
     }
 
     std::optional<int64_t> Node::try_as_dispatch(int64_t*) const
@@ -443,12 +472,14 @@ namespace AppInstaller::YAML
             return {};
         }
 
-        const char* begin = m_scalar.c_str();
+        // The scalar is a view and not null terminated, so copy it first.
+        std::string scalar{ m_scalar };
+        const char* begin = scalar.c_str();
         char* end = nullptr;
         errno = 0;
         int64_t result = static_cast<int64_t>(strtoll(begin, &end, 0));
 
-        if (errno == ERANGE || static_cast<size_t>(end - begin) != m_scalar.length())
+        if (errno == ERANGE || static_cast<size_t>(end - begin) != scalar.length())
         {
             return {};
         }
@@ -459,14 +490,14 @@ namespace AppInstaller::YAML
     int Node::as_dispatch(int*) const
     {
         // To allow HResult representation
-        return static_cast<int>(std::stoll(m_scalar, 0, 0));
+        return static_cast<int>(std::stoll(std::string{ m_scalar }, 0, 0));
     }
 
     std::optional<int> Node::try_as_dispatch(int*) const
     {
         try
         {
-            return std::optional{ static_cast<int>(std::stoll(m_scalar, 0, 0)) };
+            return std::optional{ static_cast<int>(std::stoll(std::string{ m_scalar }, 0, 0)) };
         }
         catch (...)
         {
@@ -519,14 +550,14 @@ namespace AppInstaller::YAML
         };
 
         std::map<std::string, Node> newSequenceMap;
-        for (Node& node : m_sequence.value())
+        for (Node& node : m_sequence)
         {
             node.Require(Type::Mapping);
             auto keyValue = getKeyValue(node);
             newSequenceMap.emplace(std::move(keyValue), std::move(node));
         }
 
-        for (Node& node : other.m_sequence.value())
+        for (Node& node : other.m_sequence)
         {
             node.Require(Type::Mapping);
             auto keyValue = getKeyValue(node);
@@ -540,11 +571,11 @@ namespace AppInstaller::YAML
             }
         }
 
-        m_sequence.reset();
         std::vector<Node> newSequence;
-        for (const auto& keyValuePair : newSequenceMap)
+        newSequence.reserve(newSequenceMap.size());
+        for (auto& keyValuePair : newSequenceMap)
         {
-            newSequence.push_back(keyValuePair.second);
+            newSequence.emplace_back(std::move(keyValuePair.second));
         }
 
         m_sequence = std::move(newSequence);
@@ -555,27 +586,31 @@ namespace AppInstaller::YAML
         Require(Type::Mapping);
         other.Require(Type::Mapping);
 
-        std::multimap<Node, Node> uniques;
-        for (auto& keyValuePair : other.m_mapping.value())
+        MappingStorage uniques;
+        for (auto& keyValuePair : other.m_mapping)
         {
             if (caseInsensitive)
             {
-                auto node = GetChildNode(keyValuePair.first.as<std::string>());
+                auto node = GetChildNode(keyValuePair.first.m_scalar);
                 if (node.IsNull())
                 {
-                    uniques.emplace(std::move(keyValuePair));
+                    uniques.emplace_back(std::move(keyValuePair));
                 }
             }
             else
             {
-                if (m_mapping->count(keyValuePair.first) == 0)
+                auto range = EqualRange(keyValuePair.first.m_scalar);
+                if (range.first == range.second)
                 {
-                    uniques.emplace(std::move(keyValuePair));
+                    uniques.emplace_back(std::move(keyValuePair));
                 }
             }
         }
 
-        m_mapping->merge(uniques);
+        for (auto& keyValuePair : uniques)
+        {
+            InsertMappingPair(std::move(keyValuePair.first), std::move(keyValuePair.second));
+        }
     }
 
     Node Load(std::string_view input)
@@ -58,10 +58,16 @@ namespace AppInstaller::YAML::Wrapper
             return { mark.line + 1, mark.column + 1 };
         }
 
-        std::string ConvertYamlString(yaml_char_t* string, const yaml_mark_t& mark, size_t length = std::string::npos)
+        // The returned view is only valid for the lifetime of the document.
+        std::string_view ConvertYamlString(yaml_char_t* string, const yaml_mark_t& mark, size_t length = std::string::npos)
         {
             std::string_view resultView;
 
+            if (!string)
+            {
+                return resultView;
+            }
+
             if (length == std::string::npos)
             {
                 resultView = { reinterpret_cast<char*>(string) };
@@ -77,10 +83,10 @@ namespace AppInstaller::YAML::Wrapper
                 THROW_EXCEPTION(Exception(Exception::Type::Policy, "unsupported control character", ConvertMark(mark)));
             }
 
-            return std::string{ resultView };
+            return resultView;
         }
 
-        std::string ConvertScalarToString(yaml_node_t* node, const yaml_mark_t& mark)
+        std::string_view ConvertScalarToString(yaml_node_t* node, const yaml_mark_t& mark)
         {
             return ConvertYamlString(node->data.scalar.value, mark, node->data.scalar.length);
         }
@@ -139,6 +145,31 @@ namespace AppInstaller::YAML::Wrapper
             return {};
         }
 
+        // Size a single arena to hold every scalar in the document, so that building the tree
+        // performs one string allocation rather than one per scalar.
+        size_t scalarBytes = 0;
+        for (yaml_node_t* node = m_document.nodes.start; node < m_document.nodes.top; ++node)
+        {
+            if (node->type == YAML_SCALAR_NODE)
+            {
+                scalarBytes += node->data.scalar.length;
+            }
+        }
+
+        auto arena = std::make_shared<NodeArena>(scalarBytes);
+
+        // Store each scalar once; an aliased node is referenced from several places in the tree, which share the stored value.
+        std::vector<std::string_view> scalars(static_cast<size_t>(m_document.nodes.top - m_document.nodes.start));
+        for (yaml_node_t* node = m_document.nodes.start; node < m_document.nodes.top; ++node)
+        {
+            if (node->type == YAML_SCALAR_NODE)
+            {
+                scalars[node - m_document.nodes.start] = arena->Store(ConvertScalarToString(node, node->start_mark));
+            }
+        }
+
+        auto getScalar = [&](yaml_node_t* node) { return scalars[node - m_document.nodes.start]; };
+
         Node result(ConvertNodeType(root->type), ConvertYamlString(root->tag, root->start_mark), ConvertMark(root->start_mark));
 
         struct StackItem
@@ -169,9 +200,10 @@ namespace AppInstaller::YAML::Wrapper
                 break;
             case YAML_SCALAR_NODE:
                 stackItem.node->SetScalar(
-                    ConvertScalarToString(stackItem.yamlNode, stackItem.yamlNode->start_mark),
+                    getScalar(stackItem.yamlNode),
                     stackItem.yamlNode->data.scalar.style == YAML_SINGLE_QUOTED_SCALAR_STYLE ||
-                    stackItem.yamlNode->data.scalar.style == YAML_DOUBLE_QUOTED_SCALAR_STYLE);
+                    stackItem.yamlNode->data.scalar.style == YAML_DOUBLE_QUOTED_SCALAR_STYLE,
+                    arena);
                 pop = true;
                 break;
             case YAML_SEQUENCE_NODE:
@@ -212,7 +244,7 @@ namespace AppInstaller::YAML::Wrapper
                     THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INVALID_MAPPING_KEY, keyYamlNode->type != YAML_SCALAR_NODE);
 
                     Node keyNode(ConvertNodeType(keyYamlNode->type), ConvertYamlString(keyYamlNode->tag, keyYamlNode->start_mark), ConvertMark(keyYamlNode->start_mark));
-                    keyNode.SetScalar(ConvertScalarToString(keyYamlNode, keyYamlNode->start_mark));
+                    keyNode.SetScalar(getScalar(keyYamlNode), true, arena);
 
                     yaml_node_t* valueYamlNode = GetNode(child->value);
 
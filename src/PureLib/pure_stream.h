@@ -0,0 +1,715 @@
+// pure_stream.h - WinGet extension to pure.h:
+//
+// pure_zip() inflates each entry into a buffer the size of its declared
+// uncompressed size, only to compute its CRC32. pure_zip_stream() performs the
+// same checks but inflates entries through a fixed size chunk, updating the
+// CRC32 as it goes, so that memory use does not depend on the entry sizes.
+//
+// The outermost archive is first indexed, checking its structure, so that the
+// data of its entries may then be verified concurrently with
+// pure_zip_stream_verify() before pure_zip_stream_meta() replays the checks in
+// order. pure_zip_stream() does all of this on the calling thread.
+//
+// The pure directory is an unmodified subtree, so this lives beside it.
+
+#ifndef PURE_STREAM_H
+#define PURE_STREAM_H
+
+#include "pure/pure.h"
+
+const uint64_t PURE_STREAM_CHUNK = 262144;
+// The largest slice of input handed to zlib at once, since avail_in is 32-bit:
+const uint64_t PURE_STREAM_INPUT_MAX = 1073741824;
+// Returned when a sink stops the stream, beyond the range of pure's own errors:
+const int PURE_STREAM_E_SINK = PURE_E_ENUM_LENGTH;
+
+// Receives the uncompressed data of an entry in order, as it is verified.
+// The data is only known to be valid once the CRC32 has been checked.
+// Returning non-zero stops the stream with PURE_STREAM_E_SINK.
+typedef int (*pure_zip_stream_sink)(
+  void* context,
+  const uint8_t* data,
+  const uint64_t size
+);
+
+const char* pure_stream_error_code(const int error) {
+  if (error == PURE_STREAM_E_SINK) return "PURE_STREAM_E_SINK";
+  return pure_error_code(error);
+}
+
+// Inflates a raw deflate stream through the chunk, computing the CRC32 of the
+// uncompressed data. The error codes match those of pure_zip_inflate_raw().
+//
+// If nested is given and the uncompressed data starts with a PK signature,
+// *nested is set and this returns early without a checksum, since the caller
+// must then buffer the entry to descend into it.
+//
+// If sink is given, each chunk of uncompressed data is passed to it.
+int pure_zip_stream_inflate_raw(
+  const uint8_t* compressed,
+  const uint64_t compressed_size,
+  const uint64_t uncompressed_size,
+  uint8_t* chunk,
+  const uint64_t chunk_size,
+  uint64_t* checksum,
+  uint8_t* nested,
+  pure_zip_stream_sink sink,
+  void* sink_context
+) {
+  assert(uncompressed_size > 0);
+  assert(chunk_size > PURE_L_ZIP_PK);
+  assert(chunk_size <= UINT32_MAX);
+  assert(nested == NULL || *nested == 0);
+  z_stream z;
+  z.zalloc = Z_NULL;
+  z.zfree = Z_NULL;
+  z.opaque = Z_NULL;
+  z.avail_in = 0;
+  z.avail_out = 0;
+  z.next_in = Z_NULL;
+  z.next_out = Z_NULL;
+  // We indicate raw inflate to zlib by setting window_bits to negative:
+  // We further allow for the greatest possible compression window size (15).
+  int window_bits = -15;
+  {
+    int error = inflateInit2(&z, window_bits);
+    if (error != Z_OK) return PURE_E_ZIP_INFLATE;
+  }
+  unsigned long crc = crc32_z(0UL, Z_NULL, 0);
+  uint8_t head[2];
+  uint64_t head_size = 0;
+  uint8_t head_checked = 0;
+  uint64_t input_offset = 0;
+  uint64_t output_size = 0;
+  int result = 0;
+  while (1) {
+    if (z.avail_in == 0 && input_offset < compressed_size) {
+      uint64_t slice = compressed_size - input_offset;
+      if (slice > PURE_STREAM_INPUT_MAX) slice = PURE_STREAM_INPUT_MAX;
+      z.next_in = (uint8_t*) (compressed + input_offset);
+      z.avail_in = (unsigned int) slice;
+      input_offset += slice;
+    }
+    // We offer one byte more than remains to be declared, so that any output
+    // beyond the uncompressed size is seen rather than left inside zlib:
+    uint64_t remaining = uncompressed_size - output_size;
+    uint64_t available = chunk_size;
+    if (available > remaining + 1) available = remaining + 1;
+    z.next_out = chunk;
+    z.avail_out = (unsigned int) available;
+    int error = inflate(&z, Z_NO_FLUSH);
+    const uint64_t produced = available - z.avail_out;
+    if (produced > remaining) {
+      result = PURE_E_ZIP_BOMB_INFLATE_UNCOMPRESSED_OVERFLOW;
+      break;
+    }
+    for (uint64_t index = 0; index < produced && head_size < PURE_L_ZIP_PK; index++) {
+      head[head_size++] = chunk[index];
+    }
+    output_size += produced;
+    if (nested != NULL && !head_checked && head_size == PURE_L_ZIP_PK) {
+      head_checked = 1;
+      if (pure_eq(head, head_size, 0, PURE_S_ZIP_PK, PURE_L_ZIP_PK)) {
+        *nested = 1;
+        break;
+      }
+    }
+    crc = crc32_z(crc, chunk, (size_t) produced);
+    if (sink != NULL && produced > 0 && sink(sink_context, chunk, produced)) {
+      result = PURE_STREAM_E_SINK;
+      break;
+    }
+    if (error == Z_STREAM_END) {
+      if (z.avail_in > 0 || input_offset < compressed_size) {
+        result = PURE_E_ZIP_INFLATE_COMPRESSED_UNDERFLOW;
+      } else if (output_size < uncompressed_size) {
+        result = PURE_E_ZIP_INFLATE_UNCOMPRESSED_UNDERFLOW;
+      }
+      break;
+    }
+    if (error == Z_BUF_ERROR) {
+      // No progress was possible: all of the input has been consumed without
+      // the stream ending, since output space is always available.
+      assert(z.avail_in == 0);
+      result = PURE_E_ZIP_BOMB_INFLATE_COMPRESSED_OVERFLOW;
+      break;
+    }
+    if (error != Z_OK) {
+      if (error == Z_NEED_DICT) {
+        result = PURE_E_ZIP_INFLATE_DICTIONARY;
+      } else if (error == Z_STREAM_ERROR) {
+        result = PURE_E_ZIP_INFLATE_STREAM;
+      } else if (error == Z_DATA_ERROR) {
+        result = PURE_E_ZIP_INFLATE_DATA;
+      } else if (error == Z_MEM_ERROR) {
+        result = PURE_E_ZIP_INFLATE_MEMORY;
+      } else {
+        result = PURE_E_ZIP_INFLATE;
+      }
+      break;
+    }
+  }
+  (void) inflateEnd(&z);
+  *checksum = crc;
+  return result;
+}
+
+// Computes the CRC32 of a stored entry in slices, checking for a PK signature
+// and passing the data to the sink the same way as pure_zip_stream_inflate_raw().
+int pure_zip_stream_stored(
+  const uint8_t* raw,
+  const uint64_t size,
+  uint64_t* checksum,
+  uint8_t* nested,
+  pure_zip_stream_sink sink,
+  void* sink_context
+) {
+  assert(nested == NULL || *nested == 0);
+  if (nested != NULL && pure_eq(raw, size, 0, PURE_S_ZIP_PK, PURE_L_ZIP_PK)) {
+    *nested = 1;
+    return 0;
+  }
+  unsigned long crc = crc32_z(0UL, Z_NULL, 0);
+  uint64_t offset = 0;
+  while (offset < size) {
+    uint64_t slice = size - offset;
+    if (slice > PURE_STREAM_INPUT_MAX) slice = PURE_STREAM_INPUT_MAX;
+    crc = crc32_z(crc, raw + offset, (size_t) slice);
+    if (sink != NULL && sink(sink_context, raw + offset, slice)) {
+      return PURE_STREAM_E_SINK;
+    }
+    offset += slice;
+  }
+  *checksum = crc;
+  return 0;
+}
+
+// An entry of the outermost archive, whose headers have been checked and whose
+// data may be verified independently of the other entries.
+typedef struct pure_zip_stream_entry {
+  pure_zip_cdh cdh;
+  pure_zip_lfh lfh;
+  // Set if the compression ratio, counting this and the preceding entries of
+  // the outermost archive, is dangerous. The data is then unlikely to be needed.
+  uint8_t ratio;
+  // Set once pure_zip_stream_verify() has recorded the fields below:
+  uint8_t verified;
+  uint8_t nested;
+  int error;
+  uint64_t checksum;
+} pure_zip_stream_entry;
+
+// The entries of the outermost archive, in central directory order.
+typedef struct pure_zip_stream_index {
+  pure_zip_stream_entry* entries;
+  uint64_t entries_size; // Size of the allocation in bytes.
+  // The number of entries whose data pure_zip_meta() would reach before error:
+  uint64_t count;
+  // The first error in the structure of the archive, if any:
+  int error;
+} pure_zip_stream_index;
+
+// Verifies the data of an entry in isolation, without any shared state, so that
+// entries may be verified concurrently each with their own chunk.
+void pure_zip_stream_verify(
+  const uint8_t* buffer,
+  pure_zip_stream_entry* entry,
+  uint8_t* chunk,
+  const uint64_t chunk_size
+) {
+  const pure_zip_cdh* cdh = &entry->cdh;
+  entry->nested = 0;
+  entry->error = 0;
+  entry->checksum = 0;
+  // Directories and empty files need no buffer, so there is nothing to stream:
+  if (!cdh->directory && cdh->uncompressed_size > 0) {
+    assert(cdh->compressed_size > 0);
+    const uint8_t* raw = buffer + cdh->relative_offset + entry->lfh.length;
+    if (cdh->compression_method == PURE_ZIP_COMPRESSION_METHOD_DEFLATE) {
+      entry->error = pure_zip_stream_inflate_raw(
+        raw,                    // compressed
+        cdh->compressed_size,   // compressed_size
+        cdh->uncompressed_size, // uncompressed_size
+        chunk,                  // chunk
+        chunk_size,             // chunk_size
+        &entry->checksum,       // checksum
+        &entry->nested,         // nested
+        NULL,                   // sink
+        NULL                    // sink_context
+      );
+    } else {
+      assert(cdh->compression_method == PURE_ZIP_COMPRESSION_METHOD_NONE);
+      entry->error = pure_zip_stream_stored(
+        raw,
+        cdh->uncompressed_size,
+        &entry->checksum,
+        &entry->nested,
+        NULL,
+        NULL
+      );
+    }
+  }
+  entry->verified = 1;
+}
+
+// Passes the data of an entry to the sink, verifying its size and CRC32 as
+// pure_zip_stream_verify() does, but without regard to whether it is itself an
+// archive. Like pure_zip_stream_verify(), this shares no state between entries.
+int pure_zip_stream_extract(
+  const uint8_t* buffer,
+  const pure_zip_stream_entry* entry,
+  uint8_t* chunk,
+  const uint64_t chunk_size,
+  pure_zip_stream_sink sink,
+  void* sink_context
+) {
+  const pure_zip_cdh* cdh = &entry->cdh;
+  const uint8_t* raw = buffer + cdh->relative_offset + entry->lfh.length;
+  if (cdh->directory) return 0;
+  // An empty file must have no data, other than an empty deflate block:
+  if (cdh->uncompressed_size == 0) {
+    if (cdh->compressed_size == 0) return 0;
+    if (
+      cdh->compressed_size == 2 &&
+      cdh->compression_method == PURE_ZIP_COMPRESSION_METHOD_DEFLATE &&
+      raw[0] == 3 &&
+      raw[1] == 0
+    ) {
+      return 0;
+    }
+    return PURE_E_ZIP_AD_NIHILO;
+  }
+  assert(cdh->compressed_size > 0);
+  uint64_t checksum = 0;
+  if (cdh->compression_method == PURE_ZIP_COMPRESSION_METHOD_DEFLATE) {
+    int error = pure_zip_stream_inflate_raw(
+      raw,                    // compressed
+      cdh->compressed_size,   // compressed_size
+      cdh->uncompressed_size, // uncompressed_size
+      chunk,                  // chunk
+      chunk_size,             // chunk_size
+      &checksum,              // checksum
+      NULL,                   // nested
+      sink,                   // sink
+      sink_context            // sink_context
+    );
+    if (error) return error;
+  } else {
+    assert(cdh->compression_method == PURE_ZIP_COMPRESSION_METHOD_NONE);
+    int error = pure_zip_stream_stored(
+      raw,
+      cdh->uncompressed_size,
+      &checksum,
+      NULL,
+      sink,
+      sink_context
+    );
+    if (error) return error;
+  }
+  if (checksum != cdh->crc32) return PURE_E_ZIP_CRC32;
+  return 0;
+}
+
+// Equivalent to pure_zip_data(), except that entries which are not themselves
+// archives are verified through the chunk, unless already verified. Archives
+// are passed on to pure_zip_data(), which buffers them to descend into them.
+int pure_zip_stream_data(
+  pure_ctx* ctx,
+  const uint8_t* buffer,
+  pure_zip_stream_entry* entry,
+  uint8_t* chunk,
+  const uint64_t chunk_size,
+  uint8_t** data,
+  uint64_t* data_size
+) {
+  const pure_zip_cdh* cdh = &entry->cdh;
+  const pure_zip_lfh* lfh = &entry->lfh;
+  if (cdh->directory || cdh->uncompressed_size == 0) {
+    return pure_zip_data(ctx, buffer, cdh, lfh, data, data_size);
+  }
+  // We verify the compression ratio before inflating, as pure_zip_data() does,
+  // but only commit the totals once we know the entry is not an archive:
+  if (
+    pure_overflow(ctx->compressed_size, cdh->compressed_size, UINT64_MAX) ||
+    pure_overflow(ctx->uncompressed_size, cdh->uncompressed_size, UINT64_MAX)
+  ) {
+    return PURE_E_UINT64_OVERFLOW;
+  }
+  const uint64_t compressed_size = ctx->compressed_size + cdh->compressed_size;
+  const uint64_t uncompressed_size = ctx->uncompressed_size + cdh->uncompressed_size;
+  {
+    int error = pure_zip_verify_compression_ratio(
+      compressed_size,
+      uncompressed_size
+    );
+    if (error) return error;
+  }
+  if (!entry->verified) {
+    pure_zip_stream_verify(buffer, entry, chunk, chunk_size);
+  }
+  if (entry->error) return entry->error;
+  if (entry->nested) {
+    return pure_zip_data(ctx, buffer, cdh, lfh, data, data_size);
+  }
+  if (entry->checksum != cdh->crc32) return PURE_E_ZIP_CRC32;
+  ctx->compressed_size = compressed_size;
+  ctx->uncompressed_size = uncompressed_size;
+  if ((++ctx->files) > PURE_FILES_MAX) return PURE_E_ZIP_BOMB_FILES;
+  return 0;
+}
+
+// Checks the structure of the outermost archive as pure_zip_meta() does, but
+// collects the entries instead of descending into their data.
+//
+// pure_zip_meta() descends into each entry only after decoding the next, so
+// index->count records how many entries it would have descended into before
+// reaching index->error. Descending into those entries in order, and then
+// returning index->error, gives the same result as pure_zip_meta().
+//
+// Since no entry is ever held in memory as a whole, the outermost archive may
+// exceed 4 GB using ZIP64. Nested archives are buffered and still limited.
+//
+// Returns an error only if the index could not be allocated.
+int pure_zip_stream_index_entries(
+  pure_ctx* ctx,
+  const uint8_t* buffer,
+  const uint64_t size,
+  pure_zip_stream_index* index
+) {
+  index->count = 0;
+  index->error = 0;
+
+  // Update and check context against limits:
+  if ((++ctx->depth) > PURE_DEPTH_MAX) {
+    index->error = PURE_E_ZIP_BOMB_DEPTH;
+    return 0;
+  }
+  if ((++ctx->files) > PURE_FILES_MAX) {
+    index->error = PURE_E_ZIP_BOMB_FILES;
+    return 0;
+  }
+  if ((++ctx->archives) > PURE_ARCHIVES_MAX) {
+    index->error = PURE_E_ZIP_BOMB_ARCHIVES;
+    return 0;
+  }
+  if (pure_overflow(ctx->size, size, UINT64_MAX)) {
+    index->error = PURE_E_UINT64_OVERFLOW;
+    return 0;
+  }
+  if ((ctx->size += size) > PURE_SIZE_MAX) {
+    index->error = PURE_E_SIZE_MAX;
+    return 0;
+  }
+
+  // A zip file must contain at least an end of central directory record:
+  if (size < PURE_ZIP_EOCDR_MIN) {
+    index->error = PURE_E_ZIP_TOO_SMALL;
+    return 0;
+  }
+
+  // Malicious archive signatures (almost certainly when masquerading as a ZIP):
+  if (pure_eq(buffer, size, 0, PURE_S_RAR, PURE_L_RAR)) {
+    index->error = PURE_E_ZIP_RAR;
+    return 0;
+  }
+  if (pure_eq(buffer, size, 0, PURE_S_TAR, PURE_L_TAR)) {
+    index->error = PURE_E_ZIP_TAR;
+    return 0;
+  }
+  if (pure_eq(buffer, size, 0, PURE_S_XAR, PURE_L_XAR)) {
+    index->error = PURE_E_ZIP_XAR;
+    return 0;
+  }
+
+  // Locate and decode end of central directory record:
+  uint64_t eocdr_offset = 0;
+  pure_zip_eocdr eocdr;
+  {
+    int error = pure_zip_locate_eocdr(buffer, size, &eocdr_offset);
+    if (error) {
+      index->error = error;
+      return 0;
+    }
+  }
+  {
+    int error = pure_zip_decode_eocdr(buffer, size, eocdr_offset, &eocdr);
+    if (error) {
+      index->error = error;
+      return 0;
+    }
+  }
+
+  // Locate the offset of the first local file header:
+  uint64_t lfh_offset = 0;
+  {
+    int error = pure_zip_locate_first_lfh(buffer, size, &eocdr, &lfh_offset);
+    if (error) {
+      index->error = error;
+      return 0;
+    }
+    assert(lfh_offset == 0 || lfh_offset == PURE_L_ZIP_SPAN);
+  }
+
+  // Allocate the index, bounded by the number of headers that can fit:
+  uint64_t capacity = eocdr.cd_records;
+  if (capacity > size / PURE_ZIP_CDH_MIN + 1) {
+    capacity = size / PURE_ZIP_CDH_MIN + 1;
+  }
+  if (capacity > 0) {
+    if (capacity > SIZE_MAX / sizeof(pure_zip_stream_entry)) return PURE_E_MALLOC;
+    int error = pure_realloc(
+      (uint8_t**) &index->entries,
+      &index->entries_size,
+      capacity * sizeof(pure_zip_stream_entry)
+    );
+    if (error) return error;
+  }
+
+  // Compare central directory headers with local file headers:
+  pure_zip_cdh cdh;
+  pure_zip_lfh lfh;
+  pure_zip_ddr ddr;
+  uint64_t cdh_offset = eocdr.cd_offset;
+  uint64_t cdh_record = 0;
+  uint64_t compressed_size = 0;
+  uint64_t uncompressed_size = 0;
+  uint8_t ratio = 0;
+  while (cdh_record < eocdr.cd_records) {
+    // Central Directory Header:
+    {
+      int error = pure_zip_decode_cdh(buffer, size, cdh_offset, &cdh);
+      if (error) {
+        index->error = error;
+        return 0;
+      }
+    }
+    if (lfh_offset > cdh.relative_offset) {
+      if (
+        cdh.directory && cdh.relative_offset == 0 &&
+        cdh.crc32 == 0 && cdh.compressed_size == 0 && cdh.uncompressed_size == 0
+      ) {
+        index->error = PURE_E_ZIP_DIRECTORY_HAS_NO_LFH;
+        return 0;
+      }
+      index->error = PURE_E_ZIP_BOMB_FIFIELD;
+      return 0;
+    }
+    if (lfh_offset < cdh.relative_offset) {
+      assert(cdh.relative_offset <= size);
+      if (pure_zeroes(buffer, lfh_offset, cdh.relative_offset)) {
+        index->error = PURE_E_ZIP_LFH_UNDERFLOW_ZEROED;
+      } else {
+        index->error = PURE_E_ZIP_LFH_UNDERFLOW_BUFFER_BLEED;
+      }
+      return 0;
+    }
+    // Local File Header:
+    {
+      assert(cdh.relative_offset == lfh_offset);
+      int error = pure_zip_decode_lfh(buffer, size, cdh.relative_offset, &lfh);
+      if (error) {
+        index->error = error;
+        return 0;
+      }
+    }
+    {
+      int error = pure_zip_diff_cdh_lfh(&cdh, &lfh);
+      if (error) {
+        index->error = error;
+        return 0;
+      }
+    }
+    {
+      int error = pure_zip_verify_symlink(&cdh, &lfh, buffer);
+      if (error) {
+        index->error = error;
+        return 0;
+      }
+    }
+    assert(lfh.length >= PURE_ZIP_LFH_MIN);
+    lfh_offset += lfh.length;
+    // File Data (compressed or uncompressed):
+    if (pure_overflow(lfh_offset, cdh.compressed_size, UINT64_MAX)) {
+      index->error = PURE_E_UINT64_OVERFLOW;
+      return 0;
+    }
+    lfh_offset += cdh.compressed_size;
+    if (lfh_offset > size) {
+      index->error = PURE_E_ZIP_LFH_DATA_OVERFLOW;
+      return 0;
+    }
+    // Data Descriptor Record (optional):
+    if (lfh.general_purpose_bit_flag & (1 << 3)) {
+      {
+        ddr.zip64 = lfh.zip64;
+        int error = pure_zip_decode_ddr(buffer, size, lfh_offset, &ddr);
+        if (error) {
+          index->error = error;
+          return 0;
+        }
+      }
+      {
+        int error = pure_zip_diff_cdh_ddr(&cdh, &ddr);
+        if (error) {
+          index->error = error;
+          return 0;
+        }
+      }
+      {
+        int error = pure_zip_diff_ddr_lfh(&ddr, &lfh);
+        if (error) {
+          index->error = error;
+          return 0;
+        }
+      }
+      lfh_offset += ddr.length;
+    }
+    if (lfh_offset > eocdr.cd_offset) {
+      index->error = PURE_E_ZIP_LF_OVERFLOW;
+      return 0;
+    }
+    // We descend into the data only after checking for LFH overlap above:
+    // We can therefore descend only after decoding at least two entries.
+    if (cdh_record > 0) index->count = cdh_record;
+    // Record the entry, with the ratio of the entries up to and including it:
+    if (!ratio && !cdh.directory && cdh.uncompressed_size > 0) {
+      if (
+        pure_overflow(compressed_size, cdh.compressed_size, UINT64_MAX) ||
+        pure_overflow(uncompressed_size, cdh.uncompressed_size, UINT64_MAX)
+      ) {
+        ratio = 1;
+      } else {
+        compressed_size += cdh.compressed_size;
+        uncompressed_size += cdh.uncompressed_size;
+        ratio = pure_zip_verify_compression_ratio(
+          compressed_size,
+          uncompressed_size
+        ) != 0;
+      }
+    }
+    assert(cdh_record < capacity);
+    pure_zip_stream_entry* entry = &index->entries[cdh_record];
+    entry->cdh = cdh;
+    entry->lfh = lfh;
+    entry->ratio = ratio;
+    entry->verified = 0;
+    entry->nested = 0;
+    entry->error = 0;
+    entry->checksum = 0;
+    assert(cdh.length >= PURE_ZIP_CDH_MIN);
+    cdh_offset += cdh.length;
+    cdh_record++;
+  }
+  // Descend into the previous CDH and LFH:
+  index->count = cdh_record;
+  if (lfh_offset > eocdr.cd_offset) {
+    index->error = PURE_E_ZIP_LF_OVERFLOW;
+    return 0;
+  }
+  if (lfh_offset < eocdr.cd_offset) {
+    assert(eocdr.cd_offset <= size);
+    if (pure_zeroes(buffer, lfh_offset, eocdr.cd_offset)) {
+      index->error = PURE_E_ZIP_LF_UNDERFLOW_ZEROED;
+    } else {
+      index->error = PURE_E_ZIP_LF_UNDERFLOW_BUFFER_BLEED;
+    }
+    return 0;
+  }
+  uint64_t cdh_offset_expected = eocdr.cd_offset + eocdr.cd_size;
+  if (cdh_offset > cdh_offset_expected) {
+    index->error = PURE_E_ZIP_CD_OVERFLOW;
+    return 0;
+  }
+  if (cdh_offset < cdh_offset_expected) {
+    assert(cdh_offset_expected <= size);
+    if (pure_zeroes(buffer, cdh_offset, cdh_offset_expected)) {
+      index->error = PURE_E_ZIP_CD_UNDERFLOW_ZEROED;
+    } else {
+      index->error = PURE_E_ZIP_CD_UNDERFLOW_BUFFER_BLEED;
+    }
+    return 0;
+  }
+  if (cdh_offset < eocdr.offset) {
+    assert(eocdr.offset <= size);
+    if (pure_zeroes(buffer, cdh_offset, eocdr.offset)) {
+      index->error = PURE_E_ZIP_CD_EOCDR_UNDERFLOW_ZEROED;
+    } else {
+      index->error = PURE_E_ZIP_CD_EOCDR_UNDERFLOW_BUFFER_BLEED;
+    }
+    return 0;
+  }
+  assert(cdh_offset == eocdr.offset);
+  assert(cdh_offset + eocdr.length == size);
+  return 0;
+}
+
+// Descends into the indexed entries in order, verifying any entries that were
+// not already verified, and returns the same result as pure_zip_meta().
+int pure_zip_stream_meta(
+  pure_ctx* ctx,
+  const uint8_t* buffer,
+  pure_zip_stream_index* index,
+  uint8_t* chunk,
+  const uint64_t chunk_size,
+  uint8_t** data,
+  uint64_t* data_size
+) {
+  for (uint64_t entry = 0; entry < index->count; entry++) {
+    int error = pure_zip_stream_data(
+      ctx, buffer, &index->entries[entry], chunk, chunk_size, data, data_size
+    );
+    if (error) return error;
+  }
+  if (index->error) return index->error;
+  assert(ctx->depth > 0);
+  ctx->depth--;
+  return PURE_E_OK;
+}
+
+void pure_zip_stream_ctx(pure_ctx* ctx, const uint64_t flags) {
+  ctx->flags = flags;
+  ctx->depth = 0;
+  ctx->files = 0;
+  ctx->archives = 0;
+  ctx->size = 0;
+  ctx->compressed_size = 0;
+  ctx->uncompressed_size = 0;
+}
+
+void pure_zip_stream_index_free(pure_zip_stream_index* index) {
+  pure_free((uint8_t**) &index->entries, &index->entries_size);
+  index->count = 0;
+}
+
+// Equivalent to pure_zip(), using a fixed amount of memory for entries that
+// are not themselves archives.
+int pure_zip_stream(
+  const uint8_t* buffer, // Zip file buffer
+  const uint64_t size,   // Size of zip file buffer in bytes
+  const uint64_t flags   // Bit flags (optional)
+) {
+  pure_ctx ctx;
+  pure_zip_stream_ctx(&ctx, flags);
+  pure_zip_stream_index index;
+  index.entries = NULL;
+  index.entries_size = 0;
+  uint8_t* chunk = NULL;
+  uint64_t chunk_size = 0;
+  uint8_t* data = NULL;
+  uint64_t data_size = 0;
+  int error = pure_zip_stream_index_entries(&ctx, buffer, size, &index);
+  if (!error) error = pure_realloc(&chunk, &chunk_size, PURE_STREAM_CHUNK);
+  if (!error) {
+    error = pure_zip_stream_meta(
+      &ctx, buffer, &index, chunk, chunk_size, &data, &data_size
+    );
+  }
+  pure_free(&data, &data_size);
+  pure_free(&chunk, &chunk_size);
+  pure_zip_stream_index_free(&index);
+  assert(data == NULL);
+  assert(chunk == NULL);
+  return error;
+}
+
+#endif /* PURE_STREAM_H */
@@ -9,6 +9,7 @@
 #include <AppInstallerStrings.h>
 #include <AppInstallerTelemetry.h>
 #include <Microsoft/SQLiteIndex.h>
+#include <Microsoft/SQLiteIndexChangeset.h>
 #include <winget/ManifestYamlParser.h>
 #include <winget/ThreadGlobals.h>
 #include <winget/InstallerMetadataCollectionContext.h>
@@ -35,6 +36,7 @@ namespace
         {
         case WinGetSQLiteIndexProperty_PackageUpdateTrackingBaseTime: return SQLiteIndex::Property::PackageUpdateTrackingBaseTime;
         case WinGetSQLiteIndexProperty_IntermediateFileOutputPath: return SQLiteIndex::Property::IntermediateFileOutputPath;
+        case WinGetSQLiteIndexProperty_PreviousPackagedIndexPath: return SQLiteIndex::Property::PreviousPackagedIndexPath;
         }
 
         THROW_HR(E_INVALIDARG);
@@ -172,6 +174,34 @@ extern "C"
     }
     CATCH_RETURN()
 
+    WINGET_UTIL_API WinGetSQLiteIndexAddManifests(
+        WINGET_SQLITE_INDEX_HANDLE index,
+        const WINGET_STRING* manifestPaths,
+        const WINGET_STRING* relativePaths,
+        UINT32 count,
+        UINT32 maxConcurrency) try
+    {
+        THROW_HR_IF(E_INVALIDARG, !index);
+        THROW_HR_IF(E_INVALIDARG, count && !manifestPaths);
+        THROW_HR_IF(E_INVALIDARG, count && !relativePaths);
+
+        std::vector<SQLiteIndex::ManifestFile> manifests;
+        manifests.reserve(count);
+
+        for (UINT32 i = 0; i < count; ++i)
+        {
+            THROW_HR_IF(E_INVALIDARG, !manifestPaths[i]);
+            THROW_HR_IF(E_INVALIDARG, !relativePaths[i]);
+
+            manifests.emplace_back(SQLiteIndex::ManifestFile{ manifestPaths[i], relativePaths[i] });
+        }
+
+        reinterpret_cast<SQLiteIndex*>(index)->AddManifests(manifests, maxConcurrency);
+
+        return S_OK;
+    }
+    CATCH_RETURN()
+
     WINGET_UTIL_API WinGetSQLiteIndexUpdateManifest(
         WINGET_SQLITE_INDEX_HANDLE index,
         WINGET_STRING manifestPath,
@@ -238,6 +268,21 @@ extern "C"
     }
     CATCH_RETURN()
 
+    WINGET_UTIL_API WinGetSQLiteIndexCreateChangeset(
+        WINGET_STRING baseIndexPath,
+        WINGET_STRING targetIndexPath,
+        WINGET_STRING changesetPath) try
+    {
+        THROW_HR_IF(E_INVALIDARG, !baseIndexPath);
+        THROW_HR_IF(E_INVALIDARG, !targetIndexPath);
+        THROW_HR_IF(E_INVALIDARG, !changesetPath);
+
+        SQLiteIndexChangeset::Create(baseIndexPath, targetIndexPath, changesetPath);
+
+        return S_OK;
+    }
+    CATCH_RETURN()
+
     WINGET_UTIL_API WinGetSQLiteIndexCheckConsistency(
         WINGET_SQLITE_INDEX_HANDLE index,
         BOOL* succeeded) try
@@ -143,6 +143,7 @@ extern "C"
     {
         WinGetSQLiteIndexProperty_PackageUpdateTrackingBaseTime = 0,
         WinGetSQLiteIndexProperty_IntermediateFileOutputPath = 1,
+        WinGetSQLiteIndexProperty_PreviousPackagedIndexPath = 2,
     };
 
     // Sets the given property on the index.
@@ -158,6 +159,17 @@ extern "C"
         WINGET_STRING manifestPath, 
         WINGET_STRING relativePath);
 
+    // Adds the manifests at the repository relative paths to the index.
+    // Manifests are parsed and validated concurrently and then added in order in a single transaction.
+    // A maxConcurrency of 0 uses the number of processors.
+    // If the function succeeds, all of the manifests have been added; if it fails, none have.
+    WINGET_UTIL_API WinGetSQLiteIndexAddManifests(
+        WINGET_SQLITE_INDEX_HANDLE index,
+        const WINGET_STRING* manifestPaths,
+        const WINGET_STRING* relativePaths,
+        UINT32 count,
+        UINT32 maxConcurrency);
+
     // Updates the manifest with matching { Id, Version, Channel } in the index.
     // The return value indicates whether the index was modified by the function.
     WINGET_UTIL_API WinGetSQLiteIndexUpdateManifest(
@@ -185,6 +197,14 @@ extern "C"
     WINGET_UTIL_API WinGetSQLiteIndexPrepareForPackaging(
         WINGET_SQLITE_INDEX_HANDLE index);
 
+    // Creates a changeset that transforms the packaged index at baseIndexPath into the one at targetIndexPath.
+    // Both indices must be the output of WinGetSQLiteIndexPrepareForPackaging with the same schema version.
+    // The changeset is published as Public\changeset.db in a delta package, which clients holding the base apply instead of downloading the target.
+    WINGET_UTIL_API WinGetSQLiteIndexCreateChangeset(
+        WINGET_STRING baseIndexPath,
+        WINGET_STRING targetIndexPath,
+        WINGET_STRING changesetPath);
+
     // Checks the index for consistency, ensuring that at a minimum all referenced rows actually exist.
     WINGET_UTIL_API WinGetSQLiteIndexCheckConsistency(
         WINGET_SQLITE_INDEX_HANDLE index,
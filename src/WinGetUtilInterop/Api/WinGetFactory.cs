@@ -59,6 +59,19 @@ namespace Microsoft.WinGetUtil.Api
             }
         }
 
+        /// <inheritdoc/>
+        public void SQLiteIndexCreateChangeset(string baseIndexFile, string targetIndexFile, string changesetFile)
+        {
+            try
+            {
+                WinGetSQLiteIndexCreateChangeset(baseIndexFile, targetIndexFile, changesetFile);
+            }
+            catch (Exception e)
+            {
+                throw new WinGetSQLiteIndexException(e);
+            }
+        }
+
         /// <inheritdoc/>
         public IWinGetLogging LoggingInit(string indexLogFile)
         {
@@ -217,6 +230,16 @@ namespace Microsoft.WinGetUtil.Api
         [DllImport(Constants.DllName, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode, PreserveSig = false)]
         private static extern IntPtr WinGetSQLiteIndexOpen(string filePath, out IntPtr index);
 
+        /// <summary>
+        /// Creates a changeset that transforms the base packaged index into the target.
+        /// </summary>
+        /// <param name="baseIndexPath">File path of the base index.</param>
+        /// <param name="targetIndexPath">File path of the target index.</param>
+        /// <param name="changesetPath">File path of the changeset to create.</param>
+        /// <returns>HRESULT.</returns>
+        [DllImport(Constants.DllName, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode, PreserveSig = false)]
+        private static extern IntPtr WinGetSQLiteIndexCreateChangeset(string baseIndexPath, string targetIndexPath, string changesetPath);
+
         /// <summary>
         /// Initializes the logging infrastructure.
         /// </summary>
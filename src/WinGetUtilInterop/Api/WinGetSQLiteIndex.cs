@@ -68,6 +68,35 @@ namespace Microsoft.WinGetUtil.Api
             }
         }
 
+        /// <inheritdoc/>
+        public void AddManifests(string[] manifestPaths, string[] relativePaths, uint maxConcurrency = 0)
+        {
+            if (manifestPaths == null)
+            {
+                throw new ArgumentNullException(nameof(manifestPaths));
+            }
+
+            if (relativePaths == null)
+            {
+                throw new ArgumentNullException(nameof(relativePaths));
+            }
+
+            if (manifestPaths.Length != relativePaths.Length)
+            {
+                throw new ArgumentException("The number of manifest paths and relative paths must match.", nameof(relativePaths));
+            }
+
+            try
+            {
+                WinGetSQLiteIndexAddManifests(this.indexHandle, manifestPaths, relativePaths, (uint)manifestPaths.Length, maxConcurrency);
+                return;
+            }
+            catch (Exception e)
+            {
+                throw new WinGetSQLiteIndexException(e);
+            }
+        }
+
         /// <inheritdoc/>
         public bool UpdateManifest(string manifestPath, string relativePath)
         {
@@ -221,6 +250,24 @@ namespace Microsoft.WinGetUtil.Api
         [DllImport(Constants.DllName, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode, PreserveSig = false)]
         private static extern IntPtr WinGetSQLiteIndexAddManifest(IntPtr index, string manifestPath, string relativePath);
 
+        /// <summary>
+        /// Adds the manifests at the repository relative paths to the index.
+        /// If the function succeeds, all of the manifests have been added.
+        /// </summary>
+        /// <param name="index">Handle of the index.</param>
+        /// <param name="manifestPaths">Manifests to add.</param>
+        /// <param name="relativePaths">Paths of the manifests in the container.</param>
+        /// <param name="count">Number of manifests.</param>
+        /// <param name="maxConcurrency">Maximum number of parsing threads; 0 to use the number of processors.</param>
+        /// <returns>HRESULT.</returns>
+        [DllImport(Constants.DllName, CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode, PreserveSig = false)]
+        private static extern IntPtr WinGetSQLiteIndexAddManifests(
+            IntPtr index,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] manifestPaths,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] relativePaths,
+            uint count,
+            uint maxConcurrency);
+
         /// <summary>
         /// Updates the manifest at the repository relative path in the index.
         /// The out value indicates whether the index was modified by the function.
@@ -36,6 +36,14 @@ namespace Microsoft.WinGetUtil.Interfaces
         /// <returns>Instance of IWinGetSQLiteIndex.</returns>
         IWinGetSQLiteIndex SQLiteIndexOpen(string indexFile);
 
+        /// <summary>
+        /// Creates a changeset that transforms one packaged index into another.
+        /// </summary>
+        /// <param name="baseIndexFile">Packaged index that clients currently have.</param>
+        /// <param name="targetIndexFile">Packaged index that clients should end up with.</param>
+        /// <param name="changesetFile">Changeset file to create.</param>
+        void SQLiteIndexCreateChangeset(string baseIndexFile, string targetIndexFile, string changesetFile);
+
         /// <summary>
         /// Initializes logging.
         /// </summary>
@@ -26,6 +26,13 @@ namespace Microsoft.WinGetUtil.Interfaces
         /// The path does not need to exist, and may not be created if no files need to be written.
         /// </summary>
         IntermediateFileOutputPath = 1,
+
+        /// <summary>
+        /// The full path to the packaged index produced by the previous call to PrepareForPackaging.
+        /// When set, only packages updated since that packaging are regenerated.
+        /// If the file cannot be used, the full index is regenerated.
+        /// </summary>
+        PreviousPackagedIndexPath = 2,
     }
 
     /// <summary>
@@ -54,6 +61,15 @@ namespace Microsoft.WinGetUtil.Interfaces
         /// <param name="relativePath">Path of the manifest in the repository.</param>
         void AddManifest(string manifestPath, string relativePath);
 
+        /// <summary>
+        /// Adds manifests to index. Manifests are parsed concurrently and added in order in a single transaction.
+        /// If any manifest fails, none are added.
+        /// </summary>
+        /// <param name="manifestPaths">Manifests to add.</param>
+        /// <param name="relativePaths">Paths of the manifests in the repository; must be the same length as manifestPaths.</param>
+        /// <param name="maxConcurrency">Maximum number of parsing threads; 0 to use the number of processors.</param>
+        void AddManifests(string[] manifestPaths, string[] relativePaths, uint maxConcurrency = 0);
+
         /// <summary>
         /// Updates manifest in the index.
         /// </summary>
@@ -0,0 +1,126 @@
+Param(
+  [Parameter(Mandatory = $true, HelpMessage = "The AppInstallerCLITests executable that contains the benchmarks.")]
+  [String] $TestsPath,
+  [Parameter(HelpMessage = "The Catch2 test spec selecting the benchmarks to run.")]
+  [String] $Filter = "[benchmark]",
+  [Parameter(HelpMessage = "The number of samples that each benchmark collects.")]
+  [Int32] $Samples = 100,
+  [Parameter(HelpMessage = "The directory to write the results to; defaults to a temp directory.")]
+  [String] $ResultsPath = $null,
+  [Parameter(HelpMessage = "A results.json from a previous run to compare against.")]
+  [String] $BaselinePath = $null,
+  [Parameter(HelpMessage = "The increase in mean time, in percent, that is reported as a regression.")]
+  [Double] $RegressionThreshold = 10
+)
+
+if ([String]::IsNullOrEmpty($ResultsPath))
+{
+  $ResultsPath = Join-Path ([System.IO.Path]::GetTempPath()) "WinGetBenchmarks-$(Get-Date -Format 'yyyy-MM-dd-HH-mm-ss')"
+}
+
+New-Item -ItemType Directory -Path $ResultsPath -Force | Out-Null
+$reportFile = Join-Path $ResultsPath "catch2.xml"
+
+Write-Host "--> Running benchmarks '$Filter'"
+
+# The benchmarks are hidden test cases, so they only run when selected by the filter.
+& $TestsPath $Filter --benchmark-samples $Samples --reporter "XML::out=$reportFile"
+$testsExitCode = $LASTEXITCODE
+
+if (-not (Test-Path $reportFile))
+{
+  Write-Error "The tests did not write a report [exit code $testsExitCode]"
+  exit 1
+}
+
+[xml] $report = Get-Content $reportFile -Raw
+
+$results = @()
+
+foreach ($testCase in $report.SelectNodes("//TestCase"))
+{
+  foreach ($benchmark in $testCase.SelectNodes(".//BenchmarkResults"))
+  {
+    # Catch2 reports times in nanoseconds.
+    $results += [PSCustomObject]@{
+      TestCase = $testCase.name
+      Benchmark = $benchmark.name
+      Key = "$($testCase.name)/$($benchmark.name)"
+      Samples = [Int32]$benchmark.samples
+      Iterations = [Int32]$benchmark.iterations
+      MeanNs = [Double]$benchmark.mean.value
+      MeanLowerBoundNs = [Double]$benchmark.mean.lowerBound
+      MeanUpperBoundNs = [Double]$benchmark.mean.upperBound
+      StandardDeviationNs = [Double]$benchmark.standardDeviation.value
+    }
+  }
+}
+
+$commit = $null
+try
+{
+  $commit = (git -C $PSScriptRoot rev-parse HEAD 2>$null)
+}
+catch {}
+
+$output = [PSCustomObject]@{
+  Timestamp = (Get-Date).ToUniversalTime().ToString("o")
+  Machine = $env:COMPUTERNAME
+  Processor = (Get-CimInstance Win32_Processor | Select-Object -First 1).Name
+  Commit = $commit
+  Filter = $Filter
+  Samples = $Samples
+  Results = $results
+}
+
+$resultsFile = Join-Path $ResultsPath "results.json"
+$output | ConvertTo-Json -Depth 4 | Set-Content -Path $resultsFile
+
+$regressions = @()
+
+if (-not [String]::IsNullOrEmpty($BaselinePath))
+{
+  $baseline = @{}
+  foreach ($result in (Get-Content $BaselinePath -Raw | ConvertFrom-Json).Results)
+  {
+    $baseline[$result.Key] = $result
+  }
+
+  foreach ($result in $results)
+  {
+    $result | Add-Member -NotePropertyName ChangePercent -NotePropertyValue $null
+
+    if ($baseline.ContainsKey($result.Key))
+    {
+      $previous = $baseline[$result.Key]
+      $result.ChangePercent = [Math]::Round(100 * ($result.MeanNs - $previous.MeanNs) / $previous.MeanNs, 1)
+
+      # Only report a regression when the confidence intervals do not overlap, to ignore noise.
+      if ($result.ChangePercent -gt $RegressionThreshold -and $result.MeanLowerBoundNs -gt $previous.MeanUpperBoundNs)
+      {
+        $regressions += $result
+      }
+    }
+  }
+
+  $results | Format-Table TestCase, Benchmark, @{ Label = "MeanMs"; Expression = { $_.MeanNs / 1e6 } }, ChangePercent
+}
+else
+{
+  $results | Format-Table TestCase, Benchmark, @{ Label = "MeanMs"; Expression = { $_.MeanNs / 1e6 } }
+}
+
+Write-Host "--> Results written to $resultsFile"
+
+if ($testsExitCode -ne 0)
+{
+  Write-Error "The benchmark tests failed [exit code $testsExitCode]"
+  exit $testsExitCode
+}
+
+if ($regressions.Count -gt 0)
+{
+  Write-Host "--> Regressions beyond $RegressionThreshold%:"
+  $regressions | Format-Table Key, ChangePercent
+  exit 1
+}
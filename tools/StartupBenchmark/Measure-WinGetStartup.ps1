@@ -0,0 +1,109 @@
+Param(
+  [Parameter(HelpMessage = "The winget executable to measure.")]
+  [String] $WinGetPath = "winget.exe",
+  [Parameter(HelpMessage = "The number of times that each command is run.")]
+  [Int32] $Iterations = 20,
+  [Parameter(HelpMessage = "The commands to measure, by name; each value is the argument list.")]
+  [System.Collections.IDictionary] $Commands = $null,
+  [Parameter(HelpMessage = "The directory to write the results and trace files to; defaults to a temp directory.")]
+  [String] $ResultsPath = $null,
+  [Parameter(HelpMessage = "Do not collect the startup phases; for builds that do not support --trace-file.")]
+  [Switch] $NoTrace
+)
+
+if ($null -eq $Commands)
+{
+  $Commands = [ordered]@{
+    "version" = @("--version")
+    "complete-command" = @("complete", "--word", "ins", "--commandline", "winget ins", "--position", "10")
+    "complete-argument" = @("complete", "--word", "--", "--commandline", "winget install --", "--position", "17")
+    "help" = @("--help")
+    "info" = @("--info")
+    "source-list" = @("source", "list")
+  }
+}
+
+if ([String]::IsNullOrEmpty($ResultsPath))
+{
+  $ResultsPath = Join-Path ([System.IO.Path]::GetTempPath()) "WinGetStartup-$(Get-Date -Format 'yyyy-MM-dd-HH-mm-ss')"
+}
+
+New-Item -ItemType Directory -Path $ResultsPath -Force | Out-Null
+$tracesPath = Join-Path $ResultsPath "Traces"
+New-Item -ItemType Directory -Path $tracesPath -Force | Out-Null
+
+function Get-Percentile([double[]] $Values, [double] $Percentile)
+{
+  $sorted = $Values | Sort-Object
+  $index = [Math]::Min($sorted.Count - 1, [Math]::Floor($Percentile * ($sorted.Count - 1) + 0.5))
+  return $sorted[[Int32]$index]
+}
+
+$results = @()
+
+foreach ($name in $Commands.Keys)
+{
+  $arguments = $Commands[$name]
+  $wallTimes = @()
+  $phaseTimes = @{}
+
+  Write-Host "--> Measuring '$name' [$($arguments -join ' ')]"
+
+  for ($i = 0; $i -lt $Iterations; ++$i)
+  {
+    $traceFile = Join-Path $tracesPath "$name-$i.json"
+
+    $runArguments = $arguments
+    if (-not $NoTrace)
+    {
+      $runArguments = $arguments + @("--trace-file", $traceFile)
+    }
+
+    # Each run is a new process; the first is the coldest, as the binaries are not yet in the file cache.
+    $stopwatch = [System.Diagnostics.Stopwatch]::StartNew()
+    & $WinGetPath @runArguments | Out-Null
+    $stopwatch.Stop()
+
+    $wallTimes += $stopwatch.Elapsed.TotalMilliseconds
+
+    if (Test-Path $traceFile)
+    {
+      foreach ($traceEvent in (Get-Content $traceFile -Raw | ConvertFrom-Json).traceEvents)
+      {
+        if ($traceEvent.cat -eq "startup")
+        {
+          if (-not $phaseTimes.ContainsKey($traceEvent.name))
+          {
+            $phaseTimes[$traceEvent.name] = @()
+          }
+
+          $phaseTimes[$traceEvent.name] += $traceEvent.dur / 1000.0
+        }
+      }
+    }
+  }
+
+  $phases = [ordered]@{}
+  foreach ($phase in $phaseTimes.Keys)
+  {
+    $phases[$phase] = Get-Percentile $phaseTimes[$phase] 0.5
+  }
+
+  $results += [PSCustomObject]@{
+    Command = $name
+    Arguments = $arguments -join ' '
+    Iterations = $Iterations
+    FirstMs = $wallTimes[0]
+    MedianMs = Get-Percentile $wallTimes 0.5
+    P90Ms = Get-Percentile $wallTimes 0.9
+    MinMs = ($wallTimes | Measure-Object -Minimum).Minimum
+    PhaseMedianMs = $phases
+  }
+}
+
+$resultsFile = Join-Path $ResultsPath "results.json"
+$results | ConvertTo-Json -Depth 4 | Set-Content -Path $resultsFile
+
+$results | Format-Table Command, FirstMs, MedianMs, P90Ms, MinMs
+
+Write-Host "--> Results written to $resultsFile"